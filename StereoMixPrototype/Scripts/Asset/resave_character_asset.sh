@@ -0,0 +1,104 @@
+#!/usr/bin/env bash
+# 캐릭터 에셋 데이터(DA_CharacterAsset)를 ResavePackages 커맨드릿으로 다시 저장합니다.
+# 입력 에셋 프로퍼티가 TSoftObjectPtr로 바뀌기 전에 저장된 패키지는 입력 에셋을 하드 참조(ObjectProperty)로 임포트하므로,
+# 다시 저장하기 전에는 번들 없이 로드해도 입력 에셋이 함께 로드됩니다. 저장한 뒤 .uasset을 커밋합니다.
+#
+# 다시 저장하기 전과 후에 데디케이티드 서버를 띄워 USMAssetSubsystem이 남기는 [SM.Asset] 값
+# (에셋 로드 시간, 프로세스 시작 후 시간, 사용 중인 물리 메모리, 입력 에셋 로드 여부)을 비교해 출력합니다.
+#
+# 사용법: UE_ROOT=/path/to/UnrealEngine ./resave_character_asset.sh
+#
+# 환경 변수
+#   MEASURE_REPEAT  전후 각각 서버를 띄워 측정하는 횟수입니다. 기본값은 3 입니다. 0이면 측정하지 않습니다.
+
+set -euo pipefail
+
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+PROJECT_DIR="$(cd "$SCRIPT_DIR/../.." && pwd)"
+PROJECT_FILE="$PROJECT_DIR/StereoMixPrototype.uproject"
+ASSET_FILE="$PROJECT_DIR/Content/StereoMixPrototype/Data/Asset/DA_CharacterAsset.uasset"
+OUT_DIR="$PROJECT_DIR/Saved/Asset/Resave_$(date +%Y%m%d_%H%M%S)"
+LOG_FILE="$OUT_DIR/Resave.log"
+MAP="/Game/StereoMixPrototype/Level/L_Main"
+MEASURE_REPEAT="${MEASURE_REPEAT:-3}"
+SERVER_TIMEOUT=120
+mkdir -p "$OUT_DIR"
+
+UE_EDITOR_CMD="${UE_EDITOR_CMD:-${UE_ROOT:?UE_ROOT 또는 UE_EDITOR_CMD를 지정해야 합니다.}/Engine/Binaries/Linux/UnrealEditor-Cmd}"
+
+# 서버가 캐릭터 에셋 데이터를 로드해 [SM.Asset]을 남기면 종료합니다.
+measure()
+{
+	local LABEL="$1"
+	for i in $(seq 1 "$MEASURE_REPEAT"); do
+		local LOG="$OUT_DIR/${LABEL}_$i.log"
+		"$UE_EDITOR_CMD" "$PROJECT_FILE" "$MAP" -server -nullrhi -unattended -nosound -nosplash -log > "$LOG" 2>&1 &
+		local SERVER_PID=$!
+		for _ in $(seq 1 "$SERVER_TIMEOUT"); do
+			if grep -q "\[SM\.Asset\]" "$LOG" 2>/dev/null || ! kill -0 "$SERVER_PID" 2>/dev/null; then
+				break
+			fi
+			sleep 1
+		done
+		kill "$SERVER_PID" 2>/dev/null || true
+		wait "$SERVER_PID" 2>/dev/null || true
+		if ! grep -q "\[SM\.Asset\]" "$LOG"; then
+			echo "측정 실패 ($LABEL $i). 로그: $LOG" >&2
+			exit 1
+		fi
+	done
+}
+
+if [[ "$MEASURE_REPEAT" -gt 0 ]]; then
+	echo "다시 저장하기 전 측정: ${MEASURE_REPEAT}회"
+	measure "Before"
+fi
+
+echo "다시 저장: $ASSET_FILE"
+if ! "$UE_EDITOR_CMD" "$PROJECT_FILE" -run=ResavePackages -PackageFolder=/Game/StereoMixPrototype/Data/Asset \
+	-IgnoreChangelist -unattended -nullrhi -nosplash -log > "$LOG_FILE" 2>&1; then
+	echo "ResavePackages가 실패했습니다. 로그: $LOG_FILE" >&2
+	exit 1
+fi
+
+# 다시 저장된 패키지에는 입력 에셋 프로퍼티의 타입으로 SoftObjectProperty만 남습니다.
+if strings "$ASSET_FILE" | grep -qx "ObjectProperty"; then
+	echo "입력 에셋이 아직 하드 참조로 저장되어 있습니다. 로그: $LOG_FILE" >&2
+	exit 1
+fi
+
+if [[ "$MEASURE_REPEAT" -gt 0 ]]; then
+	echo "다시 저장한 뒤 측정: ${MEASURE_REPEAT}회"
+	measure "After"
+
+	python3 - "$OUT_DIR" <<'PYTHON'
+import glob
+import os
+import re
+import statistics
+import sys
+
+out_dir = sys.argv[1]
+pattern = re.compile(r"\[SM\.Asset\] loadMs=([\d.]+) sinceStartMs=([\d.]+) usedPhysicalMB=([\d.]+) inputAssetsLoaded=(\d)")
+
+rows = {}
+print("| 시점 | 에셋 로드 중앙값(ms) | 시작 후 중앙값(ms) | 물리 메모리 중앙값(MB) | 입력 에셋 로드 |")
+print("| --- | ---: | ---: | ---: | --- |")
+for label in ("Before", "After"):
+	values = []
+	for path in sorted(glob.glob(os.path.join(out_dir, label + "_*.log"))):
+		with open(path, errors="replace") as f:
+			match = pattern.search(f.read())
+		if match:
+			values.append(tuple(float(group) for group in match.groups()))
+	load, since_start, memory = (statistics.median(value[i] for value in values) for i in range(3))
+	input_loaded = "예" if any(value[3] for value in values) else "아니요"
+	rows[label] = (load, since_start, memory)
+	print(f"| {label} | {load:.2f} | {since_start:.1f} | {memory:.1f} | {input_loaded} |")
+
+before, after = rows["Before"], rows["After"]
+print(f"| 차이 | {after[0] - before[0]:+.2f} | {after[1] - before[1]:+.1f} | {after[2] - before[2]:+.1f} | |")
+PYTHON
+fi
+
+echo "완료했습니다. $ASSET_FILE 을 커밋합니다. 로그: $OUT_DIR"
@@ -0,0 +1,40 @@
+#!/usr/bin/env bash
+# 맵의 바닥 높이 필드를 구운 뒤 BuildCookRun으로 빌드, 쿡, 스테이징, 패키징합니다.
+# 구운 .smfh 파일은 DefaultGame.ini의 DirectoriesToAlwaysStageAsNonUFS로 패키지에 포함됩니다. 쿡할 때마다 다시 구우므로
+# 맵의 정적 지오메트리를 바꾸고 굽기를 잊어도 패키지의 높이 필드가 맵과 어긋나거나 빠지지 않습니다.
+#
+# 사용법: UE_ROOT=/path/to/UnrealEngine ./cook.sh [플랫폼] [구성]
+#
+#   플랫폼  기본값은 Linux 입니다.
+#   구성    기본값은 Development 입니다.
+#
+# 환경 변수
+#   FLOOR_HEIGHT_MAPS  높이 필드를 구울 맵 목록(공백 구분)입니다. 기본값은 /Game/StereoMixPrototype/Level/L_Main 입니다.
+#   FLOOR_CELL_SIZE    높이 필드의 칸 크기(cm)입니다. 기본값은 50 입니다.
+#   ARCHIVE_DIR        패키지를 저장할 경로입니다. 기본값은 Saved/Packages/<플랫폼> 입니다.
+#   UAT_ARGS           BuildCookRun에 추가할 인자입니다. 예) UAT_ARGS="-server -noclient"
+
+set -euo pipefail
+
+PLATFORM="${1:-Linux}"
+CONFIG="${2:-Development}"
+
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+PROJECT_DIR="$(cd "$SCRIPT_DIR/../.." && pwd)"
+PROJECT_FILE="$PROJECT_DIR/StereoMixPrototype.uproject"
+UE_ROOT="${UE_ROOT:?UE_ROOT를 지정해야 합니다.}"
+export UE_ROOT
+FLOOR_HEIGHT_MAPS="${FLOOR_HEIGHT_MAPS:-/Game/StereoMixPrototype/Level/L_Main}"
+FLOOR_CELL_SIZE="${FLOOR_CELL_SIZE:-50}"
+ARCHIVE_DIR="${ARCHIVE_DIR:-$PROJECT_DIR/Saved/Packages/$PLATFORM}"
+
+# 굽기는 맵마다 트레이스와의 오차와 비용(SM.Bench.FloorHeight)도 함께 출력합니다.
+for MAP in $FLOOR_HEIGHT_MAPS; do
+	"$SCRIPT_DIR/../FloorHeight/bake_floor_height.sh" "$FLOOR_CELL_SIZE" "$MAP"
+done
+
+echo "쿡: $PLATFORM $CONFIG -> $ARCHIVE_DIR"
+# shellcheck disable=SC2086
+"$UE_ROOT/Engine/Build/BatchFiles/RunUAT.sh" BuildCookRun -project="$PROJECT_FILE" \
+	-platform="$PLATFORM" -clientconfig="$CONFIG" -serverconfig="$CONFIG" \
+	-build -cook -stage -pak -archive -archivedirectory="$ARCHIVE_DIR" -unattended -utf8output ${UAT_ARGS:-}
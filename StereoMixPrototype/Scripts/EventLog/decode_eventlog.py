@@ -0,0 +1,114 @@
+#!/usr/bin/env python3
+# SM.EventLog.Dump로 저장한 바이너리 이벤트 로그를 읽기 쉬운 텍스트로 변환합니다.
+#
+# 사용법: ./decode_eventlog.py <덤프 파일> [--event 이름 ...] [--actor ID ...]
+#
+# 모든 스레드의 레코드를 시간순으로 합쳐 출력합니다. 레코드 형식은 Log/SMEventLog.h의 FSMEventRecord와 같아야 합니다.
+
+import argparse
+import struct
+import sys
+
+MAGIC = b"SMEV"
+SUPPORTED_VERSION = 1
+
+# FSMEventRecord: Cycles, FrameNumber, ActorId, EventId, NetMode, Roles, Arg0, Arg1, PIEInstance
+RECORD = struct.Struct("<QIIHBBifi")
+
+NET_MODES = ["Standalone", "DedicatedServer", "ListenServer", "Client"]
+ROLES = ["None", "SimulatedProxy", "AutonomousProxy", "Authority"]
+
+
+class Reader:
+    def __init__(self, data):
+        self.data = data
+        self.offset = 0
+
+    def read(self, fmt):
+        values = struct.unpack_from(fmt, self.data, self.offset)
+        self.offset += struct.calcsize(fmt)
+        return values if len(values) > 1 else values[0]
+
+    def read_string(self):
+        length = self.read("<H")
+        value = self.data[self.offset:self.offset + length].decode("utf-8")
+        self.offset += length
+        return value
+
+    def read_record(self):
+        record = RECORD.unpack_from(self.data, self.offset)
+        self.offset += RECORD.size
+        return record
+
+
+def lookup(table, index):
+    return table[index] if index < len(table) else str(index)
+
+
+def decode(path):
+    with open(path, "rb") as file:
+        reader = Reader(file.read())
+
+    if reader.data[:4] != MAGIC:
+        sys.exit(f"{path}: 이벤트 로그 파일이 아닙니다.")
+    reader.offset = 4
+
+    version = reader.read("<I")
+    if version != SUPPORTED_VERSION:
+        sys.exit(f"{path}: 지원하지 않는 버전입니다. ({version})")
+
+    seconds_per_cycle = reader.read("<d")
+
+    events = {}
+    for _ in range(reader.read("<I")):
+        event_id = reader.read("<H")
+        name = reader.read_string()
+        description = reader.read_string()
+        events[event_id] = (name, description)
+
+    records = []
+    for _ in range(reader.read("<I")):
+        thread_id, num_records = reader.read("<II")
+        for _ in range(num_records):
+            records.append((thread_id, reader.read_record()))
+
+    records.sort(key=lambda entry: entry[1][0])
+    return seconds_per_cycle, events, records
+
+
+def main():
+    parser = argparse.ArgumentParser(description="SM 이벤트 로그 디코더")
+    parser.add_argument("path")
+    parser.add_argument("--event", nargs="*", default=None, help="출력할 이벤트 이름")
+    parser.add_argument("--actor", nargs="*", type=int, default=None, help="출력할 액터 ID")
+    parser.add_argument("--describe", action="store_true", help="이벤트 설명을 함께 출력합니다.")
+    args = parser.parse_args()
+
+    seconds_per_cycle, events, records = decode(args.path)
+    if not records:
+        print("기록된 이벤트가 없습니다.")
+        return
+
+    start_cycles = records[0][1][0]
+    for thread_id, (cycles, frame, actor_id, event_id, net_mode, roles, arg0, arg1, pie_instance) in records:
+        name, description = events.get(event_id, (f"Unknown{event_id}", ""))
+        if args.event is not None and name not in args.event:
+            continue
+        if args.actor is not None and actor_id not in args.actor:
+            continue
+
+        net_mode_name = lookup(NET_MODES, net_mode)
+        if net_mode_name == "Client":
+            net_mode_name = f"Client{pie_instance}"
+
+        time_ms = (cycles - start_cycles) * seconds_per_cycle * 1000.0
+        line = (f"{time_ms:12.3f}ms [Frame {frame}] [Thread {thread_id}] [{net_mode_name}] "
+                f"[Local: {lookup(ROLES, roles >> 4)} / Remote: {lookup(ROLES, roles & 0xF)}] "
+                f"[Actor {actor_id}] {name} {arg0} {arg1:g}")
+        if args.describe and description:
+            line += f"  # {description}"
+        print(line)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,38 @@
+#!/usr/bin/env bash
+# 맵의 바닥 높이 필드를 굽고, 구운 파일로 트레이스와의 오차와 비용을 측정합니다.
+# 파일은 Content/StereoMixPrototype/Data/FloorHeight/<맵 이름>.smfh 에 저장되므로 맵의 정적 지오메트리를 바꿨다면 다시 구워 함께 커밋합니다.
+# 패키징할 때는 Scripts/Cook/cook.sh가 쿡 전에 이 스크립트로 다시 굽습니다.
+#
+# 사용법: UE_ROOT=/path/to/UnrealEngine ./bake_floor_height.sh [칸 크기(cm)] [맵]
+#
+#   칸 크기  기본값은 50 입니다.
+#   맵       기본값은 /Game/StereoMixPrototype/Level/L_Main 입니다.
+
+set -euo pipefail
+
+CELL_SIZE="${1:-50}"
+MAP="${2:-/Game/StereoMixPrototype/Level/L_Main}"
+
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+PROJECT_DIR="$(cd "$SCRIPT_DIR/../.." && pwd)"
+PROJECT_FILE="$PROJECT_DIR/StereoMixPrototype.uproject"
+OUT_DIR="$PROJECT_DIR/Saved/FloorHeight"
+LOG_FILE="$OUT_DIR/Bake_$(date +%Y%m%d_%H%M%S).log"
+mkdir -p "$OUT_DIR"
+
+UE_EDITOR_CMD="${UE_EDITOR_CMD:-${UE_ROOT:?UE_ROOT 또는 UE_EDITOR_CMD를 지정해야 합니다.}/Engine/Binaries/Linux/UnrealEditor-Cmd}"
+
+echo "높이 필드 굽기: $MAP, ${CELL_SIZE}cm 간격"
+if ! "$UE_EDITOR_CMD" "$PROJECT_FILE" "$MAP" -game -nullrhi -unattended -nosound -nosplash -log \
+	-ExecCmds="SM.Floor.Bake $CELL_SIZE,SM.Bench.FloorHeight 10000,quit" > "$LOG_FILE" 2>&1; then
+	echo "에디터가 비정상 종료되었습니다. 로그: $LOG_FILE" >&2
+	exit 1
+fi
+
+if ! grep -q "\[SM.Floor.Bake\] 저장했습니다" "$LOG_FILE"; then
+	grep "\[SM.Floor.Bake\]" "$LOG_FILE" || true
+	echo "굽지 못했습니다. 로그: $LOG_FILE" >&2
+	exit 1
+fi
+
+grep -E "\[SM.Floor.Bake\]|\[SM.Bench.FloorHeight\]" "$LOG_FILE"
@@ -0,0 +1,81 @@
+#!/usr/bin/env bash
+# 캐릭터 업데이트 빈도 조절(SM.Net.Update)을 끈 경우와 켠 경우를 같은 봇 시나리오로 실행해 비교합니다.
+#
+# 사용법: UE_ROOT=/path/to/UnrealEngine ./compare_netupdate.sh [봇 수] [측정 시간(초)]
+#
+# 결과는 Saved/LoadTest/NetUpdate_<시간>/ 에 저장되고 마지막에 캐릭터당 초당 업데이트 수, 커넥션당 송신 대역폭,
+# 봇 1명의 분당 이동 보정 수와 이전 대비 변화를 표로 출력합니다. 표는 results.md에도 저장됩니다.
+# 두 실행의 활동 비율이 크게 다르면 봇의 움직임이 달랐던 것이므로 업데이트 수를 그대로 비교할 수 없습니다.
+# 나머지 환경 변수는 run_loadtest.sh와 같습니다.
+
+set -euo pipefail
+
+NUM_BOTS="${1:-16}"
+DURATION="${2:-60}"
+
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+PROJECT_DIR="$(cd "$SCRIPT_DIR/../.." && pwd)"
+OUT_DIR="$PROJECT_DIR/Saved/LoadTest/NetUpdate_$(date +%Y%m%d_%H%M%S)"
+mkdir -p "$OUT_DIR"
+
+for ENABLED in 0 1; do
+	RUN_DIR="$OUT_DIR/NetUpdate_$ENABLED" \
+	SERVER_ARGS="${SERVER_ARGS:-} -ini:Engine:[ConsoleVariables]:SM.Net.Update=$ENABLED" \
+		"$SCRIPT_DIR/run_loadtest.sh" "$NUM_BOTS" "$DURATION" "$OUT_DIR/NetUpdate_$ENABLED.json" > /dev/null
+done
+
+python3 - "$OUT_DIR" <<'PYTHON' | tee "$OUT_DIR/results.md"
+import json
+import sys
+
+out_dir = sys.argv[1]
+
+
+def summarize(report):
+    net_update = report.get("netUpdate", {})
+    totals = report.get("totals", {})
+    connections = max(report.get("numConnections", 0), 1)
+    minutes = max(report.get("durationSeconds", 0.0), 1.0) / 60.0
+    return {
+        "updates": net_update.get("updatesPerCharacterPerSecond", 0),
+        "connectionUpdates": net_update.get("connectionUpdatesPerCharacterPerSecond", 0),
+        "forced": net_update.get("forcedUpdates", 0),
+        "outBytes": totals.get("outBytesPerSecondPerConnection", 0),
+        "corrections": totals.get("movementCorrections", 0) / connections / minutes,
+        "gameThread": report.get("gameThreadTimeMs", {}).get("avg", 0),
+        "activity": net_update.get("activityPercent", {}),
+        "connections": report.get("numConnections", 0),
+    }
+
+
+def change(before, after):
+    return f"{(after - before) / before * 100:+.1f}%" if before else "-"
+
+
+rows = {}
+for enabled in (0, 1):
+    with open(f"{out_dir}/NetUpdate_{enabled}.json") as file:
+        rows[enabled] = summarize(json.load(file))
+
+print(f"봇 {rows[1]['connections']}명")
+print()
+print("| SM.Net.Update | 업데이트/캐릭터/초 | 커넥션별 업데이트/캐릭터/초 | 즉시 복제 요청 | 송신/커넥션 (B/s) | 보정/봇/분 | GT avg (ms) |")
+print("|---|---:|---:|---:|---:|---:|---:|")
+for enabled, label in ((0, "꺼짐 (이전)"), (1, "켜짐 (이후)")):
+    row = rows[enabled]
+    print(f"| {label} | {row['updates']:.2f} | {row['connectionUpdates']:.2f} | {row['forced']} | "
+          f"{row['outBytes']:.0f} | {row['corrections']:.2f} | {row['gameThread']:.2f} |")
+before, after = rows[0], rows[1]
+print(f"| 변화 | {change(before['updates'], after['updates'])} | {change(before['connectionUpdates'], after['connectionUpdates'])} | | "
+      f"{change(before['outBytes'], after['outBytes'])} | {change(before['corrections'], after['corrections'])} | "
+      f"{change(before['gameThread'], after['gameThread'])} |")
+
+# 활동은 꺼져 있어도 집계되므로 두 실행의 봇 움직임이 비슷했는지 확인할 수 있습니다.
+activities = list(after["activity"].keys()) or list(before["activity"].keys())
+if activities:
+    print()
+    print("| SM.Net.Update | " + " | ".join(f"{name} (%)" for name in activities) + " |")
+    print("|---|" + "---:|" * len(activities))
+    for enabled, label in ((0, "꺼짐 (이전)"), (1, "켜짐 (이후)")):
+        print(f"| {label} | " + " | ".join(f"{rows[enabled]['activity'].get(name, 0):.1f}" for name in activities) + " |")
+PYTHON
@@ -0,0 +1,80 @@
+#!/usr/bin/env bash
+# 캐릭터 상태를 세 개의 복제 프로퍼티(CurrentState, bEnableCollision, bCanControl)로 복제하던 리비전과
+# 하나의 FSMCharacterReplicatedState로 묶은 리비전을 각각 빌드해 같은 봇 시나리오로 실행하고 비교합니다.
+#
+# 사용법: UE_ROOT=/path/to/UnrealEngine ./compare_packedstate.sh [봇 수] [측정 시간(초)]
+#
+# 두 리비전은 git worktree로 Saved/LoadTest/PackedState_<시간>/ 아래에 체크아웃해 에디터 타깃을 빌드합니다.
+# 기본값은 FSMCharacterReplicatedState를 추가한 커밋과 그 부모 커밋이므로 다른 변경이 섞이지 않습니다.
+# 마지막에 서버 게임 스레드 시간과 커넥션당 송신 대역폭을 표로 출력합니다.
+#
+# 환경 변수
+#   BEFORE_REF  이전 리비전입니다. 기본값은 <묶은 커밋>^ 입니다.
+#   AFTER_REF   이후 리비전입니다. 기본값은 FSMCharacterReplicatedState를 추가한 커밋입니다.
+#   나머지는 run_loadtest.sh와 같습니다. UE_EDITOR_CMD는 엔진 실행 파일이므로 두 리비전에서 함께 사용합니다.
+
+set -euo pipefail
+
+NUM_BOTS="${1:-64}"
+DURATION="${2:-120}"
+
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+PROJECT_DIR="$(cd "$SCRIPT_DIR/../.." && pwd)"
+REPO_DIR="$(git -C "$PROJECT_DIR" rev-parse --show-toplevel)"
+PROJECT_SUBDIR="$(realpath --relative-to="$REPO_DIR" "$PROJECT_DIR")"
+OUT_DIR="$PROJECT_DIR/Saved/LoadTest/PackedState_$(date +%Y%m%d_%H%M%S)"
+mkdir -p "$OUT_DIR"
+
+UE_ROOT="${UE_ROOT:?UE_ROOT를 지정해야 합니다. 두 리비전을 빌드하는 데 사용합니다.}"
+UE_EDITOR_CMD="${UE_EDITOR_CMD:-$UE_ROOT/Engine/Binaries/Linux/UnrealEditor-Cmd}"
+export UE_EDITOR_CMD
+
+PACKED_COMMIT="$(git -C "$REPO_DIR" log --format=%H -S FSMCharacterReplicatedState --reverse -- "$PROJECT_SUBDIR/Source" | head -n 1)"
+AFTER_REF="${AFTER_REF:-$PACKED_COMMIT}"
+BEFORE_REF="${BEFORE_REF:-$PACKED_COMMIT^}"
+
+WORKTREES=()
+cleanup()
+{
+	for WORKTREE in "${WORKTREES[@]}"; do
+		git -C "$REPO_DIR" worktree remove --force "$WORKTREE" 2>/dev/null || true
+	done
+}
+trap cleanup EXIT
+
+for LABEL in Before After; do
+	REF_NAME="${LABEL^^}_REF"
+	REF="${!REF_NAME}"
+	WORKTREE="$OUT_DIR/$LABEL/Repo"
+	git -C "$REPO_DIR" worktree add --detach "$WORKTREE" "$REF" > /dev/null
+	WORKTREES+=("$WORKTREE")
+	git -C "$WORKTREE" rev-parse --short HEAD > "$OUT_DIR/$LABEL.rev"
+
+	echo "$LABEL 빌드: $REF ($(cat "$OUT_DIR/$LABEL.rev"))"
+	"$UE_ROOT/Engine/Build/BatchFiles/Linux/Build.sh" StereoMixPrototypeEditor Linux Development \
+		-Project="$WORKTREE/$PROJECT_SUBDIR/StereoMixPrototype.uproject" -WaitMutex > "$OUT_DIR/$LABEL.build.log" 2>&1
+
+	echo "$LABEL 부하 테스트: 봇 ${NUM_BOTS}개, ${DURATION}초"
+	"$WORKTREE/$PROJECT_SUBDIR/Scripts/LoadTest/run_loadtest.sh" "$NUM_BOTS" "$DURATION" "$OUT_DIR/$LABEL.json" > "$OUT_DIR/$LABEL.out"
+done
+
+python3 - "$OUT_DIR" <<'PYTHON'
+import json
+import sys
+
+out_dir = sys.argv[1]
+
+print("| 리비전 | GT avg (ms) | GT p99 (ms) | 송신/커넥션 (B/s) | 송신 패킷/커넥션/초 |")
+print("|---|---:|---:|---:|---:|")
+for label, name in (("Before", "세 프로퍼티 (이전)"), ("After", "묶은 상태 (이후)")):
+    with open(f"{out_dir}/{label}.rev") as file:
+        revision = file.read().strip()
+    with open(f"{out_dir}/{label}.json") as file:
+        report = json.load(file)
+    connections = report.get("connections", [])
+    duration = max(report.get("durationSeconds", 0.0), 1e-6)
+    out_packets = sum(connection.get("outPackets", 0) for connection in connections) / max(len(connections), 1) / duration
+    game_thread = report.get("gameThreadTimeMs", {})
+    print(f"| {name} {revision} | {game_thread.get('avg', 0):.2f} | {game_thread.get('p99', 0):.2f} | "
+          f"{report.get('totals', {}).get('outBytesPerSecondPerConnection', 0):.0f} | {out_packets:.1f} |")
+PYTHON
@@ -0,0 +1,54 @@
+#!/usr/bin/env bash
+# 리플리케이션 그래프와 기본 넷 드라이버의 서버 CPU와 대역폭을 봇 수별로 비교합니다.
+#
+# 사용법: UE_ROOT=/path/to/UnrealEngine ./compare_repgraph.sh [측정 시간(초)] [봇 수...]
+#
+# 봇 수를 지정하지 않으면 16, 32, 64명으로 측정합니다. 각 실행의 결과는 Saved/LoadTest/RepGraph_<시간>/ 에 저장되고
+# 마지막에 gameThreadTimeMs와 커넥션당 송신 대역폭을 표로 출력합니다. 나머지 환경 변수는 run_loadtest.sh와 같습니다.
+
+set -euo pipefail
+
+DURATION="${1:-60}"
+shift || true
+BOT_COUNTS=("$@")
+if [[ ${#BOT_COUNTS[@]} -eq 0 ]]; then
+	BOT_COUNTS=(16 32 64)
+fi
+
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+PROJECT_DIR="$(cd "$SCRIPT_DIR/../.." && pwd)"
+OUT_DIR="$PROJECT_DIR/Saved/LoadTest/RepGraph_$(date +%Y%m%d_%H%M%S)"
+mkdir -p "$OUT_DIR"
+
+# 빈 클래스 경로를 지정하면 리플리케이션 드라이버가 생성되지 않아 기본 넷 드라이버 경로로 복제합니다.
+DEFAULT_DRIVER_ARGS="-ini:Engine:[/Script/OnlineSubsystemUtils.IpNetDriver]:ReplicationDriverClassName="
+
+for NUM_BOTS in "${BOT_COUNTS[@]}"; do
+	SERVER_ARGS="${SERVER_ARGS:-}" \
+		"$SCRIPT_DIR/run_loadtest.sh" "$NUM_BOTS" "$DURATION" "$OUT_DIR/RepGraph_${NUM_BOTS}.json" > /dev/null
+	SERVER_ARGS="${SERVER_ARGS:-} $DEFAULT_DRIVER_ARGS" \
+		"$SCRIPT_DIR/run_loadtest.sh" "$NUM_BOTS" "$DURATION" "$OUT_DIR/Default_${NUM_BOTS}.json" > /dev/null
+done
+
+python3 - "$OUT_DIR" "${BOT_COUNTS[@]}" <<'PYTHON'
+import json
+import sys
+
+out_dir = sys.argv[1]
+bot_counts = sys.argv[2:]
+
+def load(name):
+    with open(f"{out_dir}/{name}.json") as file:
+        return json.load(file)
+
+print("| 봇 | 드라이버 | GT avg (ms) | GT p99 (ms) | Frame p99 (ms) | 송신/커넥션 (B/s) |")
+print("|---:|---|---:|---:|---:|---:|")
+for bots in bot_counts:
+    for label, name in (("기본", f"Default_{bots}"), ("RepGraph", f"RepGraph_{bots}")):
+        report = load(name)
+        game_thread = report.get("gameThreadTimeMs", {})
+        frame = report.get("frameTimeMs", {})
+        totals = report.get("totals", {})
+        print(f"| {bots} | {label} | {game_thread.get('avg', 0):.2f} | {game_thread.get('p99', 0):.2f} | "
+              f"{frame.get('p99', 0):.2f} | {totals.get('outBytesPerSecondPerConnection', 0):.0f} |")
+PYTHON
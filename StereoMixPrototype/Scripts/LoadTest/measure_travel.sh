@@ -0,0 +1,96 @@
+#!/usr/bin/env bash
+# 메인 메뉴에서 매치에 들어가 캐릭터를 조종할 수 있게 되기까지의 이동 시간을 리슨 서버와 데디케이티드 서버 환경에서 측정합니다.
+#
+# 사용법: UE_ROOT=/path/to/UnrealEngine ./measure_travel.sh [반복 횟수]
+#
+# 리슨: 클라이언트가 L_MainMenu에서 시작해 매치 패키지를 미리 로드한 뒤 -SMTravelTo=listen으로 매치를 엽니다.
+# 데디케이티드: 서버를 L_Main으로 띄우고, 클라이언트가 L_MainMenu에서 미리 로드한 뒤 서버에 접속합니다.
+# 각 실행의 로그는 Saved/LoadTest/Travel_<시간>/ 에 저장되고, 마지막에 USMTravelSubsystem이 남긴 [SM.Travel] 값을 표로 출력합니다.
+# 미리 로드 없이 비교하려면 CLIENT_ARGS=-SMTravelNoPreload 로 실행합니다.
+#
+# 환경 변수는 run_loadtest.sh와 같습니다. (UE_ROOT, UE_EDITOR_CMD, PORT, SERVER_ARGS, CLIENT_ARGS)
+
+set -euo pipefail
+
+REPEAT="${1:-5}"
+
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+PROJECT_DIR="$(cd "$SCRIPT_DIR/../.." && pwd)"
+PROJECT_FILE="$PROJECT_DIR/StereoMixPrototype.uproject"
+OUT_DIR="$PROJECT_DIR/Saved/LoadTest/Travel_$(date +%Y%m%d_%H%M%S)"
+
+UE_EDITOR_CMD="${UE_EDITOR_CMD:-${UE_ROOT:?UE_ROOT 또는 UE_EDITOR_CMD를 지정해야 합니다.}/Engine/Binaries/Linux/UnrealEditor-Cmd}"
+PORT="${PORT:-7777}"
+MENU_MAP="/Game/StereoMixPrototype/Level/L_MainMenu"
+MATCH_MAP="/Game/StereoMixPrototype/Level/L_Main"
+CLIENT_TIMEOUT=120
+
+mkdir -p "$OUT_DIR"
+
+SERVER_PID=""
+cleanup()
+{
+	if [[ -n "$SERVER_PID" ]]; then
+		kill "$SERVER_PID" 2>/dev/null || true
+	fi
+}
+trap cleanup EXIT
+
+run_client()
+{
+	local TARGET="$1"
+	local LOG="$2"
+	# shellcheck disable=SC2086
+	timeout "$CLIENT_TIMEOUT" "$UE_EDITOR_CMD" "$PROJECT_FILE" "$MENU_MAP" -game -nullrhi -unattended -nosound -nosplash -log \
+		-SMTravelTo="$TARGET" -SMTravelExitOnMatch ${CLIENT_ARGS:-} > "$LOG" 2>&1 || true
+}
+
+for i in $(seq 1 "$REPEAT"); do
+	echo "[$i/$REPEAT] 리슨 서버"
+	run_client "listen" "$OUT_DIR/Listen_$i.log"
+
+	echo "[$i/$REPEAT] 데디케이티드 서버"
+	# shellcheck disable=SC2086
+	"$UE_EDITOR_CMD" "$PROJECT_FILE" "$MATCH_MAP" -server -nullrhi -unattended -nosound -nosplash -log \
+		-port="$PORT" ${SERVER_ARGS:-} > "$OUT_DIR/Server_$i.log" 2>&1 &
+	SERVER_PID=$!
+	for _ in $(seq 1 120); do
+		if grep -q "Listening on port\|IpNetDriver listening" "$OUT_DIR/Server_$i.log" 2>/dev/null; then
+			break
+		fi
+		sleep 1
+	done
+	run_client "127.0.0.1:$PORT" "$OUT_DIR/Dedicated_$i.log"
+	kill "$SERVER_PID" 2>/dev/null || true
+	wait "$SERVER_PID" 2>/dev/null || true
+	SERVER_PID=""
+done
+
+python3 - "$OUT_DIR" <<'PYTHON'
+import glob
+import os
+import re
+import statistics
+import sys
+
+out_dir = sys.argv[1]
+pattern = re.compile(r"\[SM\.Travel\] mode=(\w+) travelMs=([\d.]+) mapLoadMs=([\d.]+)")
+
+print("| 환경 | 성공/실행 | 이동 중앙값(ms) | 이동 최대(ms) | 맵 로드 중앙값(ms) |")
+print("| --- | --- | --- | --- | --- |")
+for label, prefix in (("리슨", "Listen"), ("데디케이티드", "Dedicated")):
+	logs = sorted(glob.glob(os.path.join(out_dir, prefix + "_*.log")))
+	travel, map_load = [], []
+	for path in logs:
+		with open(path, errors="replace") as f:
+			match = pattern.search(f.read())
+		if match:
+			travel.append(float(match.group(2)))
+			map_load.append(float(match.group(3)))
+	if not travel:
+		print(f"| {label} | 0/{len(logs)} | - | - | - |")
+		continue
+	print(f"| {label} | {len(travel)}/{len(logs)} | {statistics.median(travel):.1f} | {max(travel):.1f} | {statistics.median(map_load):.1f} |")
+PYTHON
+
+echo "로그: $OUT_DIR"
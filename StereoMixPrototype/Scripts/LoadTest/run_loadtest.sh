@@ -0,0 +1,93 @@
+#!/usr/bin/env bash
+# 헤드리스 데디케이티드 서버 1개와 봇 클라이언트 N개로 부하 테스트를 실행하고 결과를 JSON으로 저장합니다.
+#
+# 사용법: UE_ROOT=/path/to/UnrealEngine ./run_loadtest.sh [봇 수] [측정 시간(초)] [결과 파일]
+#
+# 환경 변수
+#   UE_ROOT            엔진 경로입니다. UE_EDITOR_CMD를 직접 지정하면 필요하지 않습니다.
+#   UE_EDITOR_CMD      실행 파일 경로입니다. 기본값은 $UE_ROOT/Engine/Binaries/Linux/UnrealEditor-Cmd 입니다.
+#   PORT               서버 포트입니다. 기본값은 7777 입니다.
+#   WARMUP             봇 접속을 기다리는 최대 시간(초)입니다. 기본값은 60 입니다.
+#   SERVER_ARGS        서버에 추가로 전달할 인자입니다.
+#   CLIENT_ARGS        봇 클라이언트에 추가로 전달할 인자입니다.
+#   RUN_DIR            서버와 봇의 로그를 저장할 디렉터리입니다. 기본값은 Saved/LoadTest/<시간>_<봇 수>bots 입니다.
+#
+# 캐릭터 상태를 하나의 구조체로 묶은 효과는 compare_packedstate.sh로 두 리비전을 빌드해 비교합니다.
+
+set -euo pipefail
+
+NUM_BOTS="${1:-16}"
+DURATION="${2:-60}"
+
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+PROJECT_DIR="$(cd "$SCRIPT_DIR/../.." && pwd)"
+PROJECT_FILE="$PROJECT_DIR/StereoMixPrototype.uproject"
+RUN_DIR="${RUN_DIR:-$PROJECT_DIR/Saved/LoadTest/$(date +%Y%m%d_%H%M%S)_${NUM_BOTS}bots}"
+REPORT="${3:-$RUN_DIR/Summary.json}"
+
+UE_EDITOR_CMD="${UE_EDITOR_CMD:-${UE_ROOT:?UE_ROOT 또는 UE_EDITOR_CMD를 지정해야 합니다.}/Engine/Binaries/Linux/UnrealEditor-Cmd}"
+PORT="${PORT:-7777}"
+WARMUP="${WARMUP:-60}"
+MAP="/Game/StereoMixPrototype/Level/L_Main"
+
+mkdir -p "$RUN_DIR" "$(dirname "$REPORT")"
+
+BOT_PIDS=()
+cleanup()
+{
+	for PID in "${BOT_PIDS[@]}"; do
+		kill "$PID" 2>/dev/null || true
+	done
+	if [[ -n "${SERVER_PID:-}" ]]; then
+		kill "$SERVER_PID" 2>/dev/null || true
+	fi
+}
+trap cleanup EXIT
+
+echo "서버 시작: $MAP (포트 $PORT, 봇 $NUM_BOTS개, 측정 ${DURATION}초)"
+# shellcheck disable=SC2086
+"$UE_EDITOR_CMD" "$PROJECT_FILE" "$MAP" -server -nullrhi -unattended -nosound -nosplash -log \
+	-port="$PORT" \
+	-SMLoadTest -SMLoadTestDuration="$DURATION" -SMLoadTestWarmup="$WARMUP" \
+	-SMLoadTestExpectedClients="$NUM_BOTS" -SMLoadTestReport="$REPORT" -SMLatency \
+	${SERVER_ARGS:-} > "$RUN_DIR/Server.log" 2>&1 &
+SERVER_PID=$!
+
+# 서버가 포트를 열 때까지 기다립니다.
+for _ in $(seq 1 120); do
+	if grep -q "Listening on port\|IpNetDriver listening" "$RUN_DIR/Server.log" 2>/dev/null; then
+		break
+	fi
+	if ! kill -0 "$SERVER_PID" 2>/dev/null; then
+		echo "서버가 시작 중에 종료되었습니다. $RUN_DIR/Server.log 를 확인하세요." >&2
+		exit 1
+	fi
+	sleep 1
+done
+
+for i in $(seq 1 "$NUM_BOTS"); do
+	# shellcheck disable=SC2086
+	"$UE_EDITOR_CMD" "$PROJECT_FILE" "127.0.0.1:$PORT" -game -nullrhi -unattended -nosound -nosplash -log \
+		-SMBot -SMLatencyReport="$RUN_DIR/Latency_Bot_$i.json" ${CLIENT_ARGS:-} > "$RUN_DIR/Bot_$i.log" 2>&1 &
+	BOT_PIDS+=($!)
+done
+
+wait "$SERVER_PID" || true
+SERVER_PID=""
+
+if [[ ! -f "$REPORT" ]]; then
+	echo "결과 파일이 생성되지 않았습니다. $RUN_DIR/Server.log 를 확인하세요." >&2
+	exit 1
+fi
+
+echo "결과: $REPORT"
+cat "$REPORT"
+echo
+
+# 봇별 입력 지연 시간(ms)입니다. 액션별 ClientQueue, RoundTrip, Total의 p50/p99를 확인합니다.
+for LATENCY_REPORT in "$RUN_DIR"/Latency_Bot_*.json; do
+	[[ -f "$LATENCY_REPORT" ]] || continue
+	echo "지연 시간: $LATENCY_REPORT"
+	cat "$LATENCY_REPORT"
+	echo
+done
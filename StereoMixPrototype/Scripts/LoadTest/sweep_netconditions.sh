@@ -0,0 +1,170 @@
+#!/usr/bin/env bash
+# 같은 봇 시나리오를 지연, 손실, 지터, 중복 조건의 조합마다 실행하고 결과를 표로 정리합니다.
+#
+# 사용법: UE_ROOT=/path/to/UnrealEngine ./sweep_netconditions.sh [봇 수] [측정 시간(초)]
+#
+# 조건은 "지연ms:손실%:지터ms:중복%" 형식이며 서버와 봇 모두에 같은 패킷 시뮬레이션 설정으로 적용됩니다.
+# (DefaultEngine.ini의 [PacketSimulationSettings]를 덮어씁니다. 지터는 PktLagVariance입니다.)
+#
+# 환경 변수
+#   CELLS      공백으로 구분한 조건 목록입니다. 지정하지 않으면 아래 DEFAULT_CELLS를 사용합니다.
+#   LAGS, LOSSES, JITTERS, DUPS
+#              공백으로 구분한 값 목록입니다. 하나라도 지정하면 네 목록의 모든 조합을 조건으로 사용합니다.
+#   LABEL      결과에 함께 기록할 빌드 이름입니다. 기본값은 현재 git 커밋입니다.
+#   COMPARE    이전 빌드의 results.csv 경로입니다. 지정하면 같은 조건끼리의 차이를 함께 출력합니다.
+#   나머지 환경 변수는 run_loadtest.sh와 같습니다.
+#
+# 결과는 Saved/LoadTest/NetSweep_<시간>/ 에 조건별 로그와 함께 results.csv, results.md로 저장됩니다.
+#
+# 예) 점프 위주의 플레이에서 PktLag=50의 위치 보정(ClientAdjustPosition) 횟수를 보려면 봇의 점프 확률을 높입니다.
+#   CELLS="0:0:0:0 50:0:0:0" CLIENT_ARGS=-SMBotJumpChance=1 ./sweep_netconditions.sh 16 60
+#
+# 예) 스냅샷 보간과 엔진 스무딩을 같은 지연, 손실 조건에서 비교하려면 봇에서 SM.Net.SnapshotInterpolation을 끈 결과를 COMPARE로 지정합니다.
+#   CELLS="0:0:0:0 50:0:0:0 100:1:10:0 150:5:20:0" LABEL=smoothing CLIENT_ARGS=-ini:Engine:[ConsoleVariables]:SM.Net.SnapshotInterpolation=0 ./sweep_netconditions.sh 16 60
+#   CELLS="0:0:0:0 50:0:0:0 100:1:10:0 150:5:20:0" LABEL=snapshot COMPARE=../../Saved/LoadTest/NetSweep_<시간>/results.csv ./sweep_netconditions.sh 16 60
+#
+# 예) 두 빌드를 비교하려면 이전 빌드에서 만든 results.csv를 COMPARE로 지정합니다.
+#   ./sweep_netconditions.sh 16 60
+#   COMPARE=../../Saved/LoadTest/NetSweep_20240101_120000/results.csv ./sweep_netconditions.sh 16 60
+
+set -euo pipefail
+
+NUM_BOTS="${1:-16}"
+DURATION="${2:-60}"
+
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+PROJECT_DIR="$(cd "$SCRIPT_DIR/../.." && pwd)"
+OUT_DIR="$PROJECT_DIR/Saved/LoadTest/NetSweep_$(date +%Y%m%d_%H%M%S)"
+mkdir -p "$OUT_DIR"
+
+LABEL="${LABEL:-$(git -C "$PROJECT_DIR" rev-parse --short HEAD 2>/dev/null || echo unknown)}"
+
+DEFAULT_CELLS="0:0:0:0 50:0:0:0 100:0:0:0 200:0:0:0 50:1:0:0 50:5:0:0 50:0:20:0 50:0:50:0 50:0:0:5 150:3:30:1"
+
+if [[ -n "${LAGS:-}${LOSSES:-}${JITTERS:-}${DUPS:-}" ]]; then
+	CELLS=""
+	for LAG in ${LAGS:-50}; do
+		for LOSS in ${LOSSES:-0}; do
+			for JITTER in ${JITTERS:-0}; do
+				for DUP in ${DUPS:-0}; do
+					CELLS="$CELLS $LAG:$LOSS:$JITTER:$DUP"
+				done
+			done
+		done
+	done
+fi
+CELLS="${CELLS:-$DEFAULT_CELLS}"
+
+for CELL in $CELLS; do
+	IFS=":" read -r LAG LOSS JITTER DUP <<< "$CELL"
+	CELL_NAME="lag${LAG}_loss${LOSS}_jitter${JITTER}_dup${DUP}"
+	CELL_DIR="$OUT_DIR/$CELL_NAME"
+	mkdir -p "$CELL_DIR"
+
+	PACKET_ARGS="-ini:Engine:[PacketSimulationSettings]:PktLag=$LAG,[PacketSimulationSettings]:PktLoss=$LOSS,[PacketSimulationSettings]:PktLagVariance=$JITTER,[PacketSimulationSettings]:PktDup=$DUP"
+
+	echo "조건 실행: 지연 ${LAG}ms, 손실 ${LOSS}%, 지터 ${JITTER}ms, 중복 ${DUP}%"
+	RUN_DIR="$CELL_DIR" \
+	SERVER_ARGS="${SERVER_ARGS:-} $PACKET_ARGS" \
+	CLIENT_ARGS="${CLIENT_ARGS:-} $PACKET_ARGS,[ConsoleVariables]:SM.Pull.LogEndError=1" \
+		"$SCRIPT_DIR/run_loadtest.sh" "$NUM_BOTS" "$DURATION" "$CELL_DIR/Summary.json" > "$CELL_DIR/Run.out" 2>&1 \
+		|| echo "  실패했습니다. $CELL_DIR/Run.out 을 확인하세요." >&2
+done
+
+python3 - "$OUT_DIR" "$LABEL" "${COMPARE:-}" $CELLS <<'PYTHON'
+import csv
+import glob
+import json
+import math
+import os
+import re
+import sys
+
+out_dir, label, compare_path = sys.argv[1], sys.argv[2], sys.argv[3]
+cells = sys.argv[4:]
+
+COLUMNS = [
+    "build", "lagMs", "lossPercent", "jitterMs", "dupPercent",
+    "corrections", "correctionsPerBotMinute", "catchSuccessRate", "pullEndErrorAvgCm", "pullEndErrorP99Cm",
+    "outBytesPerSecondPerConnection", "inBytesPerSecondPerConnection",
+]
+METRICS = COLUMNS[5:]
+END_ERROR_PATTERN = re.compile(r"\[SM\.Pull\] endErrorCm=([0-9.]+)")
+
+def percentile(values, ratio):
+    if not values:
+        return None
+    values = sorted(values)
+    return values[max(math.ceil(ratio * len(values)) - 1, 0)]
+
+def collect(cell):
+    lag, loss, jitter, dup = cell.split(":")
+    cell_dir = os.path.join(out_dir, f"lag{lag}_loss{loss}_jitter{jitter}_dup{dup}")
+    row = {"build": label, "lagMs": lag, "lossPercent": loss, "jitterMs": jitter, "dupPercent": dup}
+
+    summary_path = os.path.join(cell_dir, "Summary.json")
+    if os.path.exists(summary_path):
+        with open(summary_path) as file:
+            report = json.load(file)
+        totals = report.get("totals", {})
+        connections = max(report.get("numConnections", 0), 1)
+        minutes = max(report.get("durationSeconds", 0.0), 1.0) / 60.0
+        catch_rpcs = totals.get("catchRPCs", 0)
+        row["corrections"] = totals.get("movementCorrections", 0)
+        row["correctionsPerBotMinute"] = totals.get("movementCorrections", 0) / connections / minutes
+        row["catchSuccessRate"] = totals.get("catchAccepted", 0) / catch_rpcs if catch_rpcs else None
+        row["outBytesPerSecondPerConnection"] = totals.get("outBytesPerSecondPerConnection")
+        row["inBytesPerSecondPerConnection"] = totals.get("inBytesPerSecond", 0.0) / connections
+
+    # 당기기 끝 위치 오차는 봇 화면 기준이므로 봇 로그에서 모읍니다.
+    end_errors = []
+    for log_path in glob.glob(os.path.join(cell_dir, "Bot_*.log")):
+        with open(log_path, errors="replace") as file:
+            end_errors.extend(float(match.group(1)) for match in END_ERROR_PATTERN.finditer(file.read()))
+    if end_errors:
+        row["pullEndErrorAvgCm"] = sum(end_errors) / len(end_errors)
+        row["pullEndErrorP99Cm"] = percentile(end_errors, 0.99)
+    return row
+
+def cell_key(row):
+    return tuple(str(row[name]) for name in ("lagMs", "lossPercent", "jitterMs", "dupPercent"))
+
+def format_value(value):
+    if value is None or value == "":
+        return "-"
+    return f"{float(value):.3f}" if abs(float(value)) < 10 else f"{float(value):.0f}"
+
+rows = [collect(cell) for cell in cells]
+
+with open(os.path.join(out_dir, "results.csv"), "w", newline="") as file:
+    writer = csv.DictWriter(file, fieldnames=COLUMNS)
+    writer.writeheader()
+    for row in rows:
+        writer.writerow({name: row.get(name, "") if row.get(name) is not None else "" for name in COLUMNS})
+
+previous = {}
+if compare_path:
+    with open(compare_path) as file:
+        for row in csv.DictReader(file):
+            previous[cell_key(row)] = row
+
+headers = ["지연", "손실%", "지터", "중복%", "보정", "보정/봇/분", "잡기 성공률", "끝 오차 avg (cm)", "끝 오차 p99 (cm)", "송신/커넥션 (B/s)", "수신/커넥션 (B/s)"]
+lines = [f"빌드: {label}" + (f" (비교: {compare_path})" if compare_path else ""), ""]
+lines.append("| " + " | ".join(headers) + " |")
+lines.append("|" + "---:|" * len(headers))
+for row in rows:
+    values = [row["lagMs"], row["lossPercent"], row["jitterMs"], row["dupPercent"]]
+    base = previous.get(cell_key(row))
+    for metric in METRICS:
+        text = format_value(row.get(metric))
+        if base is not None and row.get(metric) is not None and base.get(metric):
+            text += f" ({float(row[metric]) - float(base[metric]):+.3g})"
+        values.append(text)
+    lines.append("| " + " | ".join(str(value) for value in values) + " |")
+
+table = "\n".join(lines)
+with open(os.path.join(out_dir, "results.md"), "w") as file:
+    file.write(table + "\n")
+print(table)
+print(f"\n결과: {out_dir}/results.csv")
+PYTHON
@@ -0,0 +1,115 @@
+#!/usr/bin/env python3
+"""벤치마크 로그와 부하 테스트 결과에서 측정값을 모아 baselines.json의 기준값과 비교합니다.
+
+모든 측정값은 낮을수록 좋습니다. 측정값이 baseline * (1 + tolerance) + absoluteTolerance 를 넘으면 회귀로 판단하고 1을 반환합니다.
+기준값이 없는(null) 항목도 게이트가 아무것도 검사하지 않은 채 통과하지 않도록 실패로 처리합니다.
+--update 를 주면 이번 측정값을 기준값으로 저장합니다. 기준 장비에서 실행한 뒤 baselines.json을 커밋합니다.
+
+사용법: check_perf_gate.py --baselines baselines.json [--log Bench.log] [--loadtest Summary.json] [--update]
+"""
+
+import argparse
+import json
+import re
+import sys
+
+METRIC_PATTERN = re.compile(r"\[SM\.Perf\] ([\w.]+)=(-?[\d.]+)")
+
+
+def collect_log_metrics(path):
+	metrics = {}
+	with open(path, errors="replace") as f:
+		for line in f:
+			match = METRIC_PATTERN.search(line)
+			if match:
+				metrics[match.group(1)] = float(match.group(2))
+	return metrics
+
+
+LOADTEST_METRICS = (
+	"net.yawRPCsPerSecondPerConnection",
+	"net.outBytesPerSecondPerConnection",
+	"server.gameThreadTimeMs.p99",
+)
+
+
+def collect_loadtest_metrics(path):
+	with open(path) as f:
+		report = json.load(f)
+
+	# RPC 수는 바이트 수와 같이 측정 구간의 값이므로 측정 시간으로 나눕니다. (USMLoadTestSubsystem::CaptureConnectionBaselines)
+	duration = max(report.get("durationSeconds", 0.0), 1e-6)
+	connections = report.get("connections", [])
+	yaw_rpcs = sum(connection.get("yawRPCs", 0) for connection in connections)
+	totals = report.get("totals", {})
+	return {
+		"net.yawRPCsPerSecondPerConnection": yaw_rpcs / duration / max(len(connections), 1),
+		"net.outBytesPerSecondPerConnection": totals.get("outBytesPerSecondPerConnection", 0.0),
+		"server.gameThreadTimeMs.p99": report.get("gameThreadTimeMs", {}).get("p99", 0.0),
+	}
+
+
+def main():
+	parser = argparse.ArgumentParser()
+	parser.add_argument("--baselines", required=True)
+	parser.add_argument("--log")
+	parser.add_argument("--loadtest")
+	parser.add_argument("--update", action="store_true")
+	args = parser.parse_args()
+
+	measured = {}
+	if args.log:
+		measured.update(collect_log_metrics(args.log))
+	if args.loadtest:
+		measured.update(collect_loadtest_metrics(args.loadtest))
+
+	with open(args.baselines) as f:
+		baselines = json.load(f)
+
+	failed = []
+	missing_baselines = []
+	print("| 항목 | 기준값 | 측정값 | 한계 | 결과 |")
+	print("| --- | --- | --- | --- | --- |")
+	for name, entry in baselines["metrics"].items():
+		value = measured.get(name)
+		baseline = entry.get("baseline")
+		if value is None:
+			# 실행하지 않은 측정(예: NET_BOTS=0)의 항목은 실패로 보지 않습니다.
+			from_loadtest = name in LOADTEST_METRICS
+			expected = bool(args.loadtest) if from_loadtest else bool(args.log)
+			print(f"| {name} | {'-' if baseline is None else baseline} | - | - | {'측정 안 됨' if expected else '건너뜀'} |")
+			if expected:
+				failed.append(name)
+			continue
+
+		if args.update:
+			entry["baseline"] = round(value, 4)
+
+		if baseline is None:
+			print(f"| {name} | - | {value:.4f} | - | 기준값 없음 |")
+			missing_baselines.append(name)
+			continue
+
+		limit = baseline * (1.0 + entry.get("tolerance", 0.0)) + entry.get("absoluteTolerance", 0.0)
+		result = "통과" if value <= limit else "회귀"
+		if value > limit:
+			failed.append(name)
+		print(f"| {name} | {baseline:.4f} | {value:.4f} | {limit:.4f} | {result} |")
+
+	if args.update:
+		with open(args.baselines, "w") as f:
+			json.dump(baselines, f, indent="\t")
+			f.write("\n")
+		print(f"기준값을 {args.baselines} 에 저장했습니다.")
+		return 0
+
+	if missing_baselines:
+		print(f"기준값 없음: {', '.join(missing_baselines)}", file=sys.stderr)
+		print("기준 장비에서 --update 로 실행해 baselines.json에 기준값을 저장해야 합니다.", file=sys.stderr)
+	if failed:
+		print(f"실패: {', '.join(failed)}", file=sys.stderr)
+	return 1 if failed or missing_baselines else 0
+
+
+if __name__ == "__main__":
+	sys.exit(main())
@@ -0,0 +1,75 @@
+#!/usr/bin/env bash
+# 헤드리스(-nullrhi -unattended)로 성능 벤치마크와 짧은 부하 테스트를 실행하고 baselines.json의 기준값과 비교합니다.
+# 회귀가 있거나 에디터가 비정상 종료되거나 벤치마크 자동화 테스트가 실패하면 0이 아닌 값으로 종료하므로 CI에서 그대로 게이트로 사용할 수 있습니다.
+#
+# 사용법: UE_ROOT=/path/to/UnrealEngine ./run_perf_gate.sh [--update]
+#
+#   --update  이번 측정값을 기준값으로 저장합니다. 기준 장비에서 실행한 뒤 baselines.json을 커밋합니다.
+#             기준값이 없는(null) 항목이 있으면 게이트는 실패하므로 처음 한 번은 --update로 기준값을 만들어야 합니다.
+#
+# 측정 항목
+#   catch.*    SM.Bench.Catch            밀도별 잡기 스윕 비용 (격자 후보 선별 포함)
+#   grid.*     SM.Bench.SpatialGrid      16~256명에서 격자 재구성, 격자 캡슐 쿼리, 물리 스윕 비용
+#   pull.*     SM.Bench.Pull, SM.Bench.PullConvergence  당기기 처리 비용, 프레임레이트별 수렴 시간과 종료 오차
+#   respawn.*  SM.Bench.Respawn          리스폰 웨이브의 새로 스폰/풀 재사용 비용
+#   floor.*    SM.Bench.FloorHeight      바닥 트레이스와 높이 필드 조회 비용, 트레이스로 대신한 비율, 허용 오차 초과 비율
+#   net.*, server.*  run_loadtest.sh     에임 회전으로 인한 커넥션당 초당 Yaw RPC 수, 대역폭, 서버 게임 스레드 시간
+#
+# 환경 변수
+#   NET_BOTS      부하 테스트 봇 수입니다. 기본값은 8 입니다. 0이면 부하 테스트를 건너뜁니다.
+#   NET_DURATION  부하 테스트 측정 시간(초)입니다. 기본값은 30 입니다.
+#   나머지는 run_loadtest.sh와 같습니다.
+
+set -euo pipefail
+
+UPDATE_ARG=""
+if [[ "${1:-}" == "--update" ]]; then
+	UPDATE_ARG="--update"
+fi
+
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+PROJECT_DIR="$(cd "$SCRIPT_DIR/../.." && pwd)"
+PROJECT_FILE="$PROJECT_DIR/StereoMixPrototype.uproject"
+OUT_DIR="$PROJECT_DIR/Saved/PerfGate/$(date +%Y%m%d_%H%M%S)"
+mkdir -p "$OUT_DIR"
+
+UE_EDITOR_CMD="${UE_EDITOR_CMD:-${UE_ROOT:?UE_ROOT 또는 UE_EDITOR_CMD를 지정해야 합니다.}/Engine/Binaries/Linux/UnrealEditor-Cmd}"
+export UE_EDITOR_CMD
+NET_BOTS="${NET_BOTS:-8}"
+NET_DURATION="${NET_DURATION:-30}"
+MAP="/Game/StereoMixPrototype/Level/L_Main"
+
+# 벤치마크 명령은 StereoMix.Perf.Bench 자동화 테스트(Source/StereoMixPrototype/Tests/SMBenchTest.cpp)가 실행합니다.
+echo "벤치마크 실행: StereoMix.Perf.Bench"
+if ! "$UE_EDITOR_CMD" "$PROJECT_FILE" "$MAP" -game -nullrhi -unattended -nosound -nosplash -log \
+	-ExecCmds="Automation RunTests StereoMix.Perf.Bench" -TestExit="Automation Test Queue Empty" \
+	-ReportExportPath="$OUT_DIR/Automation" > "$OUT_DIR/Bench.log" 2>&1; then
+	echo "벤치마크 실행이 비정상 종료되었습니다. 로그: $OUT_DIR/Bench.log" >&2
+	exit 1
+fi
+
+# 명령이 실패하거나 측정값을 출력하지 않은 테스트가 있으면 기준값과 비교하지 않고 실패합니다.
+if ! python3 - "$OUT_DIR/Automation/index.json" <<'PYTHON'
+import json
+import sys
+
+with open(sys.argv[1], encoding="utf-8-sig") as f:
+	report = json.load(f)
+for test in report.get("tests", []):
+	if test.get("state") != "Success":
+		print(f"{test.get('fullTestPath')}: {test.get('state')}", file=sys.stderr)
+sys.exit(1 if report.get("failed", 0) > 0 or report.get("succeeded", 0) + report.get("succeededWithWarnings", 0) == 0 else 0)
+PYTHON
+then
+	echo "벤치마크 자동화 테스트가 실패했습니다. 보고서: $OUT_DIR/Automation" >&2
+	exit 1
+fi
+
+CHECK_ARGS=(--baselines "$SCRIPT_DIR/baselines.json" --log "$OUT_DIR/Bench.log")
+if [[ "$NET_BOTS" -gt 0 ]]; then
+	echo "부하 테스트 실행: 봇 ${NET_BOTS}개, ${NET_DURATION}초"
+	"$SCRIPT_DIR/../LoadTest/run_loadtest.sh" "$NET_BOTS" "$NET_DURATION" "$OUT_DIR/LoadTest.json" > "$OUT_DIR/LoadTest.out" 2>&1
+	CHECK_ARGS+=(--loadtest "$OUT_DIR/LoadTest.json")
+fi
+
+python3 "$SCRIPT_DIR/check_perf_gate.py" "${CHECK_ARGS[@]}" $UPDATE_ARG | tee "$OUT_DIR/Result.md"
@@ -3,3 +3,11 @@
 
 #include "Character/SMCharacterAssetData.h"
 
+const FPrimaryAssetType USMCharacterAssetData::PrimaryAssetType = TEXT("SMCharacterAssetData");
+
+const FName USMCharacterAssetData::ClientBundle = TEXT("Client");
+
+FPrimaryAssetId USMCharacterAssetData::GetPrimaryAssetId() const
+{
+	return FPrimaryAssetId(PrimaryAssetType, GetFName());
+}
@@ -9,7 +9,8 @@
 class UInputAction;
 class UInputMappingContext;
 /**
- * 
+ * 캐릭터가 사용하는 에셋입니다. 에셋 매니저의 프라이머리 에셋으로 등록되어 비동기로 로드됩니다.
+ * 입력 에셋은 Client 번들에 속하기 때문에 데디케이티드 서버에서는 로드되지 않습니다.
  */
 UCLASS()
 class STEREOMIXPROTOTYPE_API USMCharacterAssetData : public UPrimaryDataAsset
@@ -17,15 +18,23 @@ class STEREOMIXPROTOTYPE_API USMCharacterAssetData : public UPrimaryDataAsset
 	GENERATED_BODY()
 
 public:
-	UPROPERTY(EditDefaultsOnly, Category = "Input")
-	TObjectPtr<const UInputMappingContext> DefaultMappingContext;
+	virtual FPrimaryAssetId GetPrimaryAssetId() const override;
 
-	UPROPERTY(EditDefaultsOnly, Category = "Input")
-	TObjectPtr<const UInputAction> MoveAction;
+	static const FPrimaryAssetType PrimaryAssetType;
 
-	UPROPERTY(EditDefaultsOnly, Category = "Input")
-	TObjectPtr<const UInputAction> JumpAction;
+	/** 입력 에셋이 속한 번들 이름입니다. */
+	static const FName ClientBundle;
 
-	UPROPERTY(EditDefaultsOnly, Category = "Input")
-	TObjectPtr<const UInputAction> HoldAction; 
+public:
+	UPROPERTY(EditDefaultsOnly, Category = "Input", meta = (AssetBundles = "Client"))
+	TSoftObjectPtr<UInputMappingContext> DefaultMappingContext;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Input", meta = (AssetBundles = "Client"))
+	TSoftObjectPtr<UInputAction> MoveAction;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Input", meta = (AssetBundles = "Client"))
+	TSoftObjectPtr<UInputAction> JumpAction;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Input", meta = (AssetBundles = "Client"))
+	TSoftObjectPtr<UInputAction> HoldAction;
 };
@@ -3,28 +3,27 @@
 
 #include "Character/SMCharacterBase.h"
 
-#include "EnhancedInputComponent.h"
-#include "EnhancedInputSubsystems.h"
-#include "SMCharacterAssetData.h"
-#include "Data/AssetPath.h"
+#include "Subsystem/SMAssetSubsystem.h"
 
 // Sets default values
-ASMCharacterBase::ASMCharacterBase()
+ASMCharacterBase::ASMCharacterBase(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
 {
-	PrimaryActorTick.bCanEverTick = true;
-
-	static ConstructorHelpers::FObjectFinder<USMCharacterAssetData> SMCharacterAssetDataRef(CHARACTER_ASSET_PATH);
-	if (SMCharacterAssetDataRef.Succeeded())
-	{
-		AssetData = SMCharacterAssetDataRef.Object;
-	}
+	// 틱이 필요한 파생 클래스에서만 켭니다.
+	PrimaryActorTick.bCanEverTick = false;
 }
 
 void ASMCharacterBase::PostInitializeComponents()
 {
 	Super::PostInitializeComponents();
 
-	CheckAssetLoaded();
+	SpawnTime = FPlatformTime::Seconds();
+
+	USMAssetSubsystem* AssetSubsystem = UGameInstance::GetSubsystem<USMAssetSubsystem>(GetGameInstance());
+	if (AssetSubsystem)
+	{
+		AssetSubsystem->CallOrRegister_OnCharacterAssetDataLoaded(FSMOnCharacterAssetDataLoaded::FDelegate::CreateUObject(this, &ASMCharacterBase::HandleAssetDataLoaded));
+	}
 }
 
 // Called when the game starts or when spawned
@@ -33,14 +32,15 @@ void ASMCharacterBase::BeginPlay()
 	Super::BeginPlay();
 }
 
-// Called every frame
-void ASMCharacterBase::Tick(float DeltaTime)
+void ASMCharacterBase::HandleAssetDataLoaded(USMCharacterAssetData* InAssetData)
 {
-	Super::Tick(DeltaTime);
+	AssetData = InAssetData;
 
-}
+	USMAssetSubsystem* AssetSubsystem = UGameInstance::GetSubsystem<USMAssetSubsystem>(GetGameInstance());
+	if (AssetSubsystem)
+	{
+		AssetSubsystem->ReportFirstSpawnLatency(SpawnTime);
+	}
 
-void ASMCharacterBase::CheckAssetLoaded()
-{
-	check(AssetData);
+	OnAssetDataLoaded();
 }
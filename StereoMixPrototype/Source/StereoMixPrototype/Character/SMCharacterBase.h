@@ -14,7 +14,7 @@ class STEREOMIXPROTOTYPE_API ASMCharacterBase : public ACharacter
 	GENERATED_BODY()
 
 public:
-	ASMCharacterBase();
+	ASMCharacterBase(const FObjectInitializer& ObjectInitializer);
 
 public:
 	virtual void PostInitializeComponents() override;
@@ -22,12 +22,18 @@ public:
 protected:
 	virtual void BeginPlay() override;
 
-public:
-	virtual void Tick(float DeltaTime) override;
+public: // Data Section
+	const USMCharacterAssetData* GetAssetData() const { return AssetData; }
+
+protected:
+	/** 에셋 서브시스템에서 캐릭터 에셋 데이터가 준비되면 호출됩니다. 이미 로드된 경우 PostInitializeComponents 중에 호출됩니다. */
+	virtual void OnAssetDataLoaded() {}
 
-protected: // Data Section
-	virtual void CheckAssetLoaded();
+	void HandleAssetDataLoaded(USMCharacterAssetData* InAssetData);
 
+	/** 에셋 데이터는 비동기로 로드되기 때문에 준비되기 전까지 nullptr일 수 있습니다. */
 	UPROPERTY()
 	TObjectPtr<USMCharacterAssetData> AssetData;
+
+	double SpawnTime = 0.0;
 };
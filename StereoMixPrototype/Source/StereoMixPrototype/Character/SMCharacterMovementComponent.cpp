@@ -0,0 +1,398 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Character/SMCharacterMovementComponent.h"
+
+#include "Character/SMPlayerCharacter.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "GameFramework/Character.h"
+#include "Subsystem/SMPullSubsystem.h"
+
+static bool GSMSnapshotInterpolationEnabled = true;
+
+static FAutoConsoleVariableRef CVarSMSnapshotInterpolationEnabled(
+	TEXT("SM.Net.SnapshotInterpolation"),
+	GSMSnapshotInterpolationEnabled,
+	TEXT("시뮬레이티드 프록시의 위치를 수신한 스냅샷 사이에서 고정된 지연으로 보간합니다. 끄면 엔진의 네트워크 스무딩을 사용합니다."));
+
+static float GSMSnapshotInterpolationDelay = 0.1f;
+
+static FAutoConsoleVariableRef CVarSMSnapshotInterpolationDelay(
+	TEXT("SM.Net.InterpolationDelay"),
+	GSMSnapshotInterpolationDelay,
+	TEXT("스냅샷 보간의 최소 지연(초)입니다. 프록시마다 관측한 스냅샷 간격과 지터가 이보다 크면 지연을 그만큼 늘립니다."));
+
+static float GSMSnapshotMaxInterpolationDelay = 0.35f;
+
+static FAutoConsoleVariableRef CVarSMSnapshotMaxInterpolationDelay(
+	TEXT("SM.Net.MaxInterpolationDelay"),
+	GSMSnapshotMaxInterpolationDelay,
+	TEXT("스냅샷 보간의 최대 지연(초)입니다. 이보다 긴 스냅샷 간격은 복제 주기가 아니라 변경이 없어 보내지 않은 것으로 보고 간격 통계에서 제외합니다."));
+
+static float GSMSnapshotMaxExtrapolationTime = 0.1f;
+
+static FAutoConsoleVariableRef CVarSMSnapshotMaxExtrapolationTime(
+	TEXT("SM.Net.MaxExtrapolationTime"),
+	GSMSnapshotMaxExtrapolationTime,
+	TEXT("스냅샷이 늦게 도착할 때 마지막 속도로 외삽하는 최대 시간(초)입니다. 이후에는 마지막 위치에 멈춥니다."));
+
+float USMCharacterMovementComponent::GetMaxSpeed() const
+{
+	// 입력 벡터에 배율을 곱했을 때 아날로그 입력 배율로 CalcVelocity의 최대 속도가 줄어드는 것과 같은 결과입니다.
+	const float MaxSpeed = Super::GetMaxSpeed();
+	return IsFalling() ? MaxSpeed * FallingInputScale : MaxSpeed;
+}
+
+FVector USMCharacterMovementComponent::GetFallingLateralAcceleration(float DeltaTime)
+{
+	return Super::GetFallingLateralAcceleration(DeltaTime) * FallingInputScale;
+}
+
+void USMCharacterMovementComponent::ServerMoveHandleClientError(float ClientTimeStamp, float DeltaTime, const FVector& Accel, const FVector& RelativeClientLocation, UPrimitiveComponent* ClientMovementBase, FName ClientBaseBoneName, uint8 ClientMovementMode)
+{
+	Super::ServerMoveHandleClientError(ClientTimeStamp, DeltaTime, Accel, RelativeClientLocation, ClientMovementBase, ClientBaseBoneName, ClientMovementMode);
+
+	// 오차가 허용 범위를 넘으면 PendingAdjustment에 이번 무브에 대한 보정이 채워집니다.
+	const FNetworkPredictionData_Server_Character* ServerData = GetPredictionData_Server_Character();
+	if (ServerData && !ServerData->PendingAdjustment.bAckGoodMove && ServerData->PendingAdjustment.TimeStamp == ClientTimeStamp)
+	{
+		++NumServerCorrections;
+	}
+}
+
+void USMCharacterMovementComponent::ServerMovePacked_ClientSend(const FCharacterServerMovePackedBits& PackedBits)
+{
+	Super::ServerMovePacked_ClientSend(PackedBits);
+
+	RecordNetAccount(ESMNetAccount::ServerMove, ESMNetDirection::Out, USMNetAccountingSubsystem::RPCHeaderBits + PackedBits.DataBits.Num());
+}
+
+void USMCharacterMovementComponent::ServerMovePacked_ServerReceive(const FCharacterServerMovePackedBits& PackedBits)
+{
+	if (ServerMoveReceiveTime == 0.0)
+	{
+		ServerMoveReceiveTime = FPlatformTime::Seconds();
+	}
+
+	RecordNetAccount(ESMNetAccount::ServerMove, ESMNetDirection::In, USMNetAccountingSubsystem::RPCHeaderBits + PackedBits.DataBits.Num());
+
+	Super::ServerMovePacked_ServerReceive(PackedBits);
+}
+
+void USMCharacterMovementComponent::MoveResponsePacked_ServerSend(const FCharacterMoveResponsePackedBits& PackedBits)
+{
+	Super::MoveResponsePacked_ServerSend(PackedBits);
+
+	RecordNetAccount(ESMNetAccount::MoveResponse, ESMNetDirection::Out, USMNetAccountingSubsystem::RPCHeaderBits + PackedBits.DataBits.Num());
+
+	// 응답은 틱 끝에 모아서 보내므로 이 구간에는 서버 프레임 대기 시간이 포함됩니다.
+	if (ServerMoveReceiveTime > 0.0)
+	{
+		RecordLatencySample(ESMLatencyAction::Move, ESMLatencyStage::ServerProcess, FPlatformTime::Seconds() - ServerMoveReceiveTime);
+		ServerMoveReceiveTime = 0.0;
+	}
+}
+
+void USMCharacterMovementComponent::MoveResponsePacked_ClientReceive(const FCharacterMoveResponsePackedBits& PackedBits)
+{
+	RecordNetAccount(ESMNetAccount::MoveResponse, ESMNetDirection::In, USMNetAccountingSubsystem::RPCHeaderBits + PackedBits.DataBits.Num());
+
+	Super::MoveResponsePacked_ClientReceive(PackedBits);
+}
+
+void USMCharacterMovementComponent::RecordNetAccount(ESMNetAccount InAccount, ESMNetDirection InDirection, uint32 InBits) const
+{
+	if (!USMNetAccountingSubsystem::IsEnabled() || !CharacterOwner)
+	{
+		return;
+	}
+
+	USMNetAccountingSubsystem* NetAccountingSubsystem = GetWorld()->GetSubsystem<USMNetAccountingSubsystem>();
+	if (NetAccountingSubsystem)
+	{
+		NetAccountingSubsystem->Record(CharacterOwner->GetNetConnection(), InAccount, InDirection, InBits);
+	}
+}
+
+void USMCharacterMovementComponent::MarkLatencyInput(ESMLatencyAction InAction)
+{
+	if (!USMLatencySubsystem::IsEnabled() || !CharacterOwner || CharacterOwner->GetLocalRole() != ROLE_AutonomousProxy)
+	{
+		return;
+	}
+
+	double& PendingInputTime = PendingLatencyInputTimes[static_cast<int32>(InAction)];
+	if (PendingInputTime == 0.0)
+	{
+		PendingInputTime = FPlatformTime::Seconds();
+	}
+}
+
+void USMCharacterMovementComponent::CallServerMovePacked(const FSavedMove_Character* NewMove, const FSavedMove_Character* PendingMove, const FSavedMove_Character* OldMove)
+{
+	Super::CallServerMovePacked(NewMove, PendingMove, OldMove);
+
+	if (!NewMove)
+	{
+		return;
+	}
+
+	const double CurrentTime = FPlatformTime::Seconds();
+	for (int32 i = 0; i < static_cast<int32>(ESMLatencyAction::Max); ++i)
+	{
+		double& PendingInputTime = PendingLatencyInputTimes[i];
+		if (PendingInputTime == 0.0)
+		{
+			continue;
+		}
+
+		FSentLatencyInput& SentInput = SentLatencyInputs.AddDefaulted_GetRef();
+		SentInput.Action = static_cast<ESMLatencyAction>(i);
+		SentInput.MoveTimeStamp = NewMove->TimeStamp;
+		SentInput.InputTime = PendingInputTime;
+		SentInput.SendTime = CurrentTime;
+		RecordLatencySample(SentInput.Action, ESMLatencyStage::ClientQueue, CurrentTime - PendingInputTime);
+
+		PendingInputTime = 0.0;
+	}
+}
+
+void USMCharacterMovementComponent::ClientHandleMoveResponse(const FCharacterMoveResponseDataContainer& MoveResponse)
+{
+	Super::ClientHandleMoveResponse(MoveResponse);
+
+	if (SentLatencyInputs.Num() == 0)
+	{
+		return;
+	}
+
+	// 서버는 최근 무브의 타임스탬프로 응답하므로 그 이전에 보낸 입력도 함께 확인된 것으로 봅니다.
+	const double CurrentTime = FPlatformTime::Seconds();
+	const float AckedTimeStamp = MoveResponse.ClientAdjustment.TimeStamp;
+	SentLatencyInputs.RemoveAll([this, CurrentTime, AckedTimeStamp](const FSentLatencyInput& SentInput)
+	{
+		if (SentInput.MoveTimeStamp <= AckedTimeStamp)
+		{
+			RecordLatencySample(SentInput.Action, ESMLatencyStage::RoundTrip, CurrentTime - SentInput.SendTime);
+			RecordLatencySample(SentInput.Action, ESMLatencyStage::Total, CurrentTime - SentInput.InputTime);
+			return true;
+		}
+
+		return CurrentTime - SentInput.SendTime > MaxLatencyInputAge;
+	});
+}
+
+void USMCharacterMovementComponent::RecordLatencySample(ESMLatencyAction InAction, ESMLatencyStage InStage, double InSeconds) const
+{
+	USMLatencySubsystem* LatencySubsystem = USMLatencySubsystem::IsEnabled() ? GetWorld()->GetSubsystem<USMLatencySubsystem>() : nullptr;
+	if (LatencySubsystem)
+	{
+		LatencySubsystem->RecordSample(InAction, InStage, InSeconds);
+	}
+}
+
+bool USMCharacterMovementComponent::ShouldUseSnapshotInterpolation() const
+{
+	if (!GSMSnapshotInterpolationEnabled || !CharacterOwner || CharacterOwner->GetLocalRole() != ROLE_SimulatedProxy || CharacterOwner->GetAttachParentActor())
+	{
+		return false;
+	}
+
+	// 움직이는 베이스 위의 위치는 베이스에 상대적으로 복제되므로 월드 좌표로 늦게 보간하면 베이스와 어긋납니다. 엔진의 베이스 이동 처리를 사용합니다.
+	if (CharacterOwner->GetReplicatedBasedMovement().HasRelativeLocation())
+	{
+		return false;
+	}
+
+	// 잡기를 예측한 시전자 클라이언트는 대상을 로컬에서 당깁니다.
+	const USMPullSubsystem* PullSubsystem = GetWorld()->GetSubsystem<USMPullSubsystem>();
+	const ASMPlayerCharacter* SMCharacterOwner = Cast<ASMPlayerCharacter>(CharacterOwner);
+	return !PullSubsystem || !SMCharacterOwner || !PullSubsystem->IsPulling(SMCharacterOwner);
+}
+
+void USMCharacterMovementComponent::AddSnapshot(const FVector& InLocation, const FQuat& InRotation, const FVector& InVelocity, uint8 InMovementMode)
+{
+	FSnapshot Snapshot;
+	Snapshot.Time = GetWorld()->GetTimeSeconds();
+	Snapshot.Location = InLocation;
+	Snapshot.Rotation = InRotation;
+	Snapshot.Velocity = InVelocity;
+	Snapshot.MovementMode = InMovementMode;
+
+	if (Snapshots.Num() == 0)
+	{
+		// 보간할 이전 스냅샷이 없으므로 바로 적용하고, 엔진 스무딩이 남긴 메시 오프셋을 초기화합니다.
+		FNetworkPredictionData_Client_Character* ClientData = GetPredictionData_Client_Character();
+		if (ClientData)
+		{
+			ClientData->MeshTranslationOffset = FVector::ZeroVector;
+			ClientData->OriginalMeshTranslationOffset = FVector::ZeroVector;
+		}
+
+		USkeletalMeshComponent* Mesh = CharacterOwner->GetMesh();
+		if (Mesh)
+		{
+			Mesh->SetRelativeLocationAndRotation(CharacterOwner->GetBaseTranslationOffset(), CharacterOwner->GetBaseRotationOffset());
+		}
+
+		CharacterOwner->SetActorLocationAndRotation(InLocation, InRotation, false, nullptr, ETeleportType::TeleportPhysics);
+		Velocity = InVelocity;
+		ApplyNetworkMovementMode(InMovementMode);
+		AppliedSnapshotMovementMode = InMovementMode;
+		bNetworkSmoothingComplete = true;
+	}
+	else
+	{
+		if (!Snapshots.Last().bSeeded)
+		{
+			UpdateSnapshotIntervalStats(Snapshot.Time - Snapshots.Last().Time);
+		}
+
+		if (Snapshots.Num() == MaxSnapshots)
+		{
+			Snapshots.RemoveAt(0, 1, false);
+		}
+	}
+
+	Snapshots.Add(Snapshot);
+	bNetworkMovementModeChanged = false;
+}
+
+void USMCharacterMovementComponent::SeedSnapshotFromCurrentTransform()
+{
+	if (!CharacterOwner)
+	{
+		return;
+	}
+
+	ResetSnapshots();
+
+	// 다음에 수신한 스냅샷까지 보간 지연 동안 이어지도록 지연만큼 과거의 스냅샷으로 둡니다.
+	SnapshotInterpolationDelay = GetTargetSnapshotInterpolationDelay();
+	AppliedSnapshotMovementMode = PackNetworkMovementMode();
+
+	FSnapshot& Snapshot = Snapshots.AddDefaulted_GetRef();
+	Snapshot.Time = GetWorld()->GetTimeSeconds() - SnapshotInterpolationDelay;
+	Snapshot.Location = CharacterOwner->GetActorLocation();
+	Snapshot.Rotation = CharacterOwner->GetActorQuat();
+	// 로컬에서 옮기던 위치라 속도를 신뢰할 수 없으므로 멈춘 상태에서 출발합니다.
+	Snapshot.Velocity = FVector::ZeroVector;
+	Snapshot.MovementMode = AppliedSnapshotMovementMode;
+	Snapshot.bSeeded = true;
+}
+
+double USMCharacterMovementComponent::GetSnapshotInterpolationDelay() const
+{
+	return Snapshots.Num() > 0 ? FMath::Max(SnapshotInterpolationDelay, static_cast<double>(GSMSnapshotInterpolationDelay)) : 0.0;
+}
+
+float USMCharacterMovementComponent::GetMaxSnapshotInterpolationDelay()
+{
+	return FMath::Max(GSMSnapshotMaxInterpolationDelay, GSMSnapshotInterpolationDelay);
+}
+
+double USMCharacterMovementComponent::GetTargetSnapshotInterpolationDelay() const
+{
+	// 다음 스냅샷이 렌더 시간보다 먼저 도착하려면 지연이 평균 간격에 지터의 여유를 더한 것보다 커야 합니다.
+	const double TargetDelay = SnapshotIntervalAverage + SnapshotJitterScale * SnapshotIntervalJitter;
+	return FMath::Clamp(TargetDelay, static_cast<double>(GSMSnapshotInterpolationDelay), static_cast<double>(GetMaxSnapshotInterpolationDelay()));
+}
+
+void USMCharacterMovementComponent::UpdateSnapshotIntervalStats(double InInterval)
+{
+	if (InInterval <= 0.0 || InInterval > GSMSnapshotMaxInterpolationDelay)
+	{
+		return;
+	}
+
+	if (SnapshotIntervalAverage <= 0.0)
+	{
+		SnapshotIntervalAverage = InInterval;
+		return;
+	}
+
+	SnapshotIntervalJitter += (FMath::Abs(InInterval - SnapshotIntervalAverage) - SnapshotIntervalJitter) * SnapshotIntervalSmoothing;
+	SnapshotIntervalAverage += (InInterval - SnapshotIntervalAverage) * SnapshotIntervalSmoothing;
+}
+
+void USMCharacterMovementComponent::SimulatedTick(float DeltaSeconds)
+{
+	if (!ShouldUseSnapshotInterpolation())
+	{
+		ResetSnapshots();
+		Super::SimulatedTick(DeltaSeconds);
+		return;
+	}
+
+	UpdateSnapshotInterpolation(DeltaSeconds);
+}
+
+void USMCharacterMovementComponent::UpdateSnapshotInterpolation(float DeltaSeconds)
+{
+	if (Snapshots.Num() == 0)
+	{
+		return;
+	}
+
+	// 지연을 한 번에 바꾸면 렌더 시간이 튀므로 일정한 속도로 목표 지연에 맞춥니다.
+	SnapshotInterpolationDelay = FMath::FInterpConstantTo(GetSnapshotInterpolationDelay(), GetTargetSnapshotInterpolationDelay(), static_cast<double>(DeltaSeconds), SnapshotDelayAdjustRate);
+	const double RenderTime = GetWorld()->GetTimeSeconds() - SnapshotInterpolationDelay;
+
+	// 렌더 시간 이전의 스냅샷은 마지막 하나만 남깁니다.
+	int32 NumExpired = 0;
+	while (NumExpired + 1 < Snapshots.Num() && Snapshots[NumExpired + 1].Time <= RenderTime)
+	{
+		++NumExpired;
+	}
+	if (NumExpired > 0)
+	{
+		Snapshots.RemoveAt(0, NumExpired, false);
+	}
+
+	const FSnapshot& From = Snapshots[0];
+	FVector NewLocation;
+	FQuat NewRotation;
+	FVector NewVelocity;
+	uint8 NewMovementMode;
+	if (RenderTime <= From.Time)
+	{
+		NewLocation = From.Location;
+		NewRotation = From.Rotation;
+		NewVelocity = From.Velocity;
+		NewMovementMode = From.MovementMode;
+	}
+	else if (Snapshots.Num() > 1)
+	{
+		// 속도를 접선으로 사용하는 에르미트 보간으로 점프의 포물선을 선형 보간보다 정확하게 따라갑니다.
+		const FSnapshot& To = Snapshots[1];
+		const double Interval = FMath::Max(To.Time - From.Time, UE_KINDA_SMALL_NUMBER);
+		const float Alpha = static_cast<float>(FMath::Clamp((RenderTime - From.Time) / Interval, 0.0, 1.0));
+		NewLocation = FMath::CubicInterp(From.Location, From.Velocity * Interval, To.Location, To.Velocity * Interval, Alpha);
+		NewRotation = FQuat::Slerp(From.Rotation, To.Rotation, Alpha);
+		NewVelocity = FMath::Lerp(From.Velocity, To.Velocity, Alpha);
+		NewMovementMode = Alpha < 1.0f ? From.MovementMode : To.MovementMode;
+	}
+	else
+	{
+		// 다음 스냅샷이 늦거나 유실되었다면 마지막 속도로 잠시 외삽합니다.
+		const double ExtrapolationTime = FMath::Min(RenderTime - From.Time, static_cast<double>(GSMSnapshotMaxExtrapolationTime));
+		NewLocation = From.Location + From.Velocity * ExtrapolationTime;
+		NewRotation = From.Rotation;
+		NewVelocity = RenderTime - From.Time <= GSMSnapshotMaxExtrapolationTime ? From.Velocity : FVector::ZeroVector;
+		NewMovementMode = From.MovementMode;
+	}
+
+	CharacterOwner->SetActorLocationAndRotation(NewLocation, NewRotation, false, nullptr, ETeleportType::TeleportPhysics);
+	Velocity = NewVelocity;
+
+	if (NewMovementMode != AppliedSnapshotMovementMode)
+	{
+		ApplyNetworkMovementMode(NewMovementMode);
+		AppliedSnapshotMovementMode = NewMovementMode;
+	}
+}
+
+void USMCharacterMovementComponent::ResetSnapshots()
+{
+	Snapshots.Reset();
+}
@@ -0,0 +1,167 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Subsystem/SMLatencySubsystem.h"
+#include "Subsystem/SMNetAccountingSubsystem.h"
+#include "SMCharacterMovementComponent.generated.h"
+
+/**
+ * 공중 입력 배율을 이동 시뮬레이션 안에서 적용하는 캐릭터 무브먼트 컴포넌트입니다.
+ * 클라이언트와 서버가 같은 시뮬레이션을 실행하기 때문에 점프 중에도 위치 보정이 생기지 않습니다.
+ */
+UCLASS()
+class STEREOMIXPROTOTYPE_API USMCharacterMovementComponent : public UCharacterMovementComponent
+{
+	GENERATED_BODY()
+
+public: // Falling Section
+	/** 공중에서는 입력 배율만큼 최대 속도도 줄어듭니다. */
+	virtual float GetMaxSpeed() const override;
+
+protected:
+	virtual FVector GetFallingLateralAcceleration(float DeltaTime) override;
+
+	/** 공중에서 입력 가속도와 최대 속도에 곱해지는 배율입니다. */
+	UPROPERTY(EditAnywhere, Category = "Falling")
+	float FallingInputScale = 0.5f;
+
+public: // Stat Section
+	/** 서버가 이 캐릭터를 조종하는 클라이언트에게 보낸 위치 보정 횟수입니다. */
+	uint32 GetNumServerCorrections() const { return NumServerCorrections; }
+
+protected:
+	virtual void ServerMoveHandleClientError(float ClientTimeStamp, float DeltaTime, const FVector& Accel, const FVector& RelativeClientLocation, UPrimitiveComponent* ClientMovementBase, FName ClientBaseBoneName, uint8 ClientMovementMode) override;
+
+	uint32 NumServerCorrections = 0;
+
+protected: // Net Accounting Section
+	/** 패킹된 무브와 무브 응답의 데이터 비트 수에 RPC 헤더 추정치를 더해 USMNetAccountingSubsystem에 기록합니다. */
+	virtual void ServerMovePacked_ClientSend(const FCharacterServerMovePackedBits& PackedBits) override;
+	virtual void ServerMovePacked_ServerReceive(const FCharacterServerMovePackedBits& PackedBits) override;
+	virtual void MoveResponsePacked_ServerSend(const FCharacterMoveResponsePackedBits& PackedBits) override;
+	virtual void MoveResponsePacked_ClientReceive(const FCharacterMoveResponsePackedBits& PackedBits) override;
+
+	/** 서버에서는 이 캐릭터를 조종하는 커넥션에, 클라이언트에서는 서버 커넥션에 기록합니다. */
+	void RecordNetAccount(ESMNetAccount InAccount, ESMNetDirection InDirection, uint32 InBits) const;
+
+public: // Latency Section
+	/**
+	 * 오토노머스 프록시에서 이동, 점프 입력이 발생한 시간을 기록합니다.
+	 * 입력을 담은 무브가 서버로 전송될 때 ClientQueue를, 서버의 응답으로 그 무브가 확인될 때 RoundTrip과 Total을 기록합니다.
+	 */
+	void MarkLatencyInput(ESMLatencyAction InAction);
+
+	/** 서버가 마지막으로 무브를 수신한 시간입니다. 응답을 보내면 0으로 초기화됩니다. */
+	double GetServerMoveReceiveTime() const { return ServerMoveReceiveTime; }
+
+protected:
+	virtual void CallServerMovePacked(const FSavedMove_Character* NewMove, const FSavedMove_Character* PendingMove, const FSavedMove_Character* OldMove) override;
+	virtual void ClientHandleMoveResponse(const FCharacterMoveResponseDataContainer& MoveResponse) override;
+
+	void RecordLatencySample(ESMLatencyAction InAction, ESMLatencyStage InStage, double InSeconds) const;
+
+	/** 서버의 응답을 기다리는 입력입니다. */
+	struct FSentLatencyInput
+	{
+		ESMLatencyAction Action = ESMLatencyAction::Move;
+
+		/** 입력을 담은 무브의 타임스탬프입니다. 서버는 이 타임스탬프로 무브를 확인합니다. */
+		float MoveTimeStamp = 0.0f;
+
+		double InputTime = 0.0;
+
+		double SendTime = 0.0;
+	};
+
+	/** 아직 전송되지 않은 입력 중 가장 먼저 발생한 입력의 시간입니다. 0이면 입력이 없습니다. */
+	double PendingLatencyInputTimes[static_cast<int32>(ESMLatencyAction::Max)] = {};
+
+	TArray<FSentLatencyInput> SentLatencyInputs;
+
+	double ServerMoveReceiveTime = 0.0;
+
+	/** 타임스탬프 초기화 등으로 확인되지 않은 입력은 이 시간이 지나면 버립니다. */
+	const double MaxLatencyInputAge = 2.0;
+
+public: // Snapshot Interpolation Section
+	/**
+	 * 시뮬레이티드 프록시에서 스냅샷 보간을 사용할지 확인합니다.
+	 * 어태치되어 있거나 로컬에서 당기는 중이거나 움직이는 베이스 위에 있다면 위치를 다른 곳에서 결정하므로 사용하지 않습니다.
+	 */
+	bool ShouldUseSnapshotInterpolation() const;
+
+	/** 수신한 이동 복제를 스냅샷으로 추가합니다. 버퍼가 비어 있다면 바로 그 위치로 이동합니다. */
+	void AddSnapshot(const FVector& InLocation, const FQuat& InRotation, const FVector& InVelocity, uint8 InMovementMode);
+
+	/**
+	 * 스냅샷 버퍼를 현재 화면의 트랜스폼 하나로 다시 채웁니다.
+	 * 로컬에서 위치를 정하다가 서버 위치로 돌아갈 때 먼저 호출하면 다음 AddSnapshot이 순간이동하지 않고 현재 위치에서 보간합니다.
+	 */
+	void SeedSnapshotFromCurrentTransform();
+
+	/** 스냅샷 보간 중이라면 화면에 보이는 위치가 수신한 위치보다 늦은 시간입니다. 보간 중이 아니면 0입니다. */
+	double GetSnapshotInterpolationDelay() const;
+
+	/** 보간 지연이 늘어날 수 있는 최대값입니다. 서버는 움직이는 캐릭터의 복제 주기를 이 안으로 제한합니다. */
+	static float GetMaxSnapshotInterpolationDelay();
+
+protected:
+	virtual void SimulatedTick(float DeltaSeconds) override;
+
+	/**
+	 * 보간 지연만큼 과거의 시간을 스냅샷 사이에서 보간하고, 스냅샷이 끊기면 잠시 외삽합니다.
+	 * 지연은 이 프록시의 스냅샷 간격과 지터로 정해지므로 멀어서 복제 주기가 긴 캐릭터일수록 길어집니다.
+	 */
+	void UpdateSnapshotInterpolation(float DeltaSeconds);
+
+	/** 관측한 스냅샷 간격의 평균과 지터로 정한 보간 지연입니다. SM.Net.InterpolationDelay와 SM.Net.MaxInterpolationDelay 사이로 제한됩니다. */
+	double GetTargetSnapshotInterpolationDelay() const;
+
+	/** 연속한 두 스냅샷의 수신 간격으로 간격의 평균과 지터를 갱신합니다. */
+	void UpdateSnapshotIntervalStats(double InInterval);
+
+	void ResetSnapshots();
+
+	struct FSnapshot
+	{
+		/** 수신한 시간(월드 시간)입니다. */
+		double Time = 0.0;
+
+		FVector Location = FVector::ZeroVector;
+
+		FQuat Rotation = FQuat::Identity;
+
+		FVector Velocity = FVector::ZeroVector;
+
+		uint8 MovementMode = 0;
+
+		/** 수신하지 않고 현재 트랜스폼으로 만든 스냅샷입니다. 수신 간격 통계에 사용하지 않습니다. */
+		bool bSeeded = false;
+	};
+
+	/** 수신 순서대로 쌓이는 스냅샷입니다. 보간에 더 이상 필요 없는 스냅샷은 앞에서부터 제거됩니다. */
+	TArray<FSnapshot, TInlineAllocator<8>> Snapshots;
+
+	uint8 AppliedSnapshotMovementMode = 0;
+
+	/** 현재 적용 중인 보간 지연입니다. */
+	double SnapshotInterpolationDelay = 0.0;
+
+	/** 스냅샷 수신 간격의 지수 이동 평균과 평균에서 벗어난 정도의 지수 이동 평균입니다. */
+	double SnapshotIntervalAverage = 0.0;
+
+	double SnapshotIntervalJitter = 0.0;
+
+	static constexpr int32 MaxSnapshots = 8;
+
+	static constexpr double SnapshotIntervalSmoothing = 0.1;
+
+	/** 평균 간격에 지터의 몇 배를 여유로 더할지입니다. */
+	static constexpr double SnapshotJitterScale = 2.0;
+
+	/** 보간 지연이 초당 바뀔 수 있는 시간(초)입니다. 이만큼 렌더 시간이 느려지거나 빨라집니다. */
+	static constexpr double SnapshotDelayAdjustRate = 0.1;
+};
@@ -7,18 +7,81 @@
 #include "EnhancedInputComponent.h"
 #include "EnhancedInputSubsystems.h"
 #include "SMCharacterAssetData.h"
+#include "SMCharacterMovementComponent.h"
 #include "Camera/CameraComponent.h"
 #include "Components/CapsuleComponent.h"
+#include "CoreGlobals.h"
+#include "Game/SMGameMode.h"
 #include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/GameModeBase.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameFramework/PlayerState.h"
 #include "GameFramework/SpringArmComponent.h"
-#include "Log/SMLog.h"
+#include "Log/SMBench.h"
+#include "Log/SMEventLog.h"
+#include "Log/SMPerfMetric.h"
+#include "Log/SMStats.h"
+#include "Net/Core/PushModel/PushModel.h"
 #include "Net/UnrealNetwork.h"
 #include "Physics/SMCollision.h"
-#include "Player/AimPlane.h"
 #include "Player/SMPlayerController.h"
+#include "Subsystem/SMFloorHeightSubsystem.h"
+#include "Subsystem/SMNetAccountingSubsystem.h"
+#include "Subsystem/SMNetUpdateSubsystem.h"
+#include "Subsystem/SMPullSubsystem.h"
+#include "Subsystem/SMSpatialGridSubsystem.h"
+#include "Subsystem/SMTickSignificanceSubsystem.h"
+#include "Subsystem/SMTraceSubsystem.h"
+#include "Subsystem/SMTravelSubsystem.h"
+
+bool FSMCharacterReplicatedState::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	// [State:2][bEnableCollision:1][bCanControl:1]
+	uint8 PackedState = 0;
+	if (Ar.IsSaving())
+	{
+		PackedState = static_cast<uint8>(State) & ((1 << StateBits) - 1);
+		PackedState |= (bEnableCollision ? 1 : 0) << StateBits;
+		PackedState |= (bCanControl ? 1 : 0) << (StateBits + 1);
+	}
+
+	Ar.SerializeBits(&PackedState, StateBits + 2);
+
+	if (Ar.IsLoading())
+	{
+		State = static_cast<EPlayerCharacterState>(PackedState & ((1 << StateBits) - 1));
+		bEnableCollision = (PackedState >> StateBits) & 1;
+		bCanControl = (PackedState >> (StateBits + 1)) & 1;
+	}
 
-ASMPlayerCharacter::ASMPlayerCharacter()
+	bOutSuccess = true;
+	return true;
+}
+
+namespace
 {
+	USMNetAccountingSubsystem* GetNetAccountingSubsystem(const UWorld* InWorld)
+	{
+		return USMNetAccountingSubsystem::IsEnabled() && InWorld ? InWorld->GetSubsystem<USMNetAccountingSubsystem>() : nullptr;
+	}
+
+	/** 집계에 사용하는 각 항목의 비트 수입니다. 파라미터 크기에 헤더 추정치를 더합니다. */
+	constexpr uint32 ReplicatedStateAccountBits = USMNetAccountingSubsystem::PropertyHeaderBits + FSMCharacterReplicatedState::StateBits + 2;
+	constexpr uint32 CatchPredictionAckAccountBits = USMNetAccountingSubsystem::PropertyHeaderBits * 2 + 16 + 1;
+	constexpr uint32 RotateToMousePointerAccountBits = USMNetAccountingSubsystem::RPCHeaderBits + 16;
+	constexpr uint32 PerformPullAccountBits = USMNetAccountingSubsystem::RPCHeaderBits + USMNetAccountingSubsystem::ObjectReferenceBits + 32 + 16 + 16;
+	constexpr uint32 AttachedCasterAccountBits = USMNetAccountingSubsystem::PropertyHeaderBits + USMNetAccountingSubsystem::ObjectReferenceBits;
+
+	/** Yaw 동기화 통계에 기록하는 바이트 수입니다. 페이로드만이 아니라 RPC 헤더 추정치를 포함합니다. */
+	constexpr uint32 RotateToMousePointerAccountBytes = (RotateToMousePointerAccountBits + 7) / 8;
+}
+
+ASMPlayerCharacter::ASMPlayerCharacter(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer.SetDefaultSubobjectClass<USMCharacterMovementComponent>(ACharacter::CharacterMovementComponentName))
+{
+	// 틱 그룹과 활성화 여부는 USMTickSignificanceSubsystem이 중요도에 따라 관리합니다.
+	PrimaryActorTick.bCanEverTick = true;
+
 	bUseControllerRotationYaw = false;
 
 	GetMesh()->SetCollisionProfileName("NoCollision");
@@ -41,9 +104,7 @@ ASMPlayerCharacter::ASMPlayerCharacter()
 
 	InitCamera();
 
-	CurrentState = EPlayerCharacterState::Normal;
-	bEnableCollision = true;
-	bCanControl = true;
+	bHasServerTargetYaw = false;
 }
 
 void ASMPlayerCharacter::PossessedBy(AController* NewController)
@@ -62,44 +123,107 @@ void ASMPlayerCharacter::BeginPlay()
 {
 	Super::BeginPlay();
 
-	if (IsLocallyControlled())
+	InitCharacterControl();
+
+	USMTickSignificanceSubsystem* TickSignificanceSubsystem = GetWorld()->GetSubsystem<USMTickSignificanceSubsystem>();
+	if (TickSignificanceSubsystem)
 	{
-		AimPlane = GetWorld()->SpawnActor<AAimPlane>();
-		const FAttachmentTransformRules AttachmentTransformRules(EAttachmentRule::SnapToTarget, true);
-		const bool bSuccess = AimPlane->AttachToActor(this, AttachmentTransformRules);
-		if (bSuccess) {}
+		TickSignificanceSubsystem->RegisterCharacter(this);
 	}
 
-	InitCharacterControl();
+	USMNetUpdateSubsystem* NetUpdateSubsystem = GetWorld()->GetSubsystem<USMNetUpdateSubsystem>();
+	if (NetUpdateSubsystem)
+	{
+		NetUpdateSubsystem->RegisterCharacter(this);
+	}
+
+	USMSpatialGridSubsystem* SpatialGridSubsystem = GetWorld()->GetSubsystem<USMSpatialGridSubsystem>();
+	if (SpatialGridSubsystem)
+	{
+		SpatialGridSubsystem->RegisterCharacter(this);
+	}
+}
+
+void ASMPlayerCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	USMTickSignificanceSubsystem* TickSignificanceSubsystem = GetWorld()->GetSubsystem<USMTickSignificanceSubsystem>();
+	if (TickSignificanceSubsystem)
+	{
+		TickSignificanceSubsystem->UnregisterCharacter(this);
+	}
+
+	USMNetUpdateSubsystem* NetUpdateSubsystem = GetWorld()->GetSubsystem<USMNetUpdateSubsystem>();
+	if (NetUpdateSubsystem)
+	{
+		NetUpdateSubsystem->UnregisterCharacter(this);
+	}
+
+	USMSpatialGridSubsystem* SpatialGridSubsystem = GetWorld()->GetSubsystem<USMSpatialGridSubsystem>();
+	if (SpatialGridSubsystem)
+	{
+		SpatialGridSubsystem->UnregisterCharacter(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void ASMPlayerCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
 {
 	Super::SetupPlayerInputComponent(PlayerInputComponent);
 
+	// 에셋 데이터가 아직 준비되지 않았다면 OnAssetDataLoaded에서 바인딩합니다.
+	if (AssetData)
+	{
+		BindInputActions(PlayerInputComponent);
+	}
+}
+
+void ASMPlayerCharacter::OnAssetDataLoaded()
+{
+	Super::OnAssetDataLoaded();
+
+	if (InputComponent)
+	{
+		BindInputActions(InputComponent);
+	}
+
+	InitCharacterControl();
+}
+
+void ASMPlayerCharacter::BindInputActions(UInputComponent* PlayerInputComponent)
+{
 	UEnhancedInputComponent* EnhancedInputComponent = Cast<UEnhancedInputComponent>(PlayerInputComponent);
 	if (EnhancedInputComponent)
 	{
-		EnhancedInputComponent->BindAction(AssetData->MoveAction, ETriggerEvent::Triggered, this, &ASMPlayerCharacter::Move);
-		EnhancedInputComponent->BindAction(AssetData->JumpAction, ETriggerEvent::Triggered, this, &ASMPlayerCharacter::Jump);
-		EnhancedInputComponent->BindAction(AssetData->HoldAction, ETriggerEvent::Started, this, &ASMPlayerCharacter::Catch);
+		EnhancedInputComponent->BindAction(AssetData->MoveAction.Get(), ETriggerEvent::Triggered, this, &ASMPlayerCharacter::Move);
+		EnhancedInputComponent->BindAction(AssetData->JumpAction.Get(), ETriggerEvent::Triggered, this, &ASMPlayerCharacter::Jump);
+		EnhancedInputComponent->BindAction(AssetData->HoldAction.Get(), ETriggerEvent::Started, this, &ASMPlayerCharacter::Catch);
 	}
 }
 
 void ASMPlayerCharacter::Tick(float DeltaSeconds)
 {
+	SM_SCOPE_CYCLE_COUNTER(CharacterTick);
+
 	Super::Tick(DeltaSeconds);
 
-	if (bCanControl)
+	if (ReplicatedState.bCanControl)
 	{
 		UpdateRotateToMousePointer();
 	}
 
+	if (PendingCatchPredictionKey != 0 && GetWorld()->GetTimeSeconds() - PendingCatchPredictionTime > CatchPredictionTimeout)
+	{
+		RollbackCatchPrediction(true);
+	}
+
 	if (HasAuthority())
 	{
-		if (PullData.bIsPulling)
+		PositionHistory.Record(GetServerWorldTime(), GetActorLocation());
+
+		if (bHasServerTargetYaw)
 		{
-			UpdatePerformPull(DeltaSeconds);
+			UpdateServerYawSmoothing(DeltaSeconds);
 		}
 	}
 }
@@ -108,13 +232,24 @@ void ASMPlayerCharacter::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& O
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	DOREPLIFETIME(ASMPlayerCharacter, CurrentState);
-	DOREPLIFETIME(ASMPlayerCharacter, bEnableCollision);
-	DOREPLIFETIME(ASMPlayerCharacter, bCanControl);
+	FDoRepLifetimeParams ReplicatedStateParams;
+	ReplicatedStateParams.bIsPushBased = true;
+	DOREPLIFETIME_WITH_PARAMS_FAST(ASMPlayerCharacter, ReplicatedState, ReplicatedStateParams);
+
+	FDoRepLifetimeParams CatchPredictionAckParams;
+	CatchPredictionAckParams.Condition = COND_OwnerOnly;
+	CatchPredictionAckParams.bIsPushBased = true;
+	DOREPLIFETIME_WITH_PARAMS_FAST(ASMPlayerCharacter, CatchPredictionAck, CatchPredictionAckParams);
+
+	FDoRepLifetimeParams AttachedCasterParams;
+	AttachedCasterParams.bIsPushBased = true;
+	DOREPLIFETIME_WITH_PARAMS_FAST(ASMPlayerCharacter, AttachedCaster, AttachedCasterParams);
 }
 
 void ASMPlayerCharacter::OnRep_Controller()
 {
+	SM_SCOPE_CYCLE_COUNTER(OnRepController);
+
 	Super::OnRep_Controller();
 
 	// 로컬 컨트롤러를 캐싱해야하기위한 조건입니다.
@@ -144,27 +279,28 @@ void ASMPlayerCharacter::InitCamera()
 
 void ASMPlayerCharacter::Move(const FInputActionValue& InputActionValue)
 {
+	SM_SCOPE_CYCLE_COUNTER(Move);
+
+	USMCharacterMovementComponent* SMCharacterMovement = Cast<USMCharacterMovementComponent>(GetCharacterMovement());
+	if (SMCharacterMovement)
+	{
+		SMCharacterMovement->MarkLatencyInput(ESMLatencyAction::Move);
+	}
+
 	const FVector2D InputScalar = InputActionValue.Get<FVector2D>().GetSafeNormal();
 	const FRotator CameraYawRotation(0.0, Camera->GetComponentRotation().Yaw, 0.0);
 	const FVector ForwardDirection = FRotationMatrix(CameraYawRotation).GetUnitAxis(EAxis::X);
 	const FVector RightDirection = FRotationMatrix(CameraYawRotation).GetUnitAxis(EAxis::Y);
 	const FVector MoveVector = (ForwardDirection * InputScalar.X) + (RightDirection * InputScalar.Y);
 
-	const UCharacterMovementComponent* CachedCharacterMovement = GetCharacterMovement();
-	if (CachedCharacterMovement->IsFalling())
-	{
-		const FVector NewMoveVector = MoveVector / 2.0f;
-		AddMovementInput(NewMoveVector);
-	}
-	else
-	{
-		AddMovementInput(MoveVector);
-	}
+	// 공중 입력 배율은 서버와 같은 결과가 나오도록 USMCharacterMovementComponent의 시뮬레이션 안에서 적용됩니다.
+	AddMovementInput(MoveVector);
 }
 
 void ASMPlayerCharacter::InitCharacterControl()
 {
-	if (!IsLocallyControlled())
+	// 에셋 데이터가 준비되면 OnAssetDataLoaded에서 다시 호출됩니다.
+	if (!IsLocallyControlled() || !AssetData)
 	{
 		return;
 	}
@@ -176,27 +312,29 @@ void ASMPlayerCharacter::InitCharacterControl()
 		if (Subsystem)
 		{
 			Subsystem->ClearAllMappings();
-			Subsystem->AddMappingContext(AssetData->DefaultMappingContext, 0);
+			Subsystem->AddMappingContext(AssetData->DefaultMappingContext.Get(), 0);
 		}
 	}
 
 	FInputModeGameOnly InputModeGameOnly;
 	InputModeGameOnly.SetConsumeCaptureMouseDown(false);
 	PlayerController->SetInputMode(InputModeGameOnly);
+
+	USMTravelSubsystem* TravelSubsystem = UGameInstance::GetSubsystem<USMTravelSubsystem>(GetGameInstance());
+	if (TravelSubsystem)
+	{
+		TravelSubsystem->ReportInMatch();
+	}
 }
 
 FVector ASMPlayerCharacter::GetMousePointingDirection()
 {
 	if (StoredSMPlayerController)
 	{
-		FHitResult HitResult;
-		const bool Succeed = StoredSMPlayerController->GetHitResultUnderCursor(TC_AIM_PLANE, false, HitResult);
-
-		if (Succeed)
+		const FSMAimData& AimData = StoredSMPlayerController->GetAimData();
+		if (AimData.bIsValid)
 		{
-			const FVector MouseLocation = HitResult.Location;
-			const FVector MouseDirection = (MouseLocation - GetActorLocation()).GetSafeNormal();
-			return MouseDirection;
+			return AimData.AimDirection;
 		}
 	}
 
@@ -205,6 +343,8 @@ FVector ASMPlayerCharacter::GetMousePointingDirection()
 
 void ASMPlayerCharacter::UpdateRotateToMousePointer()
 {
+	SM_SCOPE_CYCLE_COUNTER(RotateToMousePointer);
+
 	if (IsLocallyControlled())
 	{
 		const FVector MousePointingDirection = GetMousePointingDirection();
@@ -220,27 +360,271 @@ void ASMPlayerCharacter::UpdateRotateToMousePointer()
 
 		if (!HasAuthority())
 		{
-			ServerRotateToMousePointer(NewRotation.Yaw);
+			UpdateYawSync(NewRotation.Yaw);
 		}
 	}
 }
 
-void ASMPlayerCharacter::ServerRotateToMousePointer_Implementation(float InYaw)
+void ASMPlayerCharacter::ServerRotateToMousePointer_Implementation(uint16 InCompressedYaw)
 {
 	// 트랜스폼은 리플리케이트 무브먼트 활성화 시 자동으로 모든 클라이언트에 동기화하기 때문에 서버에서만 처리해주면 됩니다.
-	SetActorRotation(FRotator(0.0, InYaw, 0.0));
+	// 샘플 간 간격이 있기 때문에 바로 적용하지 않고 Tick에서 보간합니다.
+	ServerTargetYaw = FRotator::DecompressAxisFromShort(InCompressedYaw);
+	bHasServerTargetYaw = true;
+
+	if (StoredSMPlayerController)
+	{
+		StoredSMPlayerController->RecordYawSyncReceived(RotateToMousePointerAccountBytes);
+	}
+
+	USMNetAccountingSubsystem* NetAccountingSubsystem = GetNetAccountingSubsystem(GetWorld());
+	if (NetAccountingSubsystem)
+	{
+		NetAccountingSubsystem->Record(GetNetConnection(), ESMNetAccount::ServerRotateToMousePointer, ESMNetDirection::In, RotateToMousePointerAccountBits);
+	}
+}
+
+void ASMPlayerCharacter::UpdateYawSync(float InYaw)
+{
+	const float CurrentTime = GetWorld()->GetTimeSeconds();
+	const float ElapsedTime = CurrentTime - LastYawSyncSendTime;
+	const uint16 CompressedYaw = FRotator::CompressAxisToShort(InYaw);
+
+	// uint16 차이를 int16으로 해석해 359도와 0도 사이의 변화도 작은 차이로 계산합니다.
+	const int32 YawDelta = FMath::Abs(static_cast<int32>(static_cast<int16>(CompressedYaw - LastSentCompressedYaw)));
+
+	const bool bRateLimited = ElapsedTime < YawSyncSendInterval;
+	const bool bInDeadBand = YawDelta < YawSyncDeadBand && ElapsedTime < YawSyncSettleTime;
+	if (YawDelta == 0 || bRateLimited || bInDeadBand)
+	{
+		if (StoredSMPlayerController)
+		{
+			StoredSMPlayerController->RecordYawSyncSkipped();
+		}
+		return;
+	}
+
+	LastYawSyncSendTime = CurrentTime;
+	LastSentCompressedYaw = CompressedYaw;
+	ServerRotateToMousePointer(CompressedYaw);
+
+	if (StoredSMPlayerController)
+	{
+		StoredSMPlayerController->RecordYawSyncSent(RotateToMousePointerAccountBytes);
+	}
+
+	USMNetAccountingSubsystem* NetAccountingSubsystem = GetNetAccountingSubsystem(GetWorld());
+	if (NetAccountingSubsystem)
+	{
+		NetAccountingSubsystem->RecordToServer(ESMNetAccount::ServerRotateToMousePointer, RotateToMousePointerAccountBits);
+	}
 }
 
-void ASMPlayerCharacter::OnRep_bCanControl()
+void ASMPlayerCharacter::UpdateServerYawSmoothing(float DeltaSeconds)
 {
-	NET_LOG(LogSMNetwork, Log, TEXT("컨트롤 상태 변경 감지"))
-	if (bCanControl)
+	const FRotator TargetRotation(0.0, ServerTargetYaw, 0.0);
+	const FRotator NewRotation = FMath::RInterpTo(GetActorRotation(), TargetRotation, DeltaSeconds, YawSyncInterpSpeed);
+	if (NewRotation.Equals(TargetRotation, 0.1))
 	{
-		EnableInput(StoredSMPlayerController);
+		SetActorRotation(TargetRotation);
+		bHasServerTargetYaw = false;
+		return;
+	}
+
+	SetActorRotation(NewRotation);
+}
+
+void ASMPlayerCharacter::SetReplicatedState(const FSMCharacterReplicatedState& InReplicatedState)
+{
+	if (ReplicatedState == InReplicatedState)
+	{
+		return;
+	}
+
+	const FSMCharacterReplicatedState PreviousState = ReplicatedState;
+	ReplicatedState = InReplicatedState;
+	MARK_PROPERTY_DIRTY_FROM_NAME(ASMPlayerCharacter, ReplicatedState, this);
+
+	USMNetAccountingSubsystem* NetAccountingSubsystem = GetNetAccountingSubsystem(GetWorld());
+	if (NetAccountingSubsystem)
+	{
+		NetAccountingSubsystem->RecordToRelevantConnections(this, ESMNetAccount::ReplicatedState, ReplicatedStateAccountBits);
+	}
+
+	OnRep_ReplicatedState(PreviousState);
+
+	// 잡힘, 풀 반환 같은 상태 변경은 업데이트 주기를 기다리지 않고 바로 전송합니다.
+	USMNetUpdateSubsystem* NetUpdateSubsystem = GetWorld()->GetSubsystem<USMNetUpdateSubsystem>();
+	if (NetUpdateSubsystem)
+	{
+		NetUpdateSubsystem->NotifyStateChanged(this);
+	}
+}
+
+void ASMPlayerCharacter::OnRep_ReplicatedState(const FSMCharacterReplicatedState& InPreviousState)
+{
+	SM_SCOPE_CYCLE_COUNTER(OnRepReplicatedState);
+
+	// 서버는 SetReplicatedState에서 직접 호출하므로 클라이언트의 수신만 기록합니다.
+	USMNetAccountingSubsystem* NetAccountingSubsystem = !HasAuthority() ? GetNetAccountingSubsystem(GetWorld()) : nullptr;
+	if (NetAccountingSubsystem)
+	{
+		NetAccountingSubsystem->RecordFromServer(ESMNetAccount::ReplicatedState, ReplicatedStateAccountBits);
+	}
+
+	if (ReplicatedState.bEnableCollision != InPreviousState.bEnableCollision)
+	{
+		SetActorEnableCollision(ReplicatedState.bEnableCollision != 0);
+		MarkSpatialGridDirty();
+	}
+
+	if (ReplicatedState.bCanControl != InPreviousState.bCanControl)
+	{
+		SM_EVENT(ControlChanged, ReplicatedState.bCanControl);
+		if (ReplicatedState.bCanControl)
+		{
+			EnableInput(StoredSMPlayerController);
+		}
+		else
+		{
+			DisableInput(StoredSMPlayerController);
+		}
+	}
+
+	if (ReplicatedState.State != InPreviousState.State)
+	{
+		switch (ReplicatedState.State)
+		{
+			case EPlayerCharacterState::Normal:
+			{
+				GetCharacterMovement()->GravityScale = 2.0f;
+				break;
+			}
+			case EPlayerCharacterState::Caught:
+			{
+				GetCharacterMovement()->GravityScale = 0.0f;
+				break;
+			}
+		}
+	}
+}
+
+void ASMPlayerCharacter::ResetForReuse()
+{
+	USMPullSubsystem* PullSubsystem = GetWorld()->GetSubsystem<USMPullSubsystem>();
+	if (PullSubsystem)
+	{
+		PullSubsystem->CancelPull(this);
+	}
+
+	// 이 캐릭터에게 잡혀 있던 캐릭터와 이 캐릭터를 잡고 있던 캐릭터 모두에서 분리합니다. 어태치 상태도 함께 복제됩니다.
+	TArray<AActor*> AttachedActors;
+	GetAttachedActors(AttachedActors);
+	for (AActor* AttachedActor : AttachedActors)
+	{
+		ASMPlayerCharacter* AttachedCharacter = Cast<ASMPlayerCharacter>(AttachedActor);
+		if (AttachedCharacter)
+		{
+			AttachedCharacter->SetAttachedCaster(nullptr);
+		}
+		else
+		{
+			AttachedActor->DetachFromActor(FDetachmentTransformRules::KeepWorldTransform);
+		}
+	}
+
+	SetAttachedCaster(nullptr);
+	DetachFromActor(FDetachmentTransformRules::KeepWorldTransform);
+
+	FSMCharacterReplicatedState PooledState;
+	PooledState.bEnableCollision = false;
+	PooledState.bCanControl = false;
+	SetReplicatedState(PooledState);
+
+	// 이전 컨트롤러의 입력은 위에서 비활성화되었으므로 캐싱된 컨트롤러를 비워 다음 빙의 전에 사용되지 않게 합니다.
+	StoredSMPlayerController = nullptr;
+
+	PendingCatchPredictionKey = 0;
+	PredictedCatchTarget = nullptr;
+	PendingCatchInputTime = 0.0;
+	PendingCatchSendTime = 0.0;
+	CatchReceiveTime = 0.0;
+	PositionHistory.Reset();
+	bHasServerTargetYaw = false;
+
+	GetCharacterMovement()->StopMovementImmediately();
+	GetCharacterMovement()->DisableMovement();
+
+	SetActorHiddenInGame(true);
+	MarkSpatialGridDirty();
+
+	USMTickSignificanceSubsystem* TickSignificanceSubsystem = GetWorld()->GetSubsystem<USMTickSignificanceSubsystem>();
+	if (TickSignificanceSubsystem)
+	{
+		TickSignificanceSubsystem->UnregisterCharacter(this);
+	}
+
+	SetActorTickEnabled(false);
+
+	// 위의 상태 변경이 복제된 뒤에는 보낼 것이 없으므로 풀에 있는 동안 복제 대상에서 제외합니다.
+	SetNetDormancy(DORM_DormantAll);
+}
+
+void ASMPlayerCharacter::ActivateFromPool(const FTransform& InSpawnTransform)
+{
+	SetNetDormancy(DORM_Awake);
+
+	SetActorTransform(InSpawnTransform, false, nullptr, ETeleportType::ResetPhysics);
+
+	GetCharacterMovement()->SetDefaultMovementMode();
+
+	SetReplicatedState(FSMCharacterReplicatedState());
+
+	SetActorHiddenInGame(false);
+	SetActorTickEnabled(true);
+	MarkSpatialGridDirty();
+
+	USMTickSignificanceSubsystem* TickSignificanceSubsystem = GetWorld()->GetSubsystem<USMTickSignificanceSubsystem>();
+	if (TickSignificanceSubsystem)
+	{
+		TickSignificanceSubsystem->RegisterCharacter(this);
+	}
+}
+
+void ASMPlayerCharacter::FellOutOfWorld(const UDamageType& DmgType)
+{
+	// 클라이언트는 서버의 리스폰이 복제되기를 기다립니다.
+	if (!HasAuthority())
+	{
+		return;
+	}
+
+	ASMGameMode* GameMode = GetWorld()->GetAuthGameMode<ASMGameMode>();
+	if (!GameMode)
+	{
+		Super::FellOutOfWorld(DmgType);
+		return;
+	}
+
+	AController* OwningController = GetController();
+	if (OwningController)
+	{
+		GameMode->RespawnPlayer(OwningController);
 	}
 	else
 	{
-		DisableInput(StoredSMPlayerController);
+		GameMode->ReleaseCharacter(this);
+	}
+}
+
+void ASMPlayerCharacter::Jump()
+{
+	Super::Jump();
+
+	USMCharacterMovementComponent* SMCharacterMovement = Cast<USMCharacterMovementComponent>(GetCharacterMovement());
+	if (SMCharacterMovement)
+	{
+		SMCharacterMovement->MarkLatencyInput(ESMLatencyAction::Jump);
 	}
 }
 
@@ -248,6 +632,13 @@ void ASMPlayerCharacter::OnJumped_Implementation()
 {
 	Super::OnJumped_Implementation();
 
+	// 서버에서 원격 클라이언트의 점프 입력이 담긴 무브가 적용된 시점입니다.
+	const USMCharacterMovementComponent* SMCharacterMovement = Cast<USMCharacterMovementComponent>(GetCharacterMovement());
+	if (HasAuthority() && !IsLocallyControlled() && SMCharacterMovement && SMCharacterMovement->GetServerMoveReceiveTime() > 0.0)
+	{
+		RecordLatencySample(GetWorld(), ESMLatencyAction::Jump, ESMLatencyStage::ServerProcess, FPlatformTime::Seconds() - SMCharacterMovement->GetServerMoveReceiveTime());
+	}
+
 	UE_LOG(LogSMPlayerCharacter, Log, TEXT("Jumped!"));
 }
 
@@ -260,23 +651,79 @@ void ASMPlayerCharacter::Landed(const FHitResult& Hit)
 
 float ASMPlayerCharacter::DistanceHeightFromFloor()
 {
-	FHitResult HitResult;
 	const FVector Start = GetActorLocation() + (-GetActorUpVector() * 90.5f);
 	const FVector End = GetActorLocation() + (-GetActorUpVector() * 10000.0f);
+
+	// 정적 바닥 위라면 구워둔 높이 필드로 바로 구합니다. 움직이는 바닥 위이거나 높이 필드로 답할 수 없는 위치에서는 트레이스합니다.
+	USMFloorHeightSubsystem* FloorHeightSubsystem = USMFloorHeightSubsystem::IsEnabled() ? GetWorld()->GetSubsystem<USMFloorHeightSubsystem>() : nullptr;
+	const UPrimitiveComponent* MovementBase = GetMovementBase();
+	const bool bOnDynamicBase = MovementBase && MovementBase->Mobility != EComponentMobility::Static;
+	if (FloorHeightSubsystem && !bOnDynamicBase)
+	{
+		float FloorHeight;
+		if (FloorHeightSubsystem->SampleFloorHeight(Start, FloorHeight))
+		{
+			// 진행 중인 트레이스의 결과는 가져가지 않으면 버려지므로 다음 트레이스가 새로 요청할 수 있게 핸들만 지웁니다.
+			FloorTraceHandle.Reset();
+			HeightFromFloor = FloorHeight >= End.Z ? FMath::Max(static_cast<float>(Start.Z) - FloorHeight, 0.0f) : 0.0f;
+			HeightFromFloorFrame = GFrameCounter;
+			return HeightFromFloor;
+		}
+	}
+
+	USMTraceSubsystem* TraceSubsystem = GetWorld()->GetSubsystem<USMTraceSubsystem>();
+	if (!TraceSubsystem)
+	{
+		return HeightFromFloor;
+	}
+
 	FCollisionObjectQueryParams CollisionObjectQueryParams;
-	FCollisionQueryParams CollisionQueryParams(SCENE_QUERY_STAT(DistanceHeigh), false, this);
 	CollisionObjectQueryParams.AddObjectTypesToQuery(ECC_WorldStatic);
-	const bool bSuccess = GetWorld()->LineTraceSingleByObjectType(HitResult, Start, End, CollisionObjectQueryParams, CollisionQueryParams);
-	if (bSuccess)
+	const FCollisionQueryParams CollisionQueryParams(SCENE_QUERY_STAT(DistanceHeigh), false, this);
+
+	// 지난 요청의 결과가 도착했다면 반영하고, 도착하기 전에는 새로 요청하지 않습니다. 결과가 버려졌다면 다시 요청합니다.
+	if (FloorTraceHandle.IsValid())
 	{
-		const float Distance = (HitResult.Location - Start).Size();
-		UE_LOG(LogSMPlayerCharacter, Warning, TEXT("Height: %f"), Distance);
+		FSMTraceResult TraceResult;
+		const ESMTraceStatus TraceStatus = TraceSubsystem->PollResult(FloorTraceHandle, TraceResult);
+		if (TraceStatus == ESMTraceStatus::Ready)
+		{
+			HeightFromFloor = TraceResult.bHit ? (TraceResult.HitResult.Location - FloorTraceStart).Size() : 0.0f;
+			HeightFromFloorFrame = FloorTraceFrame;
+			UE_LOG(LogSMPlayerCharacter, Verbose, TEXT("Height: %f"), HeightFromFloor);
+		}
 
-		return Distance;
+		if (TraceStatus != ESMTraceStatus::Pending)
+		{
+			FloorTraceHandle.Reset();
+		}
 	}
-	else
+
+	// 처음 호출했거나 가끔 호출해 마지막 값이 결과 보관 기간보다 오래되었다면 기다리지 않고 동기로 구합니다.
+	if (HeightFromFloorFrame == 0 || GFrameCounter - HeightFromFloorFrame > USMTraceSubsystem::ResultLifetimeFrames)
 	{
-		return 0.0f;
+		FHitResult HitResult;
+		const bool bHit = TraceSubsystem->TraceSync(HitResult, Start, End, FCollisionShape(), CollisionObjectQueryParams, CollisionQueryParams);
+		HeightFromFloor = bHit ? (HitResult.Location - Start).Size() : 0.0f;
+		HeightFromFloorFrame = GFrameCounter;
+	}
+
+	if (!FloorTraceHandle.IsValid())
+	{
+		FloorTraceStart = Start;
+		FloorTraceFrame = GFrameCounter;
+		FloorTraceHandle = TraceSubsystem->RequestTrace(FloorTraceStart, End, FCollisionShape(), CollisionObjectQueryParams, CollisionQueryParams);
+	}
+
+	return HeightFromFloor;
+}
+
+void ASMPlayerCharacter::MarkSpatialGridDirty()
+{
+	USMSpatialGridSubsystem* SpatialGridSubsystem = GetWorld()->GetSubsystem<USMSpatialGridSubsystem>();
+	if (SpatialGridSubsystem)
+	{
+		SpatialGridSubsystem->MarkDirty();
 	}
 }
 
@@ -287,131 +734,543 @@ void ASMPlayerCharacter::Catch()
 
 void ASMPlayerCharacter::HandleCatch()
 {
-	if (IsLocallyControlled())
+	SM_SCOPE_CYCLE_COUNTER(HandleCatch);
+
+	// 예측한 잡기의 응답을 기다리는 동안에는 새로운 잡기를 하지 않습니다.
+	if (IsLocallyControlled() && PendingCatchPredictionKey == 0)
 	{
-		NET_LOG(LogSMNetwork, Log, TEXT("잡기 시전"));
+		SM_EVENT(CatchCast);
+
+		const double InputTime = FPlatformTime::Seconds();
 
 		// 충돌 로직
 		FHitResult HitResult;
-		const FVector Start = GetActorLocation();
-		const FVector End = Start + (GetActorForwardVector() * 300.0f);
-		FCollisionObjectQueryParams CollisionObjectQueryParams;
-		CollisionObjectQueryParams.AddObjectTypesToQuery(ECC_Pawn);
-		FCollisionQueryParams CollisionQueryParams(SCENE_QUERY_STAT(Hold), false, this);
-		const bool bSuccess = GetWorld()->SweepSingleByObjectType(HitResult, Start, End, FQuat::Identity, CollisionObjectQueryParams, FCollisionShape::MakeSphere(50.0f), CollisionQueryParams);
+		const bool bSuccess = SweepCatch(HitResult);
 
 		// 충돌 시
 		if (bSuccess)
 		{
-			NET_LOG(LogSMNetwork, Log, TEXT("잡기 적중"));
 			ASMPlayerCharacter* HitPlayerCharacter = Cast<ASMPlayerCharacter>(HitResult.GetActor());
+			SM_EVENT(CatchHit, HitPlayerCharacter ? HitPlayerCharacter->GetUniqueID() : 0);
 			if (HitPlayerCharacter)
 			{
-				ServerRPCPerformPull(HitPlayerCharacter);
+				// 클라이언트 화면의 다른 캐릭터는 서버보다 편도 지연만큼 과거의 위치이기 때문에 그만큼 이전 시간을 함께 보냅니다.
+				const APlayerState* CachedPlayerState = GetPlayerState();
+				const float OneWayLatency = CachedPlayerState ? CachedPlayerState->GetPingInMilliseconds() * 0.0005f : 0.0f;
+				// 대상이 스냅샷 보간 중이라면 화면의 위치는 보간 지연만큼 더 과거입니다.
+				const USMCharacterMovementComponent* TargetMovement = Cast<USMCharacterMovementComponent>(HitPlayerCharacter->GetCharacterMovement());
+				const float InterpolationDelay = TargetMovement ? static_cast<float>(TargetMovement->GetSnapshotInterpolationDelay()) : 0.0f;
+				const float ClientTimeStamp = GetServerWorldTime() - OneWayLatency - InterpolationDelay;
+
+				// 서버는 직접 판정하므로 예측이 필요 없습니다.
+				const uint16 PredictionKey = HasAuthority() ? 0 : PredictCatch(HitPlayerCharacter);
+				ServerRPCPerformPull(HitPlayerCharacter, ClientTimeStamp, FRotator::CompressAxisToShort(GetActorRotation().Yaw), PredictionKey);
+
+				USMNetAccountingSubsystem* NetAccountingSubsystem = !HasAuthority() ? GetNetAccountingSubsystem(GetWorld()) : nullptr;
+				if (NetAccountingSubsystem)
+				{
+					NetAccountingSubsystem->RecordToServer(ESMNetAccount::ServerRPCPerformPull, PerformPullAccountBits);
+				}
+
+				if (!HasAuthority())
+				{
+					const double SendTime = FPlatformTime::Seconds();
+					RecordLatencySample(GetWorld(), ESMLatencyAction::Hold, ESMLatencyStage::ClientQueue, SendTime - InputTime);
+
+					// 응답은 예측한 잡기에만 돌아옵니다.
+					PendingCatchInputTime = PredictionKey != 0 ? InputTime : 0.0;
+					PendingCatchSendTime = PredictionKey != 0 ? SendTime : 0.0;
+				}
 			}
 		}
 
 		// 디버거
+		const FVector Start = GetActorLocation();
+		const FVector End = Start + (GetActorForwardVector() * CatchDistance);
 		const FVector Center = Start + (End - Start) * 0.5f;
 		const FColor DrawColor = bSuccess ? FColor::Green : FColor::Red;
-		DrawDebugCapsule(GetWorld(), Center, 150.0f, 50.0f, FRotationMatrix::MakeFromZ(GetActorForwardVector()).ToQuat(), DrawColor, false, 1.0f);
+		DrawDebugCapsule(GetWorld(), Center, CatchDistance * 0.5f, CatchRadius, FRotationMatrix::MakeFromZ(GetActorForwardVector()).ToQuat(), DrawColor, false, 1.0f);
 	}
 }
 
-void ASMPlayerCharacter::OnRep_CurrentState()
+bool ASMPlayerCharacter::SweepCatch(FHitResult& OutHitResult) const
 {
-	switch (CurrentState)
+	const FVector Start = GetActorLocation();
+	const FVector End = Start + (GetActorForwardVector() * CatchDistance);
+	FCollisionObjectQueryParams CollisionObjectQueryParams;
+	CollisionObjectQueryParams.AddObjectTypesToQuery(ECC_Pawn);
+	FCollisionQueryParams CollisionQueryParams(SCENE_QUERY_STAT(Hold), false, this);
+
+	// 격자에서 스윕에 닿을 수 있는 캐릭터가 없다면 물리 스윕을 건너뜁니다. 격자는 이전 위치이므로 그 사이 시전자와 대상이 가까워졌을 수 있는 거리만큼 넓혀 찾습니다.
+	USMSpatialGridSubsystem* SpatialGridSubsystem = USMSpatialGridSubsystem::IsCatchPreselectEnabled() ? GetWorld()->GetSubsystem<USMSpatialGridSubsystem>() : nullptr;
+	float QueryMargin;
+	if (SpatialGridSubsystem && SpatialGridSubsystem->GetQueryMargin(GetCharacterMovement()->GetMaxSpeed(), QueryMargin))
 	{
-		case EPlayerCharacterState::Normal:
+		TArray<ASMPlayerCharacter*> Candidates;
+		SpatialGridSubsystem->QueryCapsule(Start, End, CatchRadius + QueryMargin, Candidates, this);
+		SpatialGridSubsystem->RecordCatchPreselection(Candidates.Num() == 0);
+		if (Candidates.Num() == 0)
 		{
-			GetCharacterMovement()->GravityScale = 2.0f;
-			break;
-		}
-		case EPlayerCharacterState::Caught:
-		{
-			GetCharacterMovement()->GravityScale = 0.0f;
-			break;
+			return false;
 		}
 	}
+
+	// 입력한 프레임에 예측과 요청을 보내야 하므로 동기로 실행합니다.
+	USMTraceSubsystem* TraceSubsystem = GetWorld()->GetSubsystem<USMTraceSubsystem>();
+	if (TraceSubsystem)
+	{
+		return TraceSubsystem->TraceSync(OutHitResult, Start, End, FCollisionShape::MakeSphere(CatchRadius), CollisionObjectQueryParams, CollisionQueryParams);
+	}
+
+	return GetWorld()->SweepSingleByObjectType(OutHitResult, Start, End, FQuat::Identity, CollisionObjectQueryParams, FCollisionShape::MakeSphere(CatchRadius), CollisionQueryParams);
+}
+
+bool ASMPlayerCharacter::ValidateCatch(const ASMPlayerCharacter* InTargetCharacter, float InClientTimeStamp, uint16 InCompressedYaw) const
+{
+	// 클라이언트가 보낸 시간은 신뢰할 수 없기 때문에 되감을 수 있는 범위로 제한합니다.
+	const float ServerTime = GetServerWorldTime();
+	const float RewindTime = FMath::Clamp(InClientTimeStamp, ServerTime - MaxCatchRewindTime, ServerTime);
+
+	FVector TargetLocation;
+	if (!InTargetCharacter->PositionHistory.Sample(RewindTime, TargetLocation))
+	{
+		TargetLocation = InTargetCharacter->GetActorLocation();
+	}
+
+	// 시전자는 자신의 이동을 직접 예측하기 때문에 서버의 현재 위치가 클라이언트가 판정한 위치와 가장 가깝습니다.
+	const FVector Start = GetActorLocation();
+	const FVector Forward = FRotator(0.0, FRotator::DecompressAxisFromShort(InCompressedYaw), 0.0).Vector();
+	const FVector End = Start + (Forward * CatchDistance);
+
+	// 구체 스윕과 캡슐의 충돌은 스윕 선분과 캡슐 중심축 선분의 거리로 해석적으로 판정할 수 있습니다.
+	const UCapsuleComponent* TargetCapsule = InTargetCharacter->GetCapsuleComponent();
+	const float TargetRadius = TargetCapsule->GetScaledCapsuleRadius();
+	const FVector TargetAxisExtent(0.0, 0.0, TargetCapsule->GetScaledCapsuleHalfHeight_WithoutHemisphere());
+
+	FVector ClosestOnSweep;
+	FVector ClosestOnTarget;
+	FMath::SegmentDistToSegmentSafe(Start, End, TargetLocation - TargetAxisExtent, TargetLocation + TargetAxisExtent, ClosestOnSweep, ClosestOnTarget);
+
+	const float AcceptDistance = CatchRadius + TargetRadius + CatchValidationTolerance;
+	return FVector::DistSquared(ClosestOnSweep, ClosestOnTarget) <= FMath::Square(AcceptDistance);
 }
 
-void ASMPlayerCharacter::OnRep_bEnableCollision()
+float ASMPlayerCharacter::GetServerWorldTime() const
 {
-	SetActorEnableCollision(bEnableCollision);
+	const AGameStateBase* GameState = GetWorld()->GetGameState();
+	return GameState ? GameState->GetServerWorldTimeSeconds() : GetWorld()->GetTimeSeconds();
 }
 
-void ASMPlayerCharacter::ServerRPCPerformPull_Implementation(ASMPlayerCharacter* InTargetCharacter)
+void ASMPlayerCharacter::ServerRPCPerformPull_Implementation(ASMPlayerCharacter* InTargetCharacter, float InClientTimeStamp, uint16 InCompressedYaw, uint16 InPredictionKey)
 {
-	NET_LOG(LogSMNetwork, Log, TEXT("당기기 시작"));
+	if (StoredSMPlayerController)
+	{
+		// 대상 캐릭터는 NetGUID로 직렬화되기 때문에 대략 uint32 크기로 계산합니다.
+		StoredSMPlayerController->RecordCatchReceived(sizeof(uint32) + sizeof(InClientTimeStamp) + sizeof(InCompressedYaw) + sizeof(InPredictionKey));
+	}
 
-	// 클라이언트 제어권 박탈 및 충돌 판정 비활성화
-	InTargetCharacter->SetCanControl(false);
-	InTargetCharacter->OnRep_bCanControl();
+	USMNetAccountingSubsystem* NetAccountingSubsystem = GetNetAccountingSubsystem(GetWorld());
+	if (NetAccountingSubsystem)
+	{
+		NetAccountingSubsystem->Record(GetNetConnection(), ESMNetAccount::ServerRPCPerformPull, ESMNetDirection::In, PerformPullAccountBits);
+	}
 
-	InTargetCharacter->SetAutonomousProxy(false);
+	if (!IsLocallyControlled() && CatchReceiveTime == 0.0)
+	{
+		CatchReceiveTime = FPlatformTime::Seconds();
+	}
+
+	if (!InTargetCharacter || InTargetCharacter == this || InTargetCharacter->ReplicatedState.State != EPlayerCharacterState::Normal)
+	{
+		SM_EVENT(CatchRejected, InTargetCharacter ? InTargetCharacter->GetUniqueID() : 0, 0.0f);
+		SetCatchPredictionAck(InPredictionKey, false);
+		return;
+	}
+
+	if (!ValidateCatch(InTargetCharacter, InClientTimeStamp, InCompressedYaw))
+	{
+		SM_EVENT(CatchRejected, InTargetCharacter->GetUniqueID(), 1.0f);
+		SetCatchPredictionAck(InPredictionKey, false);
+		return;
+	}
 
-	InTargetCharacter->SetEnableCollision(false);
-	InTargetCharacter->OnRep_bEnableCollision();
+	SM_EVENT(PullStart, InTargetCharacter->GetUniqueID());
+	SetCatchPredictionAck(InPredictionKey, true);
 
-	InTargetCharacter->CurrentState = EPlayerCharacterState::Caught;
-	InTargetCharacter->OnRep_CurrentState();
+	if (StoredSMPlayerController)
+	{
+		StoredSMPlayerController->RecordCatchAccepted();
+	}
 
-	// 당기기에 필요한 데이터 할당
-	InTargetCharacter->PullData.bIsPulling = true;
-	InTargetCharacter->PullData.ElapsedTime = 0.0f;
-	InTargetCharacter->PullData.Caster = this;
-	InTargetCharacter->PullData.StartLocation = InTargetCharacter->GetActorLocation();
+	// 잡기 응답이 시전자에게 바로 전송되도록 합니다. 대상은 SetReplicatedState에서 처리됩니다.
+	USMNetUpdateSubsystem* NetUpdateSubsystem = GetWorld()->GetSubsystem<USMNetUpdateSubsystem>();
+	if (NetUpdateSubsystem)
+	{
+		NetUpdateSubsystem->NotifyStateChanged(this);
+	}
+
+	// 클라이언트 제어권 박탈 및 충돌 판정 비활성화
+	InTargetCharacter->SetAutonomousProxy(false);
+	InTargetCharacter->bHasServerTargetYaw = false;
+
+	FSMCharacterReplicatedState CaughtState;
+	CaughtState.State = EPlayerCharacterState::Caught;
+	CaughtState.bEnableCollision = false;
+	CaughtState.bCanControl = false;
+	InTargetCharacter->SetReplicatedState(CaughtState);
+
+	// 당기기는 서브시스템에서 모든 당기기와 함께 일괄 처리됩니다.
+	USMPullSubsystem* PullSubsystem = GetWorld()->GetSubsystem<USMPullSubsystem>();
+	if (PullSubsystem)
+	{
+		PullSubsystem->StartPull(InTargetCharacter, this, PullTotalTime);
+	}
 }
 
-void ASMPlayerCharacter::UpdatePerformPull(float DeltaSeconds)
+void ASMPlayerCharacter::HandlePullEnd(ASMPlayerCharacter* InCaster)
 {
 	if (HasAuthority())
 	{
-		// 시전자로부터 자신을 향한 방향
-		FVector CasterVector = GetActorLocation() - PullData.Caster->GetActorLocation();
-		CasterVector.Z = 0.0;
-		const FVector CasterDirection = CasterVector.GetSafeNormal();
+		SM_EVENT(PullEnd, InCaster ? InCaster->GetUniqueID() : 0);
+
+		SetAttachedCaster(InCaster);
+		if (StoredSMPlayerController)
+		{
+			StoredSMPlayerController->SetViewTargetWithBlend(InCaster, 0.1f);
+		}
+	}
+	else if (InCaster && InCaster->IsLocallyControlled())
+	{
+		// 예측한 당기기가 끝났다면 시전자 클라이언트는 서버의 어태치를 기다리지 않고 먼저 어태치합니다.
+		AttachToCaster(InCaster);
+	}
+}
 
-		// 캡슐 반지름을 통해 EndLocation이 시전자의 위치와 겹치지 않도록 오프셋 지정
-		const float CapsuleRadius = GetCapsuleComponent()->GetScaledCapsuleRadius();
-		PullData.EndLocation = PullData.Caster->GetActorLocation() + (CasterDirection * CapsuleRadius * 2);
+void ASMPlayerCharacter::SetAttachedCaster(ASMPlayerCharacter* InCaster)
+{
+	if (AttachedCaster == InCaster)
+	{
+		return;
+	}
 
-		// 선형 보간
-		PullData.ElapsedTime += DeltaSeconds;
-		const float Alpha = FMath::Clamp(PullData.ElapsedTime / PullData.TotalTime, 0.0f, 1.0f);
-		const FVector NewLocation = FMath::Lerp(PullData.StartLocation, PullData.EndLocation, Alpha);
-		SetActorLocation(NewLocation);
+	AttachedCaster = InCaster;
+	MARK_PROPERTY_DIRTY_FROM_NAME(ASMPlayerCharacter, AttachedCaster, this);
 
-		// 디버거
-		DrawDebugLine(GetWorld(), PullData.StartLocation, PullData.EndLocation, FColor::Cyan, false, 0.1f);
+	USMNetAccountingSubsystem* NetAccountingSubsystem = GetNetAccountingSubsystem(GetWorld());
+	if (NetAccountingSubsystem)
+	{
+		NetAccountingSubsystem->RecordToRelevantConnections(this, ESMNetAccount::AttachedCaster, AttachedCasterAccountBits);
+	}
 
-		if (Alpha >= 1.0f)
+	OnRep_AttachedCaster();
+
+	USMNetUpdateSubsystem* NetUpdateSubsystem = GetWorld()->GetSubsystem<USMNetUpdateSubsystem>();
+	if (NetUpdateSubsystem)
+	{
+		NetUpdateSubsystem->NotifyStateChanged(this);
+	}
+}
+
+void ASMPlayerCharacter::OnRep_AttachedCaster()
+{
+	SM_SCOPE_CYCLE_COUNTER(OnRepAttachedCaster);
+
+	USMNetAccountingSubsystem* NetAccountingSubsystem = !HasAuthority() ? GetNetAccountingSubsystem(GetWorld()) : nullptr;
+	if (NetAccountingSubsystem)
+	{
+		NetAccountingSubsystem->RecordFromServer(ESMNetAccount::AttachedCaster, AttachedCasterAccountBits);
+	}
+
+	GetWorldTimerManager().ClearTimer(AttachedCasterTimerHandle);
+
+	// 보간 중인 화면의 위치는 수신한 위치보다 늦으므로 바로 어태치하면 당기기의 끝이 잘려 보입니다.
+	const USMCharacterMovementComponent* SMCharacterMovement = Cast<USMCharacterMovementComponent>(GetCharacterMovement());
+	const double InterpolationDelay = SMCharacterMovement ? SMCharacterMovement->GetSnapshotInterpolationDelay() : 0.0;
+	if (AttachedCaster && InterpolationDelay > 0.0)
+	{
+		GetWorldTimerManager().SetTimer(AttachedCasterTimerHandle, this, &ASMPlayerCharacter::ApplyAttachedCaster, InterpolationDelay, false);
+		return;
+	}
+
+	ApplyAttachedCaster();
+}
+
+void ASMPlayerCharacter::OnRep_AttachmentReplication()
+{
+	// 어태치라면 복제된 부모, 분리라면 현재 부모를 확인합니다. 시전자가 아닌 액터에 대한 어태치와 분리는 엔진이 그대로 적용합니다.
+	const AActor* ReplicatedAttachParent = GetAttachmentReplication().AttachParent;
+	const AActor* AttachParent = ReplicatedAttachParent ? ReplicatedAttachParent : GetAttachParentActor();
+	if (!AttachParent || AttachParent->IsA<ASMPlayerCharacter>())
+	{
+		return;
+	}
+
+	Super::OnRep_AttachmentReplication();
+}
+
+void ASMPlayerCharacter::ApplyAttachedCaster()
+{
+	// 예측으로 먼저 어태치했거나 관련성을 다시 얻어 같은 값을 다시 받을 수 있으므로 현재 어태치 상태와 비교해 적용합니다.
+	AActor* AttachParent = GetAttachParentActor();
+	if (AttachedCaster)
+	{
+		if (AttachParent != AttachedCaster)
 		{
-			HandlePullEnd();
+			SM_EVENT(AttachStart, AttachedCaster->GetUniqueID());
+			AttachToCaster(AttachedCaster);
 		}
 	}
+	else if (AttachParent)
+	{
+		DetachFromActor(FDetachmentTransformRules::KeepWorldTransform);
+		MarkSpatialGridDirty();
+	}
 }
 
-void ASMPlayerCharacter::HandlePullEnd()
+void ASMPlayerCharacter::AttachToCaster(ASMPlayerCharacter* InCaster)
 {
-	if (HasAuthority())
+	const FVector PreviousLocation = GetActorLocation();
+
+	const FAttachmentTransformRules AttachmentTransformRules(EAttachmentRule::SnapToTarget, false);
+	AttachToComponent(InCaster->GetMesh(), AttachmentTransformRules, TEXT("HoldSocket"));
+
+	USMPullSubsystem* PullSubsystem = GetWorld()->GetSubsystem<USMPullSubsystem>();
+	if (PullSubsystem)
 	{
-		NET_LOG(LogSMNetwork, Log, TEXT("당기기 종료"))
+		PullSubsystem->RecordPullEndError(FVector::Dist(PreviousLocation, GetActorLocation()));
+	}
+}
 
-		PullData.bIsPulling = false;
-		MulticastRPCAttachToCaster(PullData.Caster, this);
-		StoredSMPlayerController->SetViewTargetWithBlend(PullData.Caster, 0.1f);
+uint16 ASMPlayerCharacter::PredictCatch(ASMPlayerCharacter* InTargetCharacter)
+{
+	// 이미 잡힌 대상은 서버가 거부할 것이므로 예측하지 않습니다.
+	USMPullSubsystem* PullSubsystem = GetWorld()->GetSubsystem<USMPullSubsystem>();
+	if (!PullSubsystem || InTargetCharacter->ReplicatedState.State != EPlayerCharacterState::Normal)
+	{
+		return 0;
 	}
+
+	// 0은 예측하지 않은 요청을 의미하므로 건너뜁니다.
+	LastCatchPredictionKey = LastCatchPredictionKey == MAX_uint16 ? 1 : LastCatchPredictionKey + 1;
+	PendingCatchPredictionKey = LastCatchPredictionKey;
+	PendingCatchPredictionTime = GetWorld()->GetTimeSeconds();
+	PredictedCatchTarget = InTargetCharacter;
+
+	SM_EVENT(CatchPredicted, InTargetCharacter->GetUniqueID(), PendingCatchPredictionKey);
+
+	// 서버와 같은 당기기를 로컬에서 실행합니다. 끝나면 HandlePullEnd에서 로컬로 어태치합니다.
+	InTargetCharacter->SetActorEnableCollision(false);
+	InTargetCharacter->MarkSpatialGridDirty();
+	PullSubsystem->StartPull(InTargetCharacter, this, PullTotalTime);
+
+	return PendingCatchPredictionKey;
 }
 
-void ASMPlayerCharacter::MulticastRPCAttachToCaster_Implementation(AActor* InCaster, AActor* InTarget)
+void ASMPlayerCharacter::RollbackCatchPrediction(bool bInTimedOut)
 {
-	NET_LOG(LogSMNetwork, Log, TEXT("어태치 시작"))
+	SM_EVENT(CatchRolledBack, PendingCatchPredictionKey, bInTimedOut ? 1.0f : 0.0f);
+
+	ASMPlayerCharacter* Target = PredictedCatchTarget.Get();
+	PendingCatchPredictionKey = 0;
+	PredictedCatchTarget = nullptr;
+	PendingCatchInputTime = 0.0;
+	PendingCatchSendTime = 0.0;
+	if (!Target)
+	{
+		return;
+	}
 
-	const FAttachmentTransformRules AttachmentTransformRules(EAttachmentRule::SnapToTarget, false);
-	const ASMPlayerCharacter* SMPlayerCharacter = Cast<ASMPlayerCharacter>(InCaster);
-	if (SMPlayerCharacter)
+	USMPullSubsystem* PullSubsystem = GetWorld()->GetSubsystem<USMPullSubsystem>();
+	if (PullSubsystem)
+	{
+		PullSubsystem->CancelPull(Target);
+	}
+
+	if (Target->GetAttachParentActor() == this)
+	{
+		Target->DetachFromActor(FDetachmentTransformRules::KeepWorldTransform);
+	}
+
+	Target->SetActorEnableCollision(Target->ReplicatedState.bEnableCollision != 0);
+	Target->MarkSpatialGridDirty();
+
+	// 당기는 동안 스냅샷 버퍼가 비워졌으므로 현재 화면의 위치를 먼저 넣어 서버 위치로 순간이동하지 않고 보간하게 합니다.
+	USMCharacterMovementComponent* TargetMovement = Cast<USMCharacterMovementComponent>(Target->GetCharacterMovement());
+	if (TargetMovement && TargetMovement->ShouldUseSnapshotInterpolation())
+	{
+		TargetMovement->SeedSnapshotFromCurrentTransform();
+	}
+
+	// 마지막으로 수신한 서버 위치를 다시 적용합니다.
+	Target->ReapplyReplicatedMovement();
+}
+
+void ASMPlayerCharacter::SetCatchPredictionAck(uint16 InPredictionKey, bool bInAccepted)
+{
+	if (InPredictionKey == 0)
+	{
+		return;
+	}
+
+	CatchPredictionAck.PredictionKey = InPredictionKey;
+	CatchPredictionAck.bAccepted = bInAccepted;
+	MARK_PROPERTY_DIRTY_FROM_NAME(ASMPlayerCharacter, CatchPredictionAck, this);
+
+	USMNetAccountingSubsystem* NetAccountingSubsystem = GetNetAccountingSubsystem(GetWorld());
+	if (NetAccountingSubsystem)
+	{
+		NetAccountingSubsystem->Record(GetNetConnection(), ESMNetAccount::CatchPredictionAck, ESMNetDirection::Out, CatchPredictionAckAccountBits);
+	}
+}
+
+void ASMPlayerCharacter::OnRep_CatchPredictionAck()
+{
+	SM_SCOPE_CYCLE_COUNTER(OnRepCatchPredictionAck);
+
+	USMNetAccountingSubsystem* NetAccountingSubsystem = GetNetAccountingSubsystem(GetWorld());
+	if (NetAccountingSubsystem)
+	{
+		NetAccountingSubsystem->RecordFromServer(ESMNetAccount::CatchPredictionAck, CatchPredictionAckAccountBits);
+	}
+
+	// 시간 초과로 이미 되돌린 예측의 응답은 무시합니다. 서버가 수락했다면 서버의 어태치가 그대로 복제됩니다.
+	if (PendingCatchPredictionKey == 0 || CatchPredictionAck.PredictionKey != PendingCatchPredictionKey)
+	{
+		return;
+	}
+
+	if (PendingCatchSendTime > 0.0)
+	{
+		const double CurrentTime = FPlatformTime::Seconds();
+		RecordLatencySample(GetWorld(), ESMLatencyAction::Hold, ESMLatencyStage::RoundTrip, CurrentTime - PendingCatchSendTime);
+		RecordLatencySample(GetWorld(), ESMLatencyAction::Hold, ESMLatencyStage::Total, CurrentTime - PendingCatchInputTime);
+		PendingCatchInputTime = 0.0;
+		PendingCatchSendTime = 0.0;
+	}
+
+	if (CatchPredictionAck.bAccepted)
 	{
-		InTarget->AttachToComponent(SMPlayerCharacter->GetMesh(), AttachmentTransformRules, TEXT("HoldSocket"));
+		SM_EVENT(CatchConfirmed, PendingCatchPredictionKey);
+		PendingCatchPredictionKey = 0;
+		PredictedCatchTarget = nullptr;
+	}
+	else
+	{
+		RollbackCatchPrediction(false);
+	}
+}
+
+void ASMPlayerCharacter::OnRep_ReplicatedMovement()
+{
+	SM_SCOPE_CYCLE_COUNTER(OnRepReplicatedMovement);
+
+	Super::OnRep_ReplicatedMovement();
+
+	USMNetAccountingSubsystem* NetAccountingSubsystem = GetNetAccountingSubsystem(GetWorld());
+	if (NetAccountingSubsystem)
+	{
+		NetAccountingSubsystem->RecordFromServer(ESMNetAccount::ReplicatedMovement, USMNetAccountingSubsystem::PropertyHeaderBits + USMNetAccountingSubsystem::GetMovementBits(this));
+	}
+}
+
+void ASMPlayerCharacter::ReapplyReplicatedMovement()
+{
+	Super::OnRep_ReplicatedMovement();
+}
+
+void ASMPlayerCharacter::PostNetReceiveLocationAndRotation()
+{
+	USMCharacterMovementComponent* SMCharacterMovement = Cast<USMCharacterMovementComponent>(GetCharacterMovement());
+	if (!SMCharacterMovement || !SMCharacterMovement->ShouldUseSnapshotInterpolation())
+	{
+		Super::PostNetReceiveLocationAndRotation();
+		return;
+	}
+
+	const FRepMovement& LocalRepMovement = GetReplicatedMovement();
+	const FVector NewLocation = FRepMovement::RebaseOntoLocalOrigin(LocalRepMovement.Location, this);
+	SMCharacterMovement->AddSnapshot(NewLocation, LocalRepMovement.Rotation.Quaternion(), LocalRepMovement.LinearVelocity, GetReplicatedMovementMode());
+}
+
+void ASMPlayerCharacter::PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker)
+{
+	Super::PreReplication(ChangedPropertyTracker);
+
+	USMNetUpdateSubsystem* NetUpdateSubsystem = GetWorld()->GetSubsystem<USMNetUpdateSubsystem>();
+	if (NetUpdateSubsystem)
+	{
+		NetUpdateSubsystem->RecordActorUpdate();
+	}
+
+	if (CatchReceiveTime > 0.0)
+	{
+		RecordLatencySample(GetWorld(), ESMLatencyAction::Hold, ESMLatencyStage::ServerProcess, FPlatformTime::Seconds() - CatchReceiveTime);
+		CatchReceiveTime = 0.0;
 	}
 }
+
+void ASMPlayerCharacter::RecordLatencySample(const UWorld* InWorld, ESMLatencyAction InAction, ESMLatencyStage InStage, double InSeconds)
+{
+	USMLatencySubsystem* LatencySubsystem = USMLatencySubsystem::IsEnabled() && InWorld ? InWorld->GetSubsystem<USMLatencySubsystem>() : nullptr;
+	if (LatencySubsystem)
+	{
+		LatencySubsystem->RecordSample(InAction, InStage, InSeconds);
+	}
+}
+
+#if !UE_BUILD_SHIPPING
+/**
+ * 플레이어 밀도에 따른 잡기 스윕 비용을 측정합니다. 같은 넓이의 영역에 캐릭터 수를 바꿔가며 배치하고 모든 캐릭터가 스윕합니다.
+ * 사용법: SM.Bench.Catch [캐릭터당 반복 횟수]
+ */
+static FAutoConsoleCommandWithWorldAndArgs SMBenchCatchCommand(
+	TEXT("SM.Bench.Catch"),
+	TEXT("3000x3000 영역에 8, 32, 128명의 임시 캐릭터를 배치하고 잡기 스윕 비용을 측정합니다. 인자: 캐릭터당 반복 횟수(기본 100)"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (!World || World->GetNetMode() == NM_Client)
+		{
+			UE_LOG(LogSMPlayerCharacter, Warning, TEXT("[SM.Bench.Catch] 서버 게임 월드에서만 실행할 수 있습니다."));
+			return;
+		}
+
+		const int32 Iterations = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 100;
+		const int32 PlayerCounts[] = { 8, 32, 128 };
+		const double AreaSize = 3000.0;
+
+		UClass* CharacterClass = SMBench::GetCharacterClass(World);
+
+		FRandomStream RandomStream(1234);
+		for (const int32 NumPlayers : PlayerCounts)
+		{
+			TArray<ASMPlayerCharacter*> SpawnedCharacters;
+			SMBench::SpawnRandomCharacters(World, CharacterClass, NumPlayers, AreaSize, RandomStream, SpawnedCharacters);
+
+			// 잡기 후보 선별이 이번 프레임에 스폰한 캐릭터를 찾을 수 있도록 격자를 다시 만듭니다.
+			USMSpatialGridSubsystem* SpatialGridSubsystem = World->GetSubsystem<USMSpatialGridSubsystem>();
+			if (SpatialGridSubsystem)
+			{
+				SpatialGridSubsystem->Rebuild();
+			}
+
+			int32 NumHits = 0;
+			FHitResult HitResult;
+			const double StartTime = FPlatformTime::Seconds();
+			for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+			{
+				for (const ASMPlayerCharacter* Character : SpawnedCharacters)
+				{
+					NumHits += Character->SweepCatch(HitResult) ? 1 : 0;
+				}
+			}
+			const double ElapsedTime = FPlatformTime::Seconds() - StartTime;
+			const int32 NumSweeps = FMath::Max(1, SpawnedCharacters.Num() * Iterations);
+
+			UE_LOG(LogSMPlayerCharacter, Log, TEXT("[SM.Bench.Catch] 캐릭터 %d명, 스윕 %d회 - %.3fus/회, 적중 %.1f%%"),
+				SpawnedCharacters.Num(), NumSweeps, ElapsedTime * 1e6 / NumSweeps, 100.0 * NumHits / NumSweeps);
+			SM_PERF_METRIC(TEXT("catch.sweepUs.players%d"), ElapsedTime * 1e6 / NumSweeps, NumPlayers);
+
+			SMBench::DestroyCharacters(SpawnedCharacters);
+		}
+	}));
+#endif
@@ -4,9 +4,11 @@
 
 #include "CoreMinimal.h"
 #include "Character/SMCharacterBase.h"
+#include "Character/SMPositionHistory.h"
+#include "Subsystem/SMLatencySubsystem.h"
+#include "Subsystem/SMTraceSubsystem.h"
 #include "SMPlayerCharacter.generated.h"
 
-class AAimPlane;
 class ASMPlayerController;
 class USpringArmComponent;
 class UCameraComponent;
@@ -21,6 +23,57 @@ enum class EPlayerCharacterState : uint8
 	Caught
 };
 
+/**
+ * 잡기 이벤트에서만 바뀌는 캐릭터 상태를 하나로 묶어 복제합니다.
+ * 커스텀 NetSerialize로 4비트만 전송하며, 푸시 모델로 변경 시에만 비교 대상이 됩니다.
+ */
+USTRUCT()
+struct FSMCharacterReplicatedState
+{
+	GENERATED_BODY()
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+
+	bool operator==(const FSMCharacterReplicatedState& Other) const
+	{
+		return State == Other.State && bEnableCollision == Other.bEnableCollision && bCanControl == Other.bCanControl;
+	}
+
+	bool operator!=(const FSMCharacterReplicatedState& Other) const { return !(*this == Other); }
+
+	/** 상태 전송에 사용하는 비트 수입니다. EPlayerCharacterState는 최대 4개까지 표현할 수 있습니다. */
+	static constexpr uint32 StateBits = 2;
+
+	EPlayerCharacterState State = EPlayerCharacterState::Normal;
+
+	uint32 bEnableCollision = true;
+
+	uint32 bCanControl = true;
+};
+
+template<>
+struct TStructOpsTypeTraits<FSMCharacterReplicatedState> : public TStructOpsTypeTraitsBase2<FSMCharacterReplicatedState>
+{
+	enum
+	{
+		WithNetSerializer = true,
+		WithIdenticalViaEquality = true
+	};
+};
+
+/** 서버가 예측된 잡기를 처리한 결과입니다. */
+USTRUCT()
+struct FSMCatchPredictionAck
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	uint16 PredictionKey = 0;
+
+	UPROPERTY()
+	bool bAccepted = false;
+};
+
 /**
  * 
  */
@@ -30,18 +83,25 @@ class STEREOMIXPROTOTYPE_API ASMPlayerCharacter : public ASMCharacterBase
 	GENERATED_BODY()
 
 public:
-	ASMPlayerCharacter();
+	ASMPlayerCharacter(const FObjectInitializer& ObjectInitializer);
 
 public:
 	virtual void PossessedBy(AController* NewController) override;
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:
 	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
 	virtual void Tick(float DeltaSeconds) override;
 
+protected:
+	virtual void OnAssetDataLoaded() override;
+
+	/** 입력 액션을 바인딩합니다. 에셋 데이터가 입력 컴포넌트보다 늦게 준비되면 OnAssetDataLoaded에서 호출됩니다. */
+	void BindInputActions(UInputComponent* PlayerInputComponent);
+
 public:
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 	virtual void OnRep_Controller() override;
@@ -69,44 +129,73 @@ protected: // Move Section
 	/** GetMousePointingDirection()를 통해 얻어낸 방향으로 캐릭터를 회전시킵니다. */
 	void UpdateRotateToMousePointer();
 
-	/** 캐릭터가 회전된 Yaw값을 서버에서 적용합니다. */
+	/** 캐릭터가 회전된 Yaw값을 서버에서 적용합니다. Yaw는 16비트로 양자화되어 전송됩니다. */
 	UFUNCTION(Server, Unreliable)
-	void ServerRotateToMousePointer(float InYaw);
+	void ServerRotateToMousePointer(uint16 InCompressedYaw);
 
-public: // State Section
-	void SetEnableCollision(bool bInEnableCollision) { bEnableCollision = bInEnableCollision; }
+protected: // Yaw Sync Section
+	/** 전송 주기와 데드밴드를 검사해 필요한 경우에만 Yaw를 서버로 전송합니다. */
+	void UpdateYawSync(float InYaw);
 
-protected:
-	UFUNCTION()
-	void OnRep_CurrentState();
+	/** 서버에서 마지막으로 수신한 Yaw를 향해 부드럽게 회전시킵니다. */
+	void UpdateServerYawSmoothing(float DeltaSeconds);
 
-	UFUNCTION()
-	void OnRep_bEnableCollision();
+	/** Yaw 전송 최소 간격입니다. 클라이언트 프레임레이트와 무관하게 초당 전송 횟수를 제한합니다. */
+	const float YawSyncSendInterval = 1.0f / 30.0f;
+
+	/** 양자화된 Yaw 단위의 데드밴드입니다. 약 1도 미만의 변화는 즉시 전송하지 않습니다. */
+	const int32 YawSyncDeadBand = 182;
 
-	UPROPERTY(ReplicatedUsing = OnRep_CurrentState)
-	EPlayerCharacterState CurrentState;
+	/** 데드밴드 이하의 변화라도 이 시간이 지나면 전송해 서버와의 오차가 남지 않게 합니다. */
+	const float YawSyncSettleTime = 0.2f;
 
-	UPROPERTY(ReplicatedUsing = OnRep_bEnableCollision)
-	uint32 bEnableCollision:1;
+	/** 서버에서 수신한 Yaw로 보간하는 속도입니다. */
+	const float YawSyncInterpSpeed = 30.0f;
 
-public: // Control Section
-	void SetCanControl(bool bInEnableControl) { bCanControl = bInEnableControl; }
+	float LastYawSyncSendTime = 0.0f;
+
+	uint16 LastSentCompressedYaw = 0;
+
+	float ServerTargetYaw = 0.0f;
+
+	uint32 bHasServerTargetYaw:1;
+
+public: // State Section
+	const FSMCharacterReplicatedState& GetReplicatedState() const { return ReplicatedState; }
+
+	/** 서버에서 상태를 변경합니다. 푸시 모델 더티 마킹 후 서버에도 같은 변경을 즉시 적용합니다. */
+	void SetReplicatedState(const FSMCharacterReplicatedState& InReplicatedState);
 
 protected:
+	/** 콜리전, 입력, 중력 변경을 한 번에 적용합니다. 이전 상태와 달라진 항목만 처리합니다. */
 	UFUNCTION()
-	void OnRep_bCanControl();
+	void OnRep_ReplicatedState(const FSMCharacterReplicatedState& InPreviousState);
 
-	UPROPERTY()
-	TObjectPtr<ASMPlayerController> StoredSMPlayerController;
+	UPROPERTY(ReplicatedUsing = OnRep_ReplicatedState)
+	FSMCharacterReplicatedState ReplicatedState;
+
+public: // Pool Section
+	/**
+	 * 서버에서 풀에 반환될 때 호출됩니다. 당기기, 어태치, 잡기 예측, 위치 기록과 상태를 초기화하고 캐릭터를 숨깁니다.
+	 * 풀에 있는 동안은 콜리전과 조작이 꺼진 상태가 한 번 복제된 뒤 휴면(Dormant) 상태가 되어 더 이상 복제되지 않습니다.
+	 */
+	void ResetForReuse();
 
-	UPROPERTY(ReplicatedUsing = OnRep_bCanControl)
-	uint32 bCanControl:1;
+	/** 서버에서 풀에서 꺼내질 때 호출됩니다. 지정한 위치로 이동한 뒤 기본 상태로 다시 활성화합니다. */
+	void ActivateFromPool(const FTransform& InSpawnTransform);
 
-protected: // Aim Section
+	/** 서버에서 월드 밖으로 떨어지면 파괴하지 않고 게임 모드의 풀에 반환한 뒤 리스폰합니다. */
+	virtual void FellOutOfWorld(const UDamageType& DmgType) override;
+
+protected: // Control Section
 	UPROPERTY()
-	TObjectPtr<AAimPlane> AimPlane;
+	TObjectPtr<ASMPlayerController> StoredSMPlayerController;
 
-protected: // Jump Section
+public: // Jump Section
+	/** 점프 입력의 지연 시간 측정을 시작합니다. */
+	virtual void Jump() override;
+
+protected:
 	virtual void OnJumped_Implementation() override;
 
 	virtual void Landed(const FHitResult& Hit) override;
@@ -115,32 +204,160 @@ protected: // Stat Section
 	const float MoveSpeed = 700.0f;
 
 protected: // Util Section
+	/**
+	 * 바닥까지의 높이이며 바닥이 없으면 0입니다. 정적 바닥 위에서는 높이 필드로 바로 구합니다.
+	 * 그 밖에서는 매 프레임 호출하면 지난 프레임에 요청한 비동기 트레이스의 값이므로 한 프레임 늦습니다.
+	 * 처음 호출하거나 USMTraceSubsystem::ResultLifetimeFrames보다 오래 호출하지 않았다면 동기로 트레이스해 현재 값을 반환합니다.
+	 */
 	float DistanceHeightFromFloor();
 
-protected: // Hold Section
-	struct FPullData
-	{
-		AActor* Caster;
-		FVector StartLocation;
-		FVector EndLocation;
-		uint32 bIsPulling = false;
-		float ElapsedTime = 0.0f;
-		float TotalTime = 0.1f;
-	};
+	FSMTraceHandle FloorTraceHandle;
+
+	/** 충돌, 표시 여부, 어태치가 바뀌었음을 USMSpatialGridSubsystem에 알려 다음 쿼리 전에 격자를 다시 만들게 합니다. */
+	void MarkSpatialGridDirty();
+
+	FVector FloorTraceStart = FVector::ZeroVector;
+
+	uint64 FloorTraceFrame = 0;
+
+	float HeightFromFloor = 0.0f;
+
+	/** HeightFromFloor를 구한 위치의 프레임입니다. 0이면 아직 구하지 않았습니다. */
+	uint64 HeightFromFloorFrame = 0;
+
+public: // Hold Section
+	/** 당기기가 끝났을 때 서브시스템에 의해 호출됩니다. 시전자에게 어태치하고 시점을 시전자로 전환합니다. 예측한 당기기라면 로컬에서만 어태치합니다. */
+	void HandlePullEnd(ASMPlayerCharacter* InCaster);
+
+	/** 캐릭터 전방으로 잡기 스윕을 실행합니다. */
+	bool SweepCatch(FHitResult& OutHitResult) const;
+
+	float GetPullTotalTime() const { return PullTotalTime; }
 
+	float GetCatchDistance() const { return CatchDistance; }
+
+	float GetCatchRadius() const { return CatchRadius; }
+
+protected:
 	void Catch();
 
 	void HandleCatch();
 
+	/**
+	 * 클라이언트가 잡기에 성공했을 때 호출됩니다. 서버는 클라이언트 시간으로 되감아 판정을 검증한 뒤 당기기를 시작합니다.
+	 * 클라이언트가 잡기를 예측했다면 InPredictionKey로 결과를 알려줍니다. 0이면 예측하지 않은 요청입니다.
+	 */
 	UFUNCTION(Server, Reliable)
-	void ServerRPCPerformPull(ASMPlayerCharacter* InTargetCharacter);
+	void ServerRPCPerformPull(ASMPlayerCharacter* InTargetCharacter, float InClientTimeStamp, uint16 InCompressedYaw, uint16 InPredictionKey);
+
+	/** 대상의 위치 기록을 클라이언트 시간으로 되감아 잡기 스윕을 다시 판정합니다. */
+	bool ValidateCatch(const ASMPlayerCharacter* InTargetCharacter, float InClientTimeStamp, uint16 InCompressedYaw) const;
+
+	/** 서버에서 이 캐릭터가 어태치될 시전자를 설정합니다. 푸시 모델 더티 마킹 후 서버에도 즉시 적용합니다. nullptr이면 분리합니다. */
+	void SetAttachedCaster(ASMPlayerCharacter* InCaster);
+
+	/**
+	 * 어태치 상태를 복제받았을 때 호출됩니다.
+	 * 스냅샷 보간 중인 클라이언트에서는 화면의 당기기가 끝나는 시점에 맞추기 위해 보간 지연만큼 어태치를 늦춥니다.
+	 */
+	UFUNCTION()
+	void OnRep_AttachedCaster();
+
+	/**
+	 * 시전자에 대한 어태치와 분리는 엔진의 어태치 복제로 적용하지 않습니다.
+	 * 업데이트를 받는 즉시 어태치되어 보간 중인 위치보다 먼저 시전자에게 붙으므로 OnRep_AttachedCaster의 타이밍만 사용합니다.
+	 */
+	virtual void OnRep_AttachmentReplication() override;
+
+	/** 어태치 상태를 적용합니다. 이미 같은 상태라면 아무것도 하지 않습니다. */
+	void ApplyAttachedCaster();
+
+	void AttachToCaster(ASMPlayerCharacter* InCaster);
+
+	/** 이 캐릭터를 잡아 어태치한 시전자입니다. 프로퍼티로 복제되므로 늦게 접속하거나 관련성을 다시 얻은 클라이언트도 같은 상태를 받습니다. */
+	UPROPERTY(ReplicatedUsing = OnRep_AttachedCaster)
+	TObjectPtr<ASMPlayerCharacter> AttachedCaster;
+
+	FTimerHandle AttachedCasterTimerHandle;
+
+	/** 당기기에 걸리는 시간입니다. */
+	const float PullTotalTime = 0.1f;
+
+	const float CatchDistance = 300.0f;
+
+	const float CatchRadius = 50.0f;
+
+protected: // Catch Prediction Section
+	/** 서버 응답을 기다리지 않고 대상을 먼저 당깁니다. 예측 키를 반환하며 예측할 수 없으면 0을 반환합니다. */
+	uint16 PredictCatch(ASMPlayerCharacter* InTargetCharacter);
+
+	/** 예측한 당기기와 어태치를 취소하고 대상을 마지막으로 수신한 서버 위치로 되돌립니다. */
+	void RollbackCatchPrediction(bool bInTimedOut);
+
+	/** 서버에서 잡기 요청의 처리 결과를 기록합니다. 시전자 클라이언트에만 복제됩니다. */
+	void SetCatchPredictionAck(uint16 InPredictionKey, bool bInAccepted);
+
+	UFUNCTION()
+	void OnRep_CatchPredictionAck();
+
+	/** 별도의 RPC 없이 예측을 확정하거나 되돌리기 위한 서버의 응답입니다. */
+	UPROPERTY(ReplicatedUsing = OnRep_CatchPredictionAck)
+	FSMCatchPredictionAck CatchPredictionAck;
+
+	/** 응답을 기다리는 예측의 키입니다. 0이면 대기 중인 예측이 없으며, 대기 중에는 새로운 잡기를 하지 않습니다. */
+	uint16 PendingCatchPredictionKey = 0;
+
+	uint16 LastCatchPredictionKey = 0;
+
+	float PendingCatchPredictionTime = 0.0f;
+
+	TWeakObjectPtr<ASMPlayerCharacter> PredictedCatchTarget;
+
+	/** 대기 중인 예측의 입력 시간과 전송 시간입니다. 응답을 받으면 지연 시간으로 기록합니다. */
+	double PendingCatchInputTime = 0.0;
+
+	double PendingCatchSendTime = 0.0;
+
+	/** 응답이 유실되어도 예측이 남지 않도록 이 시간이 지나면 되돌립니다. */
+	const float CatchPredictionTimeout = 1.0f;
+
+public: // Net Accounting Section
+	/** 클라이언트에서 이동 복제의 수신을 USMNetAccountingSubsystem에 기록합니다. */
+	virtual void OnRep_ReplicatedMovement() override;
+
+private:
+	/** 마지막으로 수신한 이동 복제를 다시 적용합니다. 실제 수신이 아니므로 USMNetAccountingSubsystem에 기록하지 않습니다. */
+	void ReapplyReplicatedMovement();
+
+public: // Snapshot Interpolation Section
+	/**
+	 * 스냅샷 보간을 사용하는 시뮬레이티드 프록시라면 수신한 위치를 바로 적용하지 않고 무브먼트 컴포넌트에 스냅샷으로 추가합니다.
+	 * 움직이는 베이스 위에서는 스냅샷 보간을 사용하지 않으므로 ACharacter의 베이스 이동 처리를 그대로 따릅니다.
+	 */
+	virtual void PostNetReceiveLocationAndRotation() override;
+
+protected: // Latency Section
+	/**
+	 * 잡기 요청을 받은 뒤 처음 복제될 때 서버 처리 시간을 기록합니다. 요청의 결과는 이 복제로 전송됩니다.
+	 * 복제될 때마다 USMNetUpdateSubsystem의 업데이트 수도 기록합니다.
+	 */
+	virtual void PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker) override;
+
+	static void RecordLatencySample(const UWorld* InWorld, ESMLatencyAction InAction, ESMLatencyStage InStage, double InSeconds);
+
+	/** 서버가 마지막으로 잡기 요청을 받은 시간입니다. 0이면 복제를 기다리는 요청이 없습니다. */
+	double CatchReceiveTime = 0.0;
 
-	void UpdatePerformPull(float DeltaSeconds);
+protected: // Lag Compensation Section
+	/** 서버와 클라이언트가 공유하는 시간 기준입니다. */
+	float GetServerWorldTime() const;
 
-	void HandlePullEnd();
+	/** 서버에서만 기록되는 캡슐 위치 기록입니다. */
+	FSMPositionHistory PositionHistory;
 
-	UFUNCTION(NetMulticast, Reliable)
-	void MulticastRPCAttachToCaster(AActor* InCaster, AActor* InTarget);
+	/** 되감을 수 있는 최대 시간입니다. 이보다 지연이 큰 클라이언트는 불리한 판정을 받습니다. */
+	const float MaxCatchRewindTime = 0.3f;
 
-	FPullData PullData;
+	/** 보간 오차를 고려한 판정 여유 거리입니다. */
+	const float CatchValidationTolerance = 25.0f;
 };
@@ -0,0 +1,69 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Character/SMPositionHistory.h"
+
+static_assert(FMath::IsPowerOfTwo(FSMPositionHistory::Capacity), "FSMPositionHistory::Capacity must be a power of two.");
+
+void FSMPositionHistory::Record(float InTime, const FVector& InLocation)
+{
+	// 간격이 너무 짧은 기록은 버립니다. 되감기 오차는 최대 MinRecordInterval 만큼의 이동량으로 제한됩니다.
+	if (Count > 0 && InTime - GetSample(Count - 1).Time < MinRecordInterval)
+	{
+		return;
+	}
+
+	Samples[Head] = FSample{FVector3f(InLocation), InTime};
+	Head = (Head + 1) & (Capacity - 1);
+	Count = FMath::Min(Count + 1, Capacity);
+}
+
+bool FSMPositionHistory::Sample(float InTime, FVector& OutLocation) const
+{
+	if (Count == 0)
+	{
+		return false;
+	}
+
+	const FSample& Oldest = GetSample(0);
+	if (InTime <= Oldest.Time)
+	{
+		OutLocation = FVector(Oldest.Location);
+		return true;
+	}
+
+	const FSample& Newest = GetSample(Count - 1);
+	if (InTime >= Newest.Time)
+	{
+		OutLocation = FVector(Newest.Location);
+		return true;
+	}
+
+	// InTime 이후의 첫 기록을 찾습니다. 위에서 범위를 확인했기 때문에 결과는 항상 [1, Count - 1]입니다.
+	int32 Low = 1;
+	int32 High = Count - 1;
+	while (Low < High)
+	{
+		const int32 Mid = (Low + High) / 2;
+		if (GetSample(Mid).Time < InTime)
+		{
+			Low = Mid + 1;
+		}
+		else
+		{
+			High = Mid;
+		}
+	}
+
+	const FSample& Before = GetSample(Low - 1);
+	const FSample& After = GetSample(Low);
+	const float Alpha = (InTime - Before.Time) / FMath::Max(After.Time - Before.Time, UE_SMALL_NUMBER);
+	OutLocation = FVector(FMath::Lerp(Before.Location, After.Location, Alpha));
+	return true;
+}
+
+void FSMPositionHistory::Reset()
+{
+	Head = 0;
+	Count = 0;
+}
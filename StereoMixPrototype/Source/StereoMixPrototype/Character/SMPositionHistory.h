@@ -0,0 +1,45 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * 서버 되감기(랙 보상)에 사용하는 캡슐 위치 기록입니다.
+ * 고정 크기 링버퍼에 시간순으로 저장하기 때문에 기록 시 할당이 없고, 조회는 이진 탐색으로 처리됩니다.
+ */
+class STEREOMIXPROTOTYPE_API FSMPositionHistory
+{
+public:
+	/** 2의 거듭제곱이어야 합니다. 60Hz 기록 기준 약 0.5초 분량입니다. */
+	static constexpr int32 Capacity = 32;
+
+	/** 기록 간 최소 간격입니다. 서버 틱레이트가 높아도 되감을 수 있는 시간 범위가 줄어들지 않도록 합니다. */
+	static constexpr float MinRecordInterval = 1.0f / 60.0f;
+
+	/** 현재 위치를 기록합니다. 시간은 단조 증가해야 합니다. */
+	void Record(float InTime, const FVector& InLocation);
+
+	/** 주어진 시간의 위치를 보간해 반환합니다. 기록 범위 밖의 시간은 가장 가까운 기록으로 고정됩니다. */
+	bool Sample(float InTime, FVector& OutLocation) const;
+
+	void Reset();
+
+	int32 Num() const { return Count; }
+
+private:
+	struct FSample
+	{
+		FVector3f Location;
+		float Time;
+	};
+
+	const FSample& GetSample(int32 LogicalIndex) const { return Samples[(Head - Count + LogicalIndex) & (Capacity - 1)]; }
+
+	TStaticArray<FSample, Capacity> Samples;
+
+	/** 다음에 기록될 인덱스입니다. */
+	int32 Head = 0;
+
+	int32 Count = 0;
+};
@@ -2,4 +2,17 @@
 
 #pragma once
 
-#define CHARACTER_ASSET_PATH TEXT("/Script/StereoMixPrototype.SMCharacterAssetData'/Game/StereoMixPrototype/Data/Asset/DA_CharacterAsset.DA_CharacterAsset'")
+/** 에셋 매니저에 등록된 캐릭터 에셋 데이터의 이름입니다. 경로는 DefaultGame.ini의 PrimaryAssetTypesToScan에서 관리합니다. */
+#define CHARACTER_ASSET_NAME TEXT("DA_CharacterAsset")
+
+/** 메인 메뉴 맵입니다. */
+#define MAIN_MENU_MAP_PATH TEXT("/Game/StereoMixPrototype/Level/L_MainMenu")
+
+/** 매치 맵입니다. 메인 메뉴에서 미리 로드됩니다. */
+#define MATCH_MAP_PATH TEXT("/Game/StereoMixPrototype/Level/L_Main")
+
+/** 플레이어 캐릭터 블루프린트 패키지입니다. 메인 메뉴에서 미리 로드됩니다. */
+#define PLAYER_CHARACTER_BLUEPRINT_PATH TEXT("/Game/StereoMixPrototype/Blueprints/Character/BP_SMPlayerCharacter")
+
+/** 맵별 바닥 높이 필드 파일(<맵 이름>.smfh)의 콘텐츠 폴더 기준 경로입니다. 메모리 맵으로 열 수 있도록 pak 밖에 스테이징됩니다. (DefaultGame.ini) */
+#define FLOOR_HEIGHT_FIELD_DIRECTORY TEXT("StereoMixPrototype/Data/FloorHeight")
@@ -2,3 +2,248 @@
 
 
 #include "Game/SMGameMode.h"
+
+#include "Character/SMPlayerCharacter.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Log/SMBench.h"
+#include "Log/SMPerfMetric.h"
+
+ASMGameMode::ASMGameMode()
+{
+	bUseSeamlessTravel = true;
+}
+
+APawn* ASMGameMode::SpawnDefaultPawnAtTransform_Implementation(AController* NewPlayer, const FTransform& SpawnTransform)
+{
+	ASMPlayerCharacter* PooledCharacter = AcquirePooledCharacter(GetDefaultPawnClassForController(NewPlayer), SpawnTransform);
+	if (PooledCharacter)
+	{
+		PooledCharacter->SetInstigator(GetInstigator());
+		return PooledCharacter;
+	}
+
+	return Super::SpawnDefaultPawnAtTransform_Implementation(NewPlayer, SpawnTransform);
+}
+
+bool ASMGameMode::ShouldReset_Implementation(AActor* ActorToReset)
+{
+	// 풀에 있는 캐릭터는 이미 초기화되어 있습니다. 폰의 Reset은 액터를 파괴하므로 건너뜁니다.
+	const ASMPlayerCharacter* Character = Cast<ASMPlayerCharacter>(ActorToReset);
+	if (Character && CharacterPool.Contains(Character))
+	{
+		return false;
+	}
+
+	return Super::ShouldReset_Implementation(ActorToReset);
+}
+
+void ASMGameMode::Rematch()
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	// 폰은 레벨을 초기화하기 전에 풀로 반환해 파괴되지 않게 합니다. 컨트롤러는 Reset만 호출되고 유지됩니다.
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		APlayerController* PlayerController = It->Get();
+		ASMPlayerCharacter* Character = PlayerController ? Cast<ASMPlayerCharacter>(PlayerController->GetPawn()) : nullptr;
+		if (Character)
+		{
+			ReleaseCharacter(Character);
+		}
+	}
+
+	ResetLevel();
+
+	int32 NumRestartedPlayers = 0;
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		APlayerController* PlayerController = It->Get();
+		if (PlayerController && !PlayerController->GetPawn() && PlayerCanRestart(PlayerController))
+		{
+			RestartPlayer(PlayerController);
+			++NumRestartedPlayers;
+		}
+	}
+
+	UE_LOG(LogSMGameMode, Log, TEXT("재대결: 플레이어 %d명 재시작, %.1fms"), NumRestartedPlayers, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+void ASMGameMode::RespawnPlayer(AController* InController)
+{
+	if (!InController)
+	{
+		return;
+	}
+
+	ASMPlayerCharacter* Character = Cast<ASMPlayerCharacter>(InController->GetPawn());
+	if (Character)
+	{
+		ReleaseCharacter(Character);
+	}
+
+	RestartPlayer(InController);
+}
+
+void ASMGameMode::ReleaseCharacter(ASMPlayerCharacter* InCharacter)
+{
+	if (!InCharacter || CharacterPool.Contains(InCharacter))
+	{
+		return;
+	}
+
+	AController* Controller = InCharacter->GetController();
+	if (Controller)
+	{
+		Controller->UnPossess();
+	}
+
+	if (!CharacterPool.Release(InCharacter))
+	{
+		InCharacter->Destroy();
+	}
+}
+
+ASMPlayerCharacter* ASMGameMode::AcquirePooledCharacter(const UClass* InCharacterClass, const FTransform& InSpawnTransform)
+{
+	return CharacterPool.Acquire(InCharacterClass, InSpawnTransform);
+}
+
+bool FSMCharacterPool::Release(ASMPlayerCharacter* InCharacter)
+{
+	if (Characters.Num() >= MaxCharacters)
+	{
+		return false;
+	}
+
+	InCharacter->ResetForReuse();
+	Characters.Add(InCharacter);
+	return true;
+}
+
+ASMPlayerCharacter* FSMCharacterPool::Acquire(const UClass* InCharacterClass, const FTransform& InSpawnTransform)
+{
+	Characters.RemoveAllSwap([](const TObjectPtr<ASMPlayerCharacter>& Character) { return !IsValid(Character); });
+
+	const int32 Index = Characters.IndexOfByPredicate([InCharacterClass](const TObjectPtr<ASMPlayerCharacter>& Character) { return Character->GetClass() == InCharacterClass; });
+	if (Index == INDEX_NONE)
+	{
+		return nullptr;
+	}
+
+	ASMPlayerCharacter* Character = Characters[Index];
+	Characters.RemoveAtSwap(Index, 1, false);
+
+	Character->ActivateFromPool(InSpawnTransform);
+	return Character;
+}
+
+static FAutoConsoleCommandWithWorld SMGameRematchCommand(
+	TEXT("SM.Game.Rematch"),
+	TEXT("월드를 다시 로드하지 않고 매치를 다시 시작합니다. 서버에서만 동작합니다."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		ASMGameMode* GameMode = World ? World->GetAuthGameMode<ASMGameMode>() : nullptr;
+		if (GameMode)
+		{
+			GameMode->Rematch();
+		}
+	}));
+
+#if !UE_BUILD_SHIPPING
+/**
+ * 여러 캐릭터가 한 프레임에 리스폰될 때의 히치를 새로 스폰하는 경우와 풀에서 재사용하는 경우로 나누어 측정합니다.
+ * 게임 모드의 풀과 같은 방식으로 동작하는 별도의 풀을 사용하므로 게임 중인 캐릭터 풀에는 영향을 주지 않습니다.
+ * 사용법: SM.Bench.Respawn [캐릭터 수] [반복 횟수]
+ */
+static FAutoConsoleCommandWithWorldAndArgs SMBenchRespawnCommand(
+	TEXT("SM.Bench.Respawn"),
+	TEXT("리스폰 웨이브 하나를 새로 스폰할 때와 풀에서 꺼낼 때 걸리는 시간을 비교합니다. 인자: 캐릭터 수(기본 32), 반복 횟수(기본 5)"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		ASMGameMode* GameMode = World ? World->GetAuthGameMode<ASMGameMode>() : nullptr;
+		if (!GameMode)
+		{
+			UE_LOG(LogSMGameMode, Warning, TEXT("[SM.Bench.Respawn] 서버 게임 월드에서만 실행할 수 있습니다."));
+			return;
+		}
+
+		const int32 NumCharacters = Args.Num() > 0 ? FMath::Clamp(FCString::Atoi(*Args[0]), 1, 64) : 32;
+		const int32 NumRounds = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 5;
+
+		UClass* CharacterClass = SMBench::GetCharacterClass(World);
+
+		auto GetSpawnTransform = [NumCharacters](int32 Index)
+		{
+			const int32 GridSize = FMath::CeilToInt(FMath::Sqrt(static_cast<float>(NumCharacters)));
+			return FTransform(FVector(1000.0 * (Index % GridSize), 1000.0 * (Index / GridSize), 10000.0));
+		};
+
+		FSMCharacterPool BenchPool;
+		BenchPool.MaxCharacters = NumCharacters;
+
+		TArray<ASMPlayerCharacter*> Characters;
+		Characters.Reserve(NumCharacters);
+
+		double TotalSpawnTime = 0.0;
+		double MaxSpawnTime = 0.0;
+		double TotalPoolTime = 0.0;
+		double MaxPoolTime = 0.0;
+		for (int32 Round = 0; Round < NumRounds; ++Round)
+		{
+			double StartTime = FPlatformTime::Seconds();
+			for (int32 i = 0; i < NumCharacters; ++i)
+			{
+				ASMPlayerCharacter* Character = SMBench::SpawnCharacter(World, CharacterClass, GetSpawnTransform(i));
+				if (Character)
+				{
+					Characters.Add(Character);
+				}
+			}
+			const double SpawnTime = FPlatformTime::Seconds() - StartTime;
+			TotalSpawnTime += SpawnTime;
+			MaxSpawnTime = FMath::Max(MaxSpawnTime, SpawnTime);
+
+			for (ASMPlayerCharacter* Character : Characters)
+			{
+				if (!BenchPool.Release(Character))
+				{
+					Character->Destroy();
+				}
+			}
+			Characters.Reset();
+
+			StartTime = FPlatformTime::Seconds();
+			for (int32 i = 0; i < NumCharacters; ++i)
+			{
+				ASMPlayerCharacter* Character = BenchPool.Acquire(CharacterClass, GetSpawnTransform(i));
+				if (Character)
+				{
+					Characters.Add(Character);
+				}
+			}
+			const double PoolTime = FPlatformTime::Seconds() - StartTime;
+			TotalPoolTime += PoolTime;
+			MaxPoolTime = FMath::Max(MaxPoolTime, PoolTime);
+
+			for (ASMPlayerCharacter* Character : Characters)
+			{
+				Character->Destroy();
+			}
+			Characters.Reset();
+		}
+
+		for (ASMPlayerCharacter* Character : BenchPool.Characters)
+		{
+			if (IsValid(Character))
+			{
+				Character->Destroy();
+			}
+		}
+
+		UE_LOG(LogSMGameMode, Log, TEXT("[SM.Bench.Respawn] 캐릭터 %d명 웨이브 %d회 - 새로 스폰: 평균 %.3fms, 최대 %.3fms / 풀 재사용: 평균 %.3fms, 최대 %.3fms"),
+			NumCharacters, NumRounds, TotalSpawnTime * 1000.0 / NumRounds, MaxSpawnTime * 1000.0, TotalPoolTime * 1000.0 / NumRounds, MaxPoolTime * 1000.0);
+		SM_PERF_METRIC(TEXT("respawn.spawnWaveMs.max"), MaxSpawnTime * 1000.0);
+		SM_PERF_METRIC(TEXT("respawn.poolWaveMs.max"), MaxPoolTime * 1000.0);
+	}));
+#endif
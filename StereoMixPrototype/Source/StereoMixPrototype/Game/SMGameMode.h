@@ -6,11 +6,70 @@
 #include "GameFramework/GameModeBase.h"
 #include "SMGameMode.generated.h"
 
+class ASMPlayerCharacter;
+
+DECLARE_LOG_CATEGORY_CLASS(LogSMGameMode, Log, All);
+
+/** 파괴하지 않고 재사용할 캐릭터를 보관하는 풀입니다. */
+USTRUCT()
+struct FSMCharacterPool
+{
+	GENERATED_BODY()
+
+	/** 캐릭터를 초기화해 보관합니다. 풀이 가득 찼다면 보관하지 않고 false를 반환하므로 호출하는 쪽에서 파괴합니다. */
+	bool Release(ASMPlayerCharacter* InCharacter);
+
+	/** 같은 클래스의 캐릭터를 꺼내 지정한 위치에서 활성화합니다. 없으면 nullptr를 반환합니다. */
+	ASMPlayerCharacter* Acquire(const UClass* InCharacterClass, const FTransform& InSpawnTransform);
+
+	bool Contains(const ASMPlayerCharacter* InCharacter) const { return Characters.Contains(InCharacter); }
+
+	int32 Num() const { return Characters.Num(); }
+
+	UPROPERTY()
+	TArray<TObjectPtr<ASMPlayerCharacter>> Characters;
+
+	/** 보관할 수 있는 최대 캐릭터 수입니다. */
+	int32 MaxCharacters = 64;
+};
+
 /**
- * 
+ * 매치 게임 모드입니다.
+ * 서버 이동은 심리스 트래블로 진행되어 플레이어 컨트롤러와 플레이어 스테이트가 유지되고 클라이언트의 접속이 끊기지 않습니다.
+ * 전환 맵은 DefaultEngine.ini의 TransitionMap(/Engine/Maps/Entry)입니다. 메뉴에서 매치로 들어갈 때도 같은 전환 맵을 거칩니다. (USMTravelSubsystem 참고)
+ *
+ * 리스폰되는 캐릭터는 파괴하지 않고 풀에 반환해 다음 스폰에 재사용합니다.
+ * 여러 플레이어가 한 번에 리스폰될 때 액터 생성과 컴포넌트 등록 비용이 한 프레임에 몰리지 않게 하기 위함입니다.
  */
 UCLASS()
 class STEREOMIXPROTOTYPE_API ASMGameMode : public AGameModeBase
 {
 	GENERATED_BODY()
+
+public:
+	ASMGameMode();
+
+public:
+	virtual APawn* SpawnDefaultPawnAtTransform_Implementation(AController* NewPlayer, const FTransform& SpawnTransform) override;
+	virtual bool ShouldReset_Implementation(AActor* ActorToReset) override;
+
+public:
+	/** 월드를 다시 로드하지 않고 레벨을 초기화한 뒤 모든 플레이어를 다시 스폰합니다. 컨트롤러는 그대로 유지됩니다. */
+	void Rematch();
+
+public: // Pool Section
+	/** 플레이어의 현재 캐릭터를 풀에 반환하고 새로 스폰합니다. */
+	void RespawnPlayer(AController* InController);
+
+	/** 캐릭터를 빙의 해제하고 초기화한 뒤 풀에 반환합니다. 풀이 가득 찼다면 파괴합니다. */
+	void ReleaseCharacter(ASMPlayerCharacter* InCharacter);
+
+	/** 풀에서 같은 클래스의 캐릭터를 꺼내 지정한 위치에서 활성화합니다. 풀에 없으면 nullptr를 반환합니다. */
+	ASMPlayerCharacter* AcquirePooledCharacter(const UClass* InCharacterClass, const FTransform& InSpawnTransform);
+
+	int32 GetNumPooledCharacters() const { return CharacterPool.Num(); }
+
+protected:
+	UPROPERTY()
+	FSMCharacterPool CharacterPool;
 };
@@ -0,0 +1,414 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Game/SMReplicationGraph.h"
+
+#include "Character/SMCharacterMovementComponent.h"
+#include "Character/SMPlayerCharacter.h"
+#include "Engine/NetConnection.h"
+#include "Engine/NetDriver.h"
+#include "GameFramework/PlayerController.h"
+#include "Subsystem/SMNetAccountingSubsystem.h"
+#include "Subsystem/SMNetUpdateSubsystem.h"
+#include "UObject/UObjectIterator.h"
+
+USMReplicationGraphNode_CharacterGrid::USMReplicationGraphNode_CharacterGrid()
+{
+	bRequiresPrepareForReplicationCall = true;
+}
+
+void USMReplicationGraphNode_CharacterGrid::NotifyAddNetworkActor(const FNewReplicatedActorInfo& ActorInfo)
+{
+	Characters.Add(ActorInfo.Actor);
+}
+
+bool USMReplicationGraphNode_CharacterGrid::NotifyRemoveNetworkActor(const FNewReplicatedActorInfo& ActorInfo, bool bWarnIfNotFound)
+{
+	const bool bRemoved = Characters.RemoveSingleSwap(ActorInfo.Actor, false) > 0;
+	if (!bRemoved && bWarnIfNotFound)
+	{
+		UE_LOG(LogSMReplicationGraph, Warning, TEXT("캐릭터 격자 노드에 없는 액터를 제거하려고 했습니다: %s"), *GetNameSafe(ActorInfo.Actor));
+	}
+
+	return bRemoved;
+}
+
+void USMReplicationGraphNode_CharacterGrid::NotifyResetAllNetworkActors()
+{
+	Characters.Reset();
+	CellCharacters.Reset();
+	FrameGatheredCharacters.Reset();
+}
+
+void USMReplicationGraphNode_CharacterGrid::PrepareForReplication()
+{
+	FrameGatheredCharacters.Reset();
+
+	const UNetDriver* NetDriver = GetWorld()->GetNetDriver();
+	ServerMaxTickRate = FMath::Max(NetDriver ? static_cast<float>(NetDriver->GetNetServerMaxTickRate()) : 30.0f, 1.0f);
+
+	// 모든 커넥션이 공유하도록 프레임당 한 번만 분류합니다.
+	for (TPair<FIntPoint, TArray<AActor*>>& Cell : CellCharacters)
+	{
+		Cell.Value.Reset();
+	}
+
+	for (AActor* Character : Characters)
+	{
+		CellCharacters.FindOrAdd(GetCellCoord(Character->GetActorLocation())).Add(Character);
+	}
+}
+
+void USMReplicationGraphNode_CharacterGrid::GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params)
+{
+	GatheredCharacters.Reset(Characters.Num());
+
+	// 수집은 복제가 아니므로 여기서는 수집만 기록하고, 실제 복제 여부는 복제가 끝난 뒤 RecordReplicatedCharacters에서 확인합니다.
+	USMNetUpdateSubsystem* NetUpdateSubsystem = GetWorld()->GetSubsystem<USMNetUpdateSubsystem>();
+	const bool bRecordReplication = NetUpdateSubsystem || USMNetAccountingSubsystem::IsEnabled();
+
+	// 커넥션 자신의 캐릭터는 잡기 응답 등 상태 변경이 늦어지지 않도록 거리 구간과 관계없이 매 프레임 복제합니다.
+	const APlayerController* ConnectionPlayerController = Params.ConnectionManager.NetConnection->PlayerController;
+	const AActor* ConnectionPawn = ConnectionPlayerController ? ConnectionPlayerController->GetPawn() : nullptr;
+
+	const float CullDistance = GetCullDistance();
+	const int32 CellRadius = FMath::CeilToInt(CullDistance / CellSize);
+
+	// 뷰어가 여러 명이면 주변 셀이 겹치므로 캐릭터마다 한 번만 검사합니다.
+	const bool bMultipleViewers = Params.Viewers.Num() > 1;
+	if (bMultipleViewers)
+	{
+		VisitedCharacters.Reset();
+	}
+
+	for (const FNetViewer& Viewer : Params.Viewers)
+	{
+		const FIntPoint ViewerCell = GetCellCoord(Viewer.ViewLocation);
+		for (int32 X = ViewerCell.X - CellRadius; X <= ViewerCell.X + CellRadius; ++X)
+		{
+			for (int32 Y = ViewerCell.Y - CellRadius; Y <= ViewerCell.Y + CellRadius; ++Y)
+			{
+				const TArray<AActor*>* Cell = CellCharacters.Find(FIntPoint(X, Y));
+				if (!Cell)
+				{
+					continue;
+				}
+
+				for (AActor* Character : *Cell)
+				{
+					if (bMultipleViewers)
+					{
+						bool bAlreadyVisited = false;
+						VisitedCharacters.Add(Character, &bAlreadyVisited);
+						if (bAlreadyVisited)
+						{
+							continue;
+						}
+					}
+
+					// 뷰어가 여러 명이면 가장 가까운 뷰어를 기준으로 주기를 정합니다.
+					const FVector CharacterLocation = Character->GetActorLocation();
+					float MinDistanceSquared = FVector::DistSquared2D(Viewer.ViewLocation, CharacterLocation);
+					if (bMultipleViewers)
+					{
+						for (const FNetViewer& OtherViewer : Params.Viewers)
+						{
+							MinDistanceSquared = FMath::Min(MinDistanceSquared, static_cast<float>(FVector::DistSquared2D(OtherViewer.ViewLocation, CharacterLocation)));
+						}
+					}
+
+					const uint16 ReplicationPeriodFrame = GetReplicationPeriodFrame(MinDistanceSquared);
+					if (ReplicationPeriodFrame == 0)
+					{
+						continue;
+					}
+
+					FConnectionReplicationActorInfo& ConnectionActorInfo = Params.ConnectionManager.ActorInfoMap.FindOrAdd(Character);
+					ConnectionActorInfo.ReplicationPeriodFrame = Character == ConnectionPawn ? 1 : ScaleReplicationPeriodFrame(Character, ReplicationPeriodFrame);
+					GatheredCharacters.Add(Character);
+
+					if (bRecordReplication)
+					{
+						FrameGatheredCharacters.Emplace(&Params.ConnectionManager, Character);
+					}
+
+					if (NetUpdateSubsystem)
+					{
+						NetUpdateSubsystem->RecordConnectionGather();
+					}
+				}
+			}
+		}
+	}
+
+	if (GatheredCharacters.Num() > 0)
+	{
+		Params.OutGatheredReplicationLists.AddReplicationActorList(GatheredCharacters);
+	}
+}
+
+void USMReplicationGraphNode_CharacterGrid::RecordReplicatedCharacters(uint32 InReplicationFrameNum)
+{
+	USMNetAccountingSubsystem* NetAccountingSubsystem = USMNetAccountingSubsystem::IsEnabled() ? GetWorld()->GetSubsystem<USMNetAccountingSubsystem>() : nullptr;
+	USMNetUpdateSubsystem* NetUpdateSubsystem = GetWorld()->GetSubsystem<USMNetUpdateSubsystem>();
+
+	// 수집된 캐릭터도 주기가 오지 않았거나 대역폭이 부족하면 복제되지 않으므로 이번 프레임에 복제된 것만 집계합니다.
+	for (const TPair<UNetReplicationGraphConnection*, AActor*>& Gathered : FrameGatheredCharacters)
+	{
+		const FConnectionReplicationActorInfo* ConnectionActorInfo = Gathered.Key->ActorInfoMap.Find(Gathered.Value);
+		if (!ConnectionActorInfo || ConnectionActorInfo->LastRepFrameNum != InReplicationFrameNum)
+		{
+			continue;
+		}
+
+		if (NetAccountingSubsystem)
+		{
+			NetAccountingSubsystem->RecordMovementOut(Gathered.Key->NetConnection, Gathered.Value);
+		}
+
+		if (NetUpdateSubsystem)
+		{
+			NetUpdateSubsystem->RecordConnectionUpdate();
+		}
+	}
+
+	FrameGatheredCharacters.Reset();
+}
+
+void USMReplicationGraphNode_CharacterGrid::SetDistanceBands(const TArray<FSMReplicationDistanceBand>& InDistanceBands)
+{
+	DistanceBands = InDistanceBands;
+}
+
+FIntPoint USMReplicationGraphNode_CharacterGrid::GetCellCoord(const FVector& InLocation) const
+{
+	return FIntPoint(FMath::FloorToInt(InLocation.X / CellSize), FMath::FloorToInt(InLocation.Y / CellSize));
+}
+
+uint16 USMReplicationGraphNode_CharacterGrid::GetReplicationPeriodFrame(float InDistanceSquared) const
+{
+	for (const FSMReplicationDistanceBand& DistanceBand : DistanceBands)
+	{
+		if (InDistanceSquared <= FMath::Square(DistanceBand.MaxDistance))
+		{
+			return DistanceBand.ReplicationPeriodFrame;
+		}
+	}
+
+	return 0;
+}
+
+uint16 USMReplicationGraphNode_CharacterGrid::ScaleReplicationPeriodFrame(const AActor* InCharacter, uint16 InReplicationPeriodFrame) const
+{
+	int32 ReplicationPeriodFrame = InReplicationPeriodFrame;
+	if (USMNetUpdateSubsystem::IsEnabled())
+	{
+		// 활동의 주기를 구간의 주기에 곱하므로 가까운 구간에서도 설정한 주기만큼 줄어듭니다.
+		const float ActivityPeriodFrame = ServerMaxTickRate / FMath::Max(InCharacter->NetUpdateFrequency, 1.0f);
+		ReplicationPeriodFrame = FMath::Max(FMath::RoundToInt(ActivityPeriodFrame * InReplicationPeriodFrame), 1);
+	}
+
+	// 움직이는 캐릭터는 클라이언트가 보간 지연 안에 다음 스냅샷을 받을 수 있는 주기로 제한합니다. 멈춰 있다면 보간할 것이 없으므로 제한하지 않습니다.
+	if (!InCharacter->GetVelocity().IsNearlyZero())
+	{
+		ReplicationPeriodFrame = FMath::Min(ReplicationPeriodFrame, GetMaxMovingReplicationPeriodFrame());
+	}
+
+	return static_cast<uint16>(FMath::Min(ReplicationPeriodFrame, static_cast<int32>(MAX_uint16)));
+}
+
+int32 USMReplicationGraphNode_CharacterGrid::GetMaxMovingReplicationPeriodFrame() const
+{
+	// 지터를 위해 한 프레임을 남겨둡니다.
+	const int32 DelayFrames = FMath::FloorToInt(USMCharacterMovementComponent::GetMaxSnapshotInterpolationDelay() * ServerMaxTickRate);
+	return FMath::Max(DelayFrames - 1, 1);
+}
+
+void USMReplicationGraph::InitGlobalActorClassSettings()
+{
+	Super::InitGlobalActorClassSettings();
+
+	RegisteredClasses.Reset();
+	for (TObjectIterator<UClass> It; It; ++It)
+	{
+		UClass* Class = *It;
+		const AActor* ActorCDO = Cast<AActor>(Class->GetDefaultObject(false));
+		if (!ActorCDO || !ActorCDO->GetIsReplicated())
+		{
+			continue;
+		}
+
+		// 블루프린트 컴파일 중 생기는 임시 클래스는 제외합니다.
+		if (Class->GetName().StartsWith(TEXT("SKEL_")) || Class->GetName().StartsWith(TEXT("REINST_")))
+		{
+			continue;
+		}
+
+		RegisterClassSettings(Class);
+	}
+}
+
+void USMReplicationGraph::InitGlobalGraphNodes()
+{
+	CharacterGridNode = CreateNewNode<USMReplicationGraphNode_CharacterGrid>();
+	CharacterGridNode->SetDistanceBands({
+		{NearDistance, NearReplicationPeriodFrame},
+		{MidDistance, MidReplicationPeriodFrame},
+		{CharacterCullDistance, FarReplicationPeriodFrame}
+	});
+	AddGlobalGraphNode(CharacterGridNode);
+
+	GridNode = CreateNewNode<UReplicationGraphNode_GridSpatialization2D>();
+	GridNode->CellSize = GridCellSize;
+	GridNode->SpatialBias = FVector2D(-UE_OLD_WORLD_MAX, -UE_OLD_WORLD_MAX);
+	AddGlobalGraphNode(GridNode);
+
+	AlwaysRelevantNode = CreateNewNode<UReplicationGraphNode_ActorList>();
+	AddGlobalGraphNode(AlwaysRelevantNode);
+}
+
+void USMReplicationGraph::InitConnectionGraphNodes(UNetReplicationGraphConnection* RepGraphConnection)
+{
+	Super::InitConnectionGraphNodes(RepGraphConnection);
+
+	UReplicationGraphNode_AlwaysRelevant_ForConnection* AlwaysRelevantNodeForConnection = CreateNewNode<UReplicationGraphNode_AlwaysRelevant_ForConnection>();
+	AddConnectionGraphNode(AlwaysRelevantNodeForConnection, RepGraphConnection);
+	AlwaysRelevantNodesForConnection.Add(RepGraphConnection->NetConnection, AlwaysRelevantNodeForConnection);
+}
+
+void USMReplicationGraph::OnRemoveConnectionGraphNodes(UNetReplicationGraphConnection* RepGraphConnection)
+{
+	AlwaysRelevantNodesForConnection.Remove(RepGraphConnection->NetConnection);
+
+	Super::OnRemoveConnectionGraphNodes(RepGraphConnection);
+}
+
+void USMReplicationGraph::RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo)
+{
+	AActor* Actor = ActorInfo.Actor;
+
+	// GlobalInfo는 부모 클래스의 설정으로 만들어졌으므로 새로 등록한 설정으로 바꿉니다.
+	if (!RegisteredClasses.Contains(Actor->GetClass()))
+	{
+		RegisterClassSettings(Actor->GetClass());
+		GlobalInfo.Settings = GlobalActorReplicationInfoMap.GetClassInfo(Actor->GetClass());
+	}
+
+	if (Actor->bAlwaysRelevant)
+	{
+		AlwaysRelevantNode->NotifyAddNetworkActor(ActorInfo);
+	}
+	else if (Actor->bOnlyRelevantToOwner)
+	{
+		// 소유 커넥션은 스폰 직후에는 정해지지 않았을 수 있기 때문에 복제 직전에 노드를 정합니다.
+		ActorsWithoutNetConnection.Add(Actor);
+	}
+	else if (Actor->IsA<ASMPlayerCharacter>())
+	{
+		CharacterGridNode->NotifyAddNetworkActor(ActorInfo);
+	}
+	else if (Actor->IsRootComponentMovable())
+	{
+		GridNode->AddActor_Dynamic(ActorInfo, GlobalInfo);
+	}
+	else
+	{
+		GridNode->AddActor_Static(ActorInfo, GlobalInfo);
+	}
+}
+
+void USMReplicationGraph::RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo)
+{
+	AActor* Actor = ActorInfo.Actor;
+	if (Actor->bAlwaysRelevant)
+	{
+		AlwaysRelevantNode->NotifyRemoveNetworkActor(ActorInfo);
+	}
+	else if (Actor->bOnlyRelevantToOwner)
+	{
+		if (ActorsWithoutNetConnection.RemoveSingleSwap(Actor, false) == 0)
+		{
+			UReplicationGraphNode_AlwaysRelevant_ForConnection* AlwaysRelevantNodeForConnection = GetAlwaysRelevantNodeForConnection(Actor->GetNetConnection());
+			if (AlwaysRelevantNodeForConnection)
+			{
+				AlwaysRelevantNodeForConnection->NotifyRemoveNetworkActor(ActorInfo);
+			}
+		}
+	}
+	else if (Actor->IsA<ASMPlayerCharacter>())
+	{
+		CharacterGridNode->NotifyRemoveNetworkActor(ActorInfo);
+	}
+	else if (Actor->IsRootComponentMovable())
+	{
+		GridNode->RemoveActor_Dynamic(ActorInfo);
+	}
+	else
+	{
+		GridNode->RemoveActor_Static(ActorInfo);
+	}
+}
+
+int32 USMReplicationGraph::ServerReplicateActors(float DeltaSeconds)
+{
+	RouteActorsWithoutNetConnection();
+
+	const int32 NumReplicatedActors = Super::ServerReplicateActors(DeltaSeconds);
+
+	if (CharacterGridNode)
+	{
+		CharacterGridNode->RecordReplicatedCharacters(GetReplicationGraphFrame());
+	}
+
+	return NumReplicatedActors;
+}
+
+UReplicationGraphNode_AlwaysRelevant_ForConnection* USMReplicationGraph::GetAlwaysRelevantNodeForConnection(const UNetConnection* InConnection) const
+{
+	const TObjectPtr<UReplicationGraphNode_AlwaysRelevant_ForConnection>* AlwaysRelevantNodeForConnection = InConnection ? AlwaysRelevantNodesForConnection.Find(InConnection) : nullptr;
+	return AlwaysRelevantNodeForConnection ? AlwaysRelevantNodeForConnection->Get() : nullptr;
+}
+
+void USMReplicationGraph::RegisterClassSettings(UClass* InClass)
+{
+	RegisteredClasses.Add(InClass);
+
+	// 캐릭터의 복제 주기는 캐릭터 격자 노드가 커넥션별로 덮어씁니다.
+	FClassReplicationInfo ClassInfo;
+	if (InClass->IsChildOf<ASMPlayerCharacter>())
+	{
+		ClassInfo.SetCullDistanceSquared(FMath::Square(CharacterCullDistance));
+		ClassInfo.ReplicationPeriodFrame = 1;
+		GlobalActorReplicationInfoMap.SetClassInfo(InClass, ClassInfo);
+		return;
+	}
+
+	// 기본 드라이버와 같은 결과가 나오도록 클래스의 NetUpdateFrequency와 NetCullDistanceSquared를 그대로 사용합니다.
+	// NetUpdateFrequency가 0인 클래스는 가장 긴 주기로 복제합니다.
+	const AActor* ActorCDO = GetDefault<AActor>(InClass);
+	const float ServerMaxTickRate = FMath::Max(NetDriver ? static_cast<float>(NetDriver->GetNetServerMaxTickRate()) : 30.0f, 1.0f);
+	const float UpdatePeriodFrame = ServerMaxTickRate / FMath::Max(ActorCDO->NetUpdateFrequency, UE_KINDA_SMALL_NUMBER);
+	ClassInfo.SetCullDistanceSquared(ActorCDO->NetCullDistanceSquared);
+	ClassInfo.ReplicationPeriodFrame = static_cast<uint16>(FMath::Clamp(FMath::RoundToInt(UpdatePeriodFrame), 1, static_cast<int32>(MAX_uint16)));
+	GlobalActorReplicationInfoMap.SetClassInfo(InClass, ClassInfo);
+}
+
+void USMReplicationGraph::RouteActorsWithoutNetConnection()
+{
+	for (int32 i = ActorsWithoutNetConnection.Num() - 1; i >= 0; --i)
+	{
+		AActor* Actor = ActorsWithoutNetConnection[i];
+		if (!Actor)
+		{
+			ActorsWithoutNetConnection.RemoveAtSwap(i, 1, false);
+			continue;
+		}
+
+		UReplicationGraphNode_AlwaysRelevant_ForConnection* AlwaysRelevantNodeForConnection = GetAlwaysRelevantNodeForConnection(Actor->GetNetConnection());
+		if (AlwaysRelevantNodeForConnection)
+		{
+			AlwaysRelevantNodeForConnection->NotifyAddNetworkActor(FNewReplicatedActorInfo(Actor));
+			ActorsWithoutNetConnection.RemoveAtSwap(i, 1, false);
+		}
+	}
+}
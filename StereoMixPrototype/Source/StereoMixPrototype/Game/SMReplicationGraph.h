@@ -0,0 +1,169 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ReplicationGraph.h"
+#include "UObject/ObjectKey.h"
+#include "SMReplicationGraph.generated.h"
+
+class UReplicationGraphNode_ActorList;
+class UReplicationGraphNode_AlwaysRelevant_ForConnection;
+class UReplicationGraphNode_GridSpatialization2D;
+
+DECLARE_LOG_CATEGORY_CLASS(LogSMReplicationGraph, Log, All);
+
+/** 뷰어와의 거리 구간별 복제 주기입니다. */
+struct FSMReplicationDistanceBand
+{
+	float MaxDistance = 0.0f;
+
+	/** 이 구간의 캐릭터는 서버 프레임 기준으로 이 주기마다 한 번 복제됩니다. */
+	uint16 ReplicationPeriodFrame = 1;
+};
+
+/**
+ * 캐릭터 전용 공간 격자 노드입니다.
+ * 프레임마다 캐릭터를 셀 단위로 한 번 분류하고, 커넥션마다 뷰어 주변 셀의 캐릭터만 수집합니다.
+ * 수집한 캐릭터는 뷰어와의 거리 구간에 따라 커넥션별 복제 주기가 설정됩니다.
+ * USMNetUpdateSubsystem이 켜져 있으면 캐릭터의 NetUpdateFrequency를 가장 가까운 구간의 주기로 삼고, 먼 구간은 같은 비율로 주기를 늘립니다.
+ */
+UCLASS()
+class STEREOMIXPROTOTYPE_API USMReplicationGraphNode_CharacterGrid : public UReplicationGraphNode
+{
+	GENERATED_BODY()
+
+public:
+	USMReplicationGraphNode_CharacterGrid();
+
+public:
+	virtual void NotifyAddNetworkActor(const FNewReplicatedActorInfo& ActorInfo) override;
+	virtual bool NotifyRemoveNetworkActor(const FNewReplicatedActorInfo& ActorInfo, bool bWarnIfNotFound = true) override;
+	virtual void NotifyResetAllNetworkActors() override;
+	virtual void PrepareForReplication() override;
+	virtual void GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params) override;
+
+public:
+	/** 거리 구간을 가까운 순서로 설정합니다. 마지막 구간보다 먼 캐릭터는 수집되지 않습니다. */
+	void SetDistanceBands(const TArray<FSMReplicationDistanceBand>& InDistanceBands);
+
+	float GetCullDistance() const { return DistanceBands.Num() > 0 ? DistanceBands.Last().MaxDistance : 0.0f; }
+
+	/** 이번 프레임의 복제가 끝난 뒤 호출합니다. 수집한 캐릭터 중 실제로 커넥션에 복제된 것만 이동 복제와 업데이트 통계로 집계합니다. */
+	void RecordReplicatedCharacters(uint32 InReplicationFrameNum);
+
+	const float CellSize = 2000.0f;
+
+protected:
+	FIntPoint GetCellCoord(const FVector& InLocation) const;
+
+	/** 뷰어와의 거리가 속한 구간의 복제 주기를 반환합니다. 컬링 거리 밖이면 0을 반환합니다. */
+	uint16 GetReplicationPeriodFrame(float InDistanceSquared) const;
+
+	/**
+	 * 거리 구간의 주기에 캐릭터의 활동에 따른 업데이트 주기를 곱합니다.
+	 * 움직이는 캐릭터는 GetMaxMovingReplicationPeriodFrame을 넘지 않도록 제한합니다.
+	 */
+	uint16 ScaleReplicationPeriodFrame(const AActor* InCharacter, uint16 InReplicationPeriodFrame) const;
+
+	/** 클라이언트의 최대 보간 지연(SM.Net.MaxInterpolationDelay) 안에 다음 스냅샷이 도착하는 가장 긴 주기입니다. */
+	int32 GetMaxMovingReplicationPeriodFrame() const;
+
+	TArray<FSMReplicationDistanceBand> DistanceBands;
+
+	/** 업데이트 빈도를 프레임 주기로 바꾸기 위한 서버 틱 레이트입니다. 프레임마다 갱신됩니다. */
+	float ServerMaxTickRate = 30.0f;
+
+	TArray<AActor*> Characters;
+
+	/** 이번 프레임의 셀별 캐릭터입니다. 셀 배열은 프레임 간 할당을 재사용합니다. */
+	TMap<FIntPoint, TArray<AActor*>> CellCharacters;
+
+	/** 커넥션 하나의 수집 결과입니다. 복제는 커넥션 단위로 수집 직후 진행되므로 하나의 리스트를 재사용합니다. */
+	FActorRepListRefView GatheredCharacters;
+
+	/** 뷰어가 여러 명인 커넥션에서 이미 검사한 캐릭터입니다. 커넥션마다 비우고 할당은 재사용합니다. */
+	TSet<AActor*> VisitedCharacters;
+
+	/** 이번 프레임에 커넥션별로 수집한 캐릭터입니다. 통계를 기록할 때만 채웁니다. */
+	TArray<TPair<UNetReplicationGraphConnection*, AActor*>> FrameGatheredCharacters;
+};
+
+/**
+ * 플레이어 수가 많을 때 커넥션마다 모든 캐릭터를 검사하지 않도록 공간 정보로 복제 대상을 좁히는 리플리케이션 그래프입니다.
+ * DefaultEngine.ini의 ReplicationDriverClassName으로 활성화됩니다.
+ *
+ * - 캐릭터: USMReplicationGraphNode_CharacterGrid (거리 기반 복제 주기)
+ * - 그 외 공간 액터: 엔진 격자 노드
+ * - bAlwaysRelevant 액터(게임 스테이트, 플레이어 스테이트 등): 전역 항상 관련 노드
+ * - bOnlyRelevantToOwner 액터(플레이어 컨트롤러 등): 소유 커넥션의 항상 관련 노드
+ */
+UCLASS(Transient, Config = Engine)
+class STEREOMIXPROTOTYPE_API USMReplicationGraph : public UReplicationGraph
+{
+	GENERATED_BODY()
+
+public:
+	virtual void InitGlobalActorClassSettings() override;
+	virtual void InitGlobalGraphNodes() override;
+	virtual void InitConnectionGraphNodes(UNetReplicationGraphConnection* RepGraphConnection) override;
+	virtual void OnRemoveConnectionGraphNodes(UNetReplicationGraphConnection* RepGraphConnection) override;
+	virtual void RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo) override;
+	virtual void RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo) override;
+	virtual int32 ServerReplicateActors(float DeltaSeconds) override;
+
+protected:
+	UReplicationGraphNode_AlwaysRelevant_ForConnection* GetAlwaysRelevantNodeForConnection(const UNetConnection* InConnection) const;
+
+	/**
+	 * 클래스의 복제 설정을 등록합니다. 캐릭터와 그 하위 클래스는 캐릭터 설정을, 나머지는 클래스 기본값의 NetUpdateFrequency와 NetCullDistanceSquared를 사용합니다.
+	 * 초기화 이후 로드된 블루프린트 클래스는 등록되지 않으면 부모 클래스의 설정을 물려받으므로 처음 추가될 때 등록합니다.
+	 */
+	void RegisterClassSettings(UClass* InClass);
+
+	/** 소유 커넥션이 아직 없는 bOnlyRelevantToOwner 액터를 커넥션이 생기면 해당 커넥션의 노드로 옮깁니다. */
+	void RouteActorsWithoutNetConnection();
+
+	UPROPERTY()
+	TObjectPtr<USMReplicationGraphNode_CharacterGrid> CharacterGridNode;
+
+	UPROPERTY()
+	TObjectPtr<UReplicationGraphNode_GridSpatialization2D> GridNode;
+
+	UPROPERTY()
+	TObjectPtr<UReplicationGraphNode_ActorList> AlwaysRelevantNode;
+
+	UPROPERTY()
+	TMap<TObjectPtr<UNetConnection>, TObjectPtr<UReplicationGraphNode_AlwaysRelevant_ForConnection>> AlwaysRelevantNodesForConnection;
+
+	UPROPERTY()
+	TArray<TObjectPtr<AActor>> ActorsWithoutNetConnection;
+
+	TSet<TObjectKey<UClass>> RegisteredClasses;
+
+	/**
+	 * NearDistance 안의 캐릭터는 NearReplicationPeriodFrame, MidDistance 안은 MidReplicationPeriodFrame, 컬링 거리 안은 FarReplicationPeriodFrame마다 복제됩니다.
+	 * 클라이언트는 스냅샷 보간으로 낮은 복제 빈도를 보완합니다. (USMCharacterMovementComponent 참고)
+	 * SM.Net.Update가 켜져 있으면 구간의 주기에 캐릭터의 활동 주기가 곱해지며, 움직이는 캐릭터는 최대 보간 지연을 넘지 않는 주기로 제한됩니다.
+	 */
+	UPROPERTY(Config)
+	float NearDistance = 2500.0f;
+
+	UPROPERTY(Config)
+	float MidDistance = 5000.0f;
+
+	UPROPERTY(Config)
+	float CharacterCullDistance = 15000.0f;
+
+	/** 기본값은 DefaultEngine.ini의 [/Script/StereoMixPrototype.SMReplicationGraph]와 같게 유지합니다. 실제로 사용하는 값은 ini의 값입니다. */
+	UPROPERTY(Config)
+	uint16 NearReplicationPeriodFrame = 2;
+
+	UPROPERTY(Config)
+	uint16 MidReplicationPeriodFrame = 4;
+
+	UPROPERTY(Config)
+	uint16 FarReplicationPeriodFrame = 8;
+
+	const float GridCellSize = 10000.0f;
+};
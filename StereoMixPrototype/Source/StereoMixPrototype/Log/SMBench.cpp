@@ -0,0 +1,56 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Log/SMBench.h"
+
+#include "Character/SMPlayerCharacter.h"
+#include "Engine/World.h"
+#include "GameFramework/GameModeBase.h"
+
+#if !UE_BUILD_SHIPPING
+UClass* SMBench::GetCharacterClass(const UWorld* World)
+{
+	const AGameModeBase* GameMode = World ? World->GetAuthGameMode() : nullptr;
+	if (GameMode && GameMode->DefaultPawnClass && GameMode->DefaultPawnClass->IsChildOf<ASMPlayerCharacter>())
+	{
+		return GameMode->DefaultPawnClass.Get();
+	}
+
+	return ASMPlayerCharacter::StaticClass();
+}
+
+ASMPlayerCharacter* SMBench::SpawnCharacter(UWorld* World, UClass* CharacterClass, const FTransform& Transform)
+{
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	return World->SpawnActor<ASMPlayerCharacter>(CharacterClass, Transform, SpawnParameters);
+}
+
+void SMBench::SpawnRandomCharacters(UWorld* World, UClass* CharacterClass, int32 NumCharacters, double AreaSize, FRandomStream& RandomStream, TArray<ASMPlayerCharacter*>& OutCharacters)
+{
+	OutCharacters.Reserve(OutCharacters.Num() + NumCharacters);
+	for (int32 i = 0; i < NumCharacters; ++i)
+	{
+		const FVector Location(RandomStream.FRandRange(0.0, AreaSize), RandomStream.FRandRange(0.0, AreaSize), 10000.0);
+		const FRotator Rotation(0.0, RandomStream.FRandRange(0.0, 360.0), 0.0);
+		ASMPlayerCharacter* Character = SpawnCharacter(World, CharacterClass, FTransform(Rotation, Location));
+		if (Character)
+		{
+			OutCharacters.Add(Character);
+		}
+	}
+}
+
+void SMBench::DestroyCharacters(TArray<ASMPlayerCharacter*>& Characters)
+{
+	for (ASMPlayerCharacter* Character : Characters)
+	{
+		if (IsValid(Character))
+		{
+			Character->Destroy();
+		}
+	}
+	Characters.Reset();
+}
+#endif
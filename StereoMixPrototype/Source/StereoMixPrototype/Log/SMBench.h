@@ -0,0 +1,24 @@
+// SM.Bench.* 콘솔 명령이 공통으로 사용하는 임시 캐릭터 스폰 함수입니다.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if !UE_BUILD_SHIPPING
+class ASMPlayerCharacter;
+
+namespace SMBench
+{
+	/** 블루프린트의 캡슐과 메시 설정을 반영하기 위해 게임 모드의 기본 폰 클래스를 반환합니다. 캐릭터 클래스가 아니라면 ASMPlayerCharacter를 반환합니다. */
+	UClass* GetCharacterClass(const UWorld* World);
+
+	/** 다른 액터와 겹치더라도 항상 캐릭터를 스폰합니다. */
+	ASMPlayerCharacter* SpawnCharacter(UWorld* World, UClass* CharacterClass, const FTransform& Transform);
+
+	/** AreaSize x AreaSize 영역의 무작위 위치와 방향으로 캐릭터를 스폰해 OutCharacters에 추가합니다. */
+	void SpawnRandomCharacters(UWorld* World, UClass* CharacterClass, int32 NumCharacters, double AreaSize, FRandomStream& RandomStream, TArray<ASMPlayerCharacter*>& OutCharacters);
+
+	/** 벤치마크가 스폰한 캐릭터를 모두 파괴하고 배열을 비웁니다. */
+	void DestroyCharacters(TArray<ASMPlayerCharacter*>& Characters);
+}
+#endif
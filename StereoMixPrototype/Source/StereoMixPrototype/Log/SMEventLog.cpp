@@ -0,0 +1,265 @@
+// 구조화된 네트워크 이벤트 로그입니다.
+
+#include "Log/SMEventLog.h"
+
+#include <atomic>
+
+#include "Engine/World.h"
+#include "GameFramework/WorldSettings.h"
+#include "HAL/FileManager.h"
+#include "Log/SMLog.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+
+#if SM_EVENTLOG_ENABLED
+int32 GSMEventLogCategoryMask = -1;
+
+static FAutoConsoleVariableRef CVarSMEventLogCategories(
+	TEXT("SM.EventLog.Categories"),
+	GSMEventLogCategoryMask,
+	TEXT("기록할 이벤트 카테고리의 비트 마스크입니다. 1=Control 2=Catch 4=Pull 8=Attach, -1=전체, 0=끔"));
+
+static bool GSMEventLogEcho = false;
+
+static FAutoConsoleVariableRef CVarSMEventLogEcho(
+	TEXT("SM.EventLog.Echo"),
+	GSMEventLogEcho,
+	TEXT("기록한 이벤트를 텍스트로 변환해 LogSMNetwork에도 출력합니다. 문자열 생성 비용이 생기므로 디버깅 용도로만 사용합니다."));
+#endif
+
+namespace SMEventLog
+{
+	static const TCHAR* EventNames[] =
+	{
+#define SM_EVENT_NAME(Name, Category, Description) TEXT(#Name),
+		SM_EVENT_LIST(SM_EVENT_NAME)
+#undef SM_EVENT_NAME
+	};
+}
+
+const TCHAR* FSMEventLog::GetEventName(ESMEvent InEvent)
+{
+	return InEvent < ESMEvent::Max ? SMEventLog::EventNames[static_cast<uint16>(InEvent)] : TEXT("Unknown");
+}
+
+#if SM_EVENTLOG_ENABLED
+namespace SMEventLog
+{
+	/** 2의 거듭제곱이어야 합니다. 스레드당 256KB입니다. */
+	static constexpr uint64 RingCapacity = 8192;
+
+	/**
+	 * 스레드 하나가 쓰는 링버퍼입니다. 쓰기는 소유 스레드만 하기 때문에 락이 필요 없습니다.
+	 * 덤프는 다른 스레드에서 읽으므로 WriteCount를 release/acquire로 주고받습니다.
+	 */
+	struct FRingBuffer
+	{
+		uint32 ThreadId = 0;
+		std::atomic<uint64> WriteCount{0};
+		FSMEventRecord Records[RingCapacity];
+	};
+
+	static FCriticalSection& GetRegistryLock()
+	{
+		static FCriticalSection RegistryLock;
+		return RegistryLock;
+	}
+
+	/** 덤프를 위해 모든 스레드의 링버퍼를 보관합니다. 스레드가 종료되어도 기록을 남기기 위해 해제하지 않습니다. */
+	static TArray<FRingBuffer*>& GetRegistry()
+	{
+		static TArray<FRingBuffer*> Registry;
+		return Registry;
+	}
+
+	static FRingBuffer& GetThreadRingBuffer()
+	{
+		static thread_local FRingBuffer* ThreadRingBuffer = nullptr;
+		if (UNLIKELY(!ThreadRingBuffer))
+		{
+			ThreadRingBuffer = new FRingBuffer();
+			ThreadRingBuffer->ThreadId = FPlatformTLS::GetCurrentThreadId();
+
+			FScopeLock RegistryScopeLock(&GetRegistryLock());
+			GetRegistry().Add(ThreadRingBuffer);
+		}
+
+		return *ThreadRingBuffer;
+	}
+
+	static const TCHAR* EventDescriptions[] =
+	{
+#define SM_EVENT_DESCRIPTION(Name, Category, Description) TEXT(Description),
+		SM_EVENT_LIST(SM_EVENT_DESCRIPTION)
+#undef SM_EVENT_DESCRIPTION
+	};
+
+	static void WriteString(FArchive& Ar, const TCHAR* InString)
+	{
+		const FTCHARToUTF8 Converter(InString);
+		uint16 Length = static_cast<uint16>(Converter.Length());
+		Ar << Length;
+		Ar.Serialize(const_cast<ANSICHAR*>(Converter.Get()), Length);
+	}
+
+	static void EchoRecord(const FSMEventRecord& InRecord)
+	{
+		UE_LOG(LogSMNetwork, Log, TEXT("[Frame %u] [NetMode %u / PIE %d] [Local: %u / Remote: %u] [Actor %u] %s: %d %f"),
+			InRecord.FrameNumber, InRecord.NetMode, InRecord.PIEInstance, InRecord.Roles >> 4, InRecord.Roles & 0xF,
+			InRecord.ActorId, EventNames[InRecord.EventId], InRecord.Arg0, InRecord.Arg1);
+	}
+}
+
+void FSMEventLog::Write(const AActor* InActor, ESMEvent InEvent, int32 InArg0, float InArg1)
+{
+	SMEventLog::FRingBuffer& RingBuffer = SMEventLog::GetThreadRingBuffer();
+	const uint64 WriteIndex = RingBuffer.WriteCount.load(std::memory_order_relaxed);
+
+	FSMEventRecord& Record = RingBuffer.Records[WriteIndex & (SMEventLog::RingCapacity - 1)];
+	Record.Cycles = FPlatformTime::Cycles64();
+	Record.FrameNumber = static_cast<uint32>(GFrameCounter);
+	Record.ActorId = InActor ? InActor->GetUniqueID() : 0;
+	Record.EventId = static_cast<uint16>(InEvent);
+	Record.NetMode = static_cast<uint8>(InActor ? InActor->GetNetMode() : NM_MAX);
+	Record.Roles = InActor ? static_cast<uint8>((InActor->GetLocalRole() << 4) | (InActor->GetRemoteRole() & 0xF)) : 0;
+	Record.Arg0 = InArg0;
+	Record.Arg1 = InArg1;
+	Record.PIEInstance = GPlayInEditorID;
+
+	RingBuffer.WriteCount.store(WriteIndex + 1, std::memory_order_release);
+
+	if (UNLIKELY(GSMEventLogEcho))
+	{
+		SMEventLog::EchoRecord(Record);
+	}
+}
+
+bool FSMEventLog::Dump(const FString& InFilename)
+{
+	TUniquePtr<FArchive> Ar(IFileManager::Get().CreateFileWriter(*InFilename));
+	if (!Ar)
+	{
+		return false;
+	}
+
+	// 헤더: 매직, 버전, 사이클당 초
+	ANSICHAR Magic[4] = {'S', 'M', 'E', 'V'};
+	Ar->Serialize(Magic, sizeof(Magic));
+	uint32 Version = 1;
+	*Ar << Version;
+	double SecondsPerCycle = FPlatformTime::GetSecondsPerCycle64();
+	*Ar << SecondsPerCycle;
+
+	// 이벤트 이름 테이블
+	uint32 NumEvents = static_cast<uint32>(ESMEvent::Max);
+	*Ar << NumEvents;
+	for (uint32 EventId = 0; EventId < NumEvents; ++EventId)
+	{
+		uint16 Id = static_cast<uint16>(EventId);
+		*Ar << Id;
+		SMEventLog::WriteString(*Ar, SMEventLog::EventNames[EventId]);
+		SMEventLog::WriteString(*Ar, SMEventLog::EventDescriptions[EventId]);
+	}
+
+	// 스레드별 레코드. 오래된 것부터 기록합니다.
+	FScopeLock RegistryScopeLock(&SMEventLog::GetRegistryLock());
+	const TArray<SMEventLog::FRingBuffer*>& Registry = SMEventLog::GetRegistry();
+	uint32 NumThreads = Registry.Num();
+	*Ar << NumThreads;
+	for (SMEventLog::FRingBuffer* RingBuffer : Registry)
+	{
+		const uint64 WriteCount = RingBuffer->WriteCount.load(std::memory_order_acquire);
+		uint32 NumRecords = static_cast<uint32>(FMath::Min(WriteCount, SMEventLog::RingCapacity));
+		*Ar << RingBuffer->ThreadId;
+		*Ar << NumRecords;
+
+		for (uint64 Index = WriteCount - NumRecords; Index < WriteCount; ++Index)
+		{
+			Ar->Serialize(&RingBuffer->Records[Index & (SMEventLog::RingCapacity - 1)], sizeof(FSMEventRecord));
+		}
+	}
+
+	return Ar->Close();
+}
+
+static FAutoConsoleCommandWithArgsAndOutputDevice SMEventLogDumpCommand(
+	TEXT("SM.EventLog.Dump"),
+	TEXT("이벤트 로그 링버퍼를 바이너리 파일로 저장합니다. 인자: 파일 경로(기본 Saved/Logs/SMEventLog_<시간>.bin)"),
+	FConsoleCommandWithArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, FOutputDevice& Output)
+	{
+		const FString Filename = Args.Num() > 0 ? Args[0] : FPaths::ProjectLogDir() / FString::Printf(TEXT("SMEventLog_%s.bin"), *FDateTime::Now().ToString());
+		if (FSMEventLog::Dump(Filename))
+		{
+			Output.Logf(TEXT("[SM.EventLog.Dump] 저장 완료: %s"), *Filename);
+		}
+		else
+		{
+			Output.Logf(ELogVerbosity::Error, TEXT("[SM.EventLog.Dump] 저장 실패: %s"), *Filename);
+		}
+	}));
+
+#if !UE_BUILD_SHIPPING
+namespace SMEventLog
+{
+	/** NET_LOG는 액터의 멤버 함수 안에서 사용되는 것을 전제로 하기 때문에 같은 이름의 함수를 제공하는 측정용 컨텍스트입니다. */
+	struct FNetLogBenchmarkContext
+	{
+		const AActor* Actor;
+
+		ENetMode GetNetMode() const { return Actor->GetNetMode(); }
+		ENetRole GetLocalRole() const { return Actor->GetLocalRole(); }
+		ENetRole GetRemoteRole() const { return Actor->GetRemoteRole(); }
+
+		void LogSuppressed(int32 InValue) const
+		{
+			// Verbose는 기본 설정에서 출력되지 않지만 NET_LOG는 검사 전에 문자열을 만듭니다.
+			NET_LOG(LogSMNetwork, Verbose, TEXT("벤치마크 %d"), InValue)
+		}
+	};
+}
+
+/** NET_LOG와 구조화 이벤트 로그의 호출당 비용을 비교합니다. 사용법: SM.Bench.EventLog [반복 횟수] */
+static FAutoConsoleCommandWithWorldAndArgs SMBenchEventLogCommand(
+	TEXT("SM.Bench.EventLog"),
+	TEXT("NET_LOG와 구조화 이벤트 로그의 호출당 비용을 비교합니다. 인자: 반복 횟수(기본 100000)"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		const int32 Iterations = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 100000;
+
+		const AActor* Actor = World ? World->GetWorldSettings() : nullptr;
+		if (!Actor)
+		{
+			return;
+		}
+
+		const auto Measure = [Iterations](const TFunctionRef<void(int32)> Body)
+		{
+			const double StartTime = FPlatformTime::Seconds();
+			for (int32 i = 0; i < Iterations; ++i)
+			{
+				Body(i);
+			}
+			return (FPlatformTime::Seconds() - StartTime) * 1e9 / Iterations;
+		};
+
+		const SMEventLog::FNetLogBenchmarkContext NetLogContext{Actor};
+		const double NetLogTime = Measure([&NetLogContext](int32 i) { NetLogContext.LogSuppressed(i); });
+
+		const int32 PreviousMask = GSMEventLogCategoryMask;
+		const bool bPreviousEcho = GSMEventLogEcho;
+		GSMEventLogEcho = false;
+
+		GSMEventLogCategoryMask = 0;
+		const double DisabledTime = Measure([Actor](int32 i) { SM_EVENT_ACTOR(Actor, ControlChanged, i); });
+
+		GSMEventLogCategoryMask = -1;
+		const double EnabledTime = Measure([Actor](int32 i) { SM_EVENT_ACTOR(Actor, ControlChanged, i); });
+
+		GSMEventLogCategoryMask = PreviousMask;
+		GSMEventLogEcho = bPreviousEcho;
+
+		UE_LOG(LogSMNetwork, Log, TEXT("[SM.Bench.EventLog] %d회 - NET_LOG(출력 억제): %.1fns/회, 이벤트 로그(비활성): %.1fns/회, 이벤트 로그(활성): %.1fns/회"),
+			Iterations, NetLogTime, DisabledTime, EnabledTime);
+	}));
+#endif
+#endif
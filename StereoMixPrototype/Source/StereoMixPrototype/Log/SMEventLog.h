@@ -0,0 +1,123 @@
+// 구조화된 네트워크 이벤트 로그입니다.
+// 문자열을 만들지 않고 고정 크기 바이너리 레코드를 스레드별 링버퍼에 기록하며, 덤프는 Scripts/EventLog/decode_eventlog.py로 해석합니다.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AActor;
+
+#ifndef SM_EVENTLOG_ENABLED
+#define SM_EVENTLOG_ENABLED !UE_BUILD_SHIPPING
+#endif
+
+/** 이벤트 카테고리입니다. 카테고리 단위로 컴파일 시점과 런타임에 켜고 끌 수 있습니다. */
+enum class ESMEventCategory : uint8
+{
+	Control,
+	Catch,
+	Pull,
+	Attach,
+	Max
+};
+
+#ifndef SM_EVENTLOG_COMPILED_CATEGORIES
+/** 컴파일에 포함할 카테고리의 비트 마스크입니다. 빠진 카테고리의 이벤트는 코드가 생성되지 않습니다. */
+#define SM_EVENTLOG_COMPILED_CATEGORIES 0xFFFFFFFFu
+#endif
+
+/**
+ * 이벤트 목록입니다. Op(이름, 카테고리, 설명)
+ * 덤프 파일에 이름 테이블이 함께 기록되기 때문에 순서를 바꿔도 이전 덤프를 해석할 수 있습니다.
+ */
+#define SM_EVENT_LIST(Op) \
+	Op(ControlChanged, Control, "컨트롤 상태 변경 (Arg0: bCanControl)") \
+	Op(CatchCast, Catch, "잡기 시전") \
+	Op(CatchHit, Catch, "잡기 적중 (Arg0: 대상 ID)") \
+	Op(CatchRejected, Catch, "잡기 거부 (Arg0: 대상 ID, Arg1: 사유 0=대상 오류 1=되감기 판정 실패)") \
+	Op(CatchPredicted, Catch, "잡기 예측 (Arg0: 대상 ID, Arg1: 예측 키)") \
+	Op(CatchConfirmed, Catch, "잡기 예측 확정 (Arg0: 예측 키)") \
+	Op(CatchRolledBack, Catch, "잡기 예측 취소 (Arg0: 예측 키, Arg1: 사유 0=서버 거부 1=응답 시간 초과)") \
+	Op(PullStart, Pull, "당기기 시작 (Arg0: 대상 ID)") \
+	Op(PullEnd, Pull, "당기기 종료 (Arg0: 시전자 ID)") \
+	Op(AttachStart, Attach, "어태치 시작 (Arg0: 시전자 ID)")
+
+enum class ESMEvent : uint16
+{
+#define SM_EVENT_ENUM(Name, Category, Description) Name,
+	SM_EVENT_LIST(SM_EVENT_ENUM)
+#undef SM_EVENT_ENUM
+	Max
+};
+
+/** 바이너리로 기록되는 이벤트 하나입니다. 디코더와 형식을 맞춰야 합니다. */
+struct FSMEventRecord
+{
+	uint64 Cycles;
+	uint32 FrameNumber;
+	uint32 ActorId;
+	uint16 EventId;
+	uint8 NetMode;
+	/** 상위 4비트는 로컬 롤, 하위 4비트는 리모트 롤입니다. */
+	uint8 Roles;
+	int32 Arg0;
+	float Arg1;
+	int32 PIEInstance;
+};
+
+static_assert(sizeof(FSMEventRecord) == 32, "FSMEventRecord layout must match Scripts/EventLog/decode_eventlog.py");
+
+#if SM_EVENTLOG_ENABLED
+/** 런타임에 활성화된 카테고리의 비트 마스크입니다. SM.EventLog.Categories로 변경합니다. */
+extern STEREOMIXPROTOTYPE_API int32 GSMEventLogCategoryMask;
+#endif
+
+class STEREOMIXPROTOTYPE_API FSMEventLog
+{
+public:
+	static constexpr uint32 GetCategoryBit(ESMEvent InEvent)
+	{
+		constexpr ESMEventCategory Categories[] =
+		{
+#define SM_EVENT_CATEGORY(Name, Category, Description) ESMEventCategory::Category,
+			SM_EVENT_LIST(SM_EVENT_CATEGORY)
+#undef SM_EVENT_CATEGORY
+		};
+		return 1u << static_cast<uint32>(Categories[static_cast<uint16>(InEvent)]);
+	}
+
+	static constexpr bool IsCompiledIn(ESMEvent InEvent)
+	{
+		return (SM_EVENTLOG_COMPILED_CATEGORIES & GetCategoryBit(InEvent)) != 0;
+	}
+
+#if SM_EVENTLOG_ENABLED
+	/** 현재 스레드의 링버퍼에 이벤트를 기록합니다. 락과 할당이 없습니다. (스레드의 첫 기록은 제외) */
+	static void Write(const AActor* InActor, ESMEvent InEvent, int32 InArg0 = 0, float InArg1 = 0.0f);
+
+	/** 모든 스레드의 링버퍼를 파일로 저장합니다. */
+	static bool Dump(const FString& InFilename);
+#endif
+
+	static const TCHAR* GetEventName(ESMEvent InEvent);
+};
+
+#if SM_EVENTLOG_ENABLED
+/** 비활성화된 카테고리는 분기 한 번, 컴파일에서 빠진 카테고리는 비용이 없습니다. */
+#define SM_EVENT_ACTOR(Actor, Event, ...) \
+	do \
+	{ \
+		if constexpr (FSMEventLog::IsCompiledIn(ESMEvent::Event)) \
+		{ \
+			if (UNLIKELY(GSMEventLogCategoryMask & FSMEventLog::GetCategoryBit(ESMEvent::Event))) \
+			{ \
+				FSMEventLog::Write(Actor, ESMEvent::Event, ##__VA_ARGS__); \
+			} \
+		} \
+	} while (0)
+#else
+#define SM_EVENT_ACTOR(Actor, Event, ...) do {} while (0)
+#endif
+
+/** 액터 멤버 함수 안에서 사용합니다. */
+#define SM_EVENT(Event, ...) SM_EVENT_ACTOR(this, Event, ##__VA_ARGS__)
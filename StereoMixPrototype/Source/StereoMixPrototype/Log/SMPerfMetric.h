@@ -0,0 +1,9 @@
+// 성능 측정값 출력 매크로입니다. Scripts/PerfGate/check_perf_gate.py가 이 형식의 로그를 수집해 기준값과 비교합니다.
+
+#pragma once
+
+DECLARE_LOG_CATEGORY_CLASS(LogSMPerf, Log, All);
+
+/** [SM.Perf] 이름=값 형식으로 측정값을 출력합니다. 이름은 baselines.json의 키와 같아야 합니다. */
+#define SM_PERF_METRIC(NameFormat, Value, ...) \
+UE_LOG(LogSMPerf, Display, TEXT("[SM.Perf] %s=%.4f"), *FString::Printf(NameFormat, ##__VA_ARGS__), static_cast<double>(Value))
@@ -0,0 +1,26 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Log/SMStats.h"
+
+#if SM_PROFILING_ENABLED
+
+#define SM_DEFINE_SCOPE_STAT(Name, Description) DEFINE_STAT(STAT_SM_##Name);
+SM_STAT_SCOPE_LIST(SM_DEFINE_SCOPE_STAT)
+#undef SM_DEFINE_SCOPE_STAT
+
+DEFINE_STAT(STAT_SM_ActivePulls);
+DEFINE_STAT(STAT_SM_CatchesPerSecond);
+
+CSV_DEFINE_CATEGORY_MODULE(STEREOMIXPROTOTYPE_API, StereoMix, true);
+
+UE_TRACE_CHANNEL_DEFINE(SMChannel);
+
+bool GSMProfileEnabled = true;
+
+static FAutoConsoleVariableRef CVarSMProfileEnabled(
+	TEXT("SM.Profile.Enabled"),
+	GSMProfileEnabled,
+	TEXT("게임플레이 핫패스의 stat, CSV 스코프와 카운터를 기록합니다. 트레이스 스코프는 Trace.Enable SM으로 켜고 끕니다."));
+
+#endif
@@ -0,0 +1,86 @@
+// 게임플레이 핫패스의 CPU 프로파일링 매크로입니다.
+// 하나의 스코프로 stat 그룹(stat StereoMix), CSV 프로파일러(StereoMix 카테고리), Unreal Insights 트레이스(SM 채널)에 동시에 기록합니다.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProfilingDebugging/CountersTrace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "Stats/Stats.h"
+
+#ifndef SM_PROFILING_ENABLED
+#define SM_PROFILING_ENABLED !UE_BUILD_SHIPPING
+#endif
+
+/**
+ * 측정 스코프 목록입니다. Op(이름, 설명)
+ * 이름은 stat, CSV, 트레이스에서 공통으로 사용됩니다.
+ */
+#define SM_STAT_SCOPE_LIST(Op) \
+	Op(CharacterTick, "Character Tick") \
+	Op(RotateToMousePointer, "Rotate To Mouse Pointer") \
+	Op(Move, "Move") \
+	Op(HandleCatch, "Handle Catch") \
+	Op(UpdatePulls, "Update Pulls") \
+	Op(RebuildSpatialGrid, "Rebuild Spatial Grid") \
+	Op(OnRepController, "OnRep Controller") \
+	Op(OnRepReplicatedState, "OnRep ReplicatedState") \
+	Op(OnRepCatchPredictionAck, "OnRep CatchPredictionAck") \
+	Op(OnRepAttachedCaster, "OnRep AttachedCaster") \
+	Op(OnRepReplicatedMovement, "OnRep ReplicatedMovement")
+
+#if SM_PROFILING_ENABLED
+
+DECLARE_STATS_GROUP(TEXT("StereoMix"), STATGROUP_StereoMix, STATCAT_Advanced);
+
+#define SM_DECLARE_SCOPE_STAT(Name, Description) DECLARE_CYCLE_STAT_EXTERN(TEXT(Description), STAT_SM_##Name, STATGROUP_StereoMix, STEREOMIXPROTOTYPE_API);
+SM_STAT_SCOPE_LIST(SM_DECLARE_SCOPE_STAT)
+#undef SM_DECLARE_SCOPE_STAT
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Active Pulls"), STAT_SM_ActivePulls, STATGROUP_StereoMix, STEREOMIXPROTOTYPE_API);
+DECLARE_FLOAT_COUNTER_STAT_EXTERN(TEXT("Catches Per Second"), STAT_SM_CatchesPerSecond, STATGROUP_StereoMix, STEREOMIXPROTOTYPE_API);
+
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(STEREOMIXPROTOTYPE_API, StereoMix);
+
+UE_TRACE_CHANNEL_EXTERN(SMChannel, STEREOMIXPROTOTYPE_API);
+
+/** SM.Profile.Enabled 콘솔 변수입니다. 끄면 stat과 CSV 스코프가 기록되지 않습니다. 트레이스는 Trace.Enable SM으로 따로 켭니다. */
+extern STEREOMIXPROTOTYPE_API bool GSMProfileEnabled;
+
+/** 함수 하나를 stat, CSV, 트레이스 스코프로 측정합니다. 이름은 SM_STAT_SCOPE_LIST에 있어야 합니다. */
+#define SM_SCOPE_CYCLE_COUNTER(Name) \
+	CONDITIONAL_SCOPE_CYCLE_COUNTER(STAT_SM_##Name, GSMProfileEnabled); \
+	CSV_CONDITIONAL_SCOPED_TIMING_STAT(StereoMix, Name, GSMProfileEnabled); \
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(SM_##Name, SMChannel)
+
+/** 프레임 단위 카운터를 stat, CSV, 트레이스에 기록합니다. */
+#define SM_SET_COUNTER(Name, Value) \
+	do \
+	{ \
+		if (GSMProfileEnabled) \
+		{ \
+			SET_DWORD_STAT(STAT_SM_##Name, Value); \
+			CSV_CUSTOM_STAT(StereoMix, Name, static_cast<int32>(Value), ECsvCustomStatOp::Set); \
+			TRACE_INT_VALUE(TEXT("SM/" #Name), Value); \
+		} \
+	} while (0)
+
+#define SM_SET_FLOAT_COUNTER(Name, Value) \
+	do \
+	{ \
+		if (GSMProfileEnabled) \
+		{ \
+			SET_FLOAT_STAT(STAT_SM_##Name, Value); \
+			CSV_CUSTOM_STAT(StereoMix, Name, static_cast<float>(Value), ECsvCustomStatOp::Set); \
+			TRACE_FLOAT_VALUE(TEXT("SM/" #Name), Value); \
+		} \
+	} while (0)
+
+#else
+
+#define SM_SCOPE_CYCLE_COUNTER(Name)
+#define SM_SET_COUNTER(Name, Value)
+#define SM_SET_FLOAT_COUNTER(Name, Value)
+
+#endif
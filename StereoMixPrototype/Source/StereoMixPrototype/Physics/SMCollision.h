@@ -2,10 +2,5 @@
 
 #pragma once
 
-#define CP_AIM_PLANE TEXT("AimPlane")
 #define CP_CAUGHT TEXT("Caught")
 
-#define OC_AIM_PLANE ECC_GameTraceChannel2
-
-#define TC_AIM_PLANE ECC_GameTraceChannel1
-
@@ -0,0 +1,133 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Player/SMBotInputComponent.h"
+
+#include "EngineUtils.h"
+#include "EnhancedInputSubsystems.h"
+#include "InputAction.h"
+#include "Character/SMCharacterAssetData.h"
+#include "Character/SMPlayerCharacter.h"
+#include "Player/SMPlayerController.h"
+
+USMBotInputComponent::USMBotInputComponent()
+{
+	PrimaryComponentTick.bCanEverTick = true;
+
+	// 입력은 플레이어 컨트롤러가 입력을 처리하기 전에 주입되어야 같은 프레임에 반영됩니다.
+	PrimaryComponentTick.TickGroup = TG_PrePhysics;
+
+	bPendingJump = false;
+	bPendingCatch = false;
+}
+
+void USMBotInputComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	ASMPlayerController* PlayerController = GetOwner<ASMPlayerController>();
+	const ASMPlayerCharacter* Character = PlayerController ? Cast<ASMPlayerCharacter>(PlayerController->GetPawn()) : nullptr;
+	if (!Character || !Character->GetAssetData())
+	{
+		return;
+	}
+
+	UEnhancedInputLocalPlayerSubsystem* InputSubsystem = ULocalPlayer::GetSubsystem<UEnhancedInputLocalPlayerSubsystem>(PlayerController->GetLocalPlayer());
+	if (!InputSubsystem)
+	{
+		return;
+	}
+
+	if (GetWorld()->GetTimeSeconds() >= NextDecisionTime)
+	{
+		ChooseNextAction(Character);
+	}
+
+	// 커서가 없기 때문에 캐릭터 주변의 한 지점을 조준점으로 지정합니다.
+	PlayerController->SetAimOverride(Character->GetActorLocation() + (AimDirection * 500.0));
+
+	const USMCharacterAssetData* AssetData = Character->GetAssetData();
+
+	// 이동은 Triggered 이벤트에 바인딩되어 있기 때문에 매 프레임 주입합니다.
+	if (!MoveInput.IsZero())
+	{
+		InputSubsystem->InjectInputForAction(AssetData->MoveAction.Get(), FInputActionValue(MoveInput));
+	}
+
+	if (bPendingJump)
+	{
+		InputSubsystem->InjectInputForAction(AssetData->JumpAction.Get(), FInputActionValue(true));
+		bPendingJump = false;
+	}
+
+	// 캐릭터 회전은 캐릭터 틱에서 조준점을 따라가기 때문에 조준 방향으로 돌아선 뒤에 잡기를 시도합니다.
+	if (bPendingCatch && (Character->GetActorForwardVector() | AimDirection) > 0.95)
+	{
+		InputSubsystem->InjectInputForAction(AssetData->HoldAction.Get(), FInputActionValue(true));
+		bPendingCatch = false;
+	}
+}
+
+bool USMBotInputComponent::IsBotModeEnabled()
+{
+	static const bool bBotModeEnabled = FParse::Param(FCommandLine::Get(), TEXT("SMBot"));
+	return bBotModeEnabled;
+}
+
+float USMBotInputComponent::GetJumpChance()
+{
+	static const float JumpChance = []
+	{
+		float ParsedJumpChance = DefaultJumpChance;
+		FParse::Value(FCommandLine::Get(), TEXT("SMBotJumpChance="), ParsedJumpChance);
+		return FMath::Clamp(ParsedJumpChance, 0.0f, 1.0f);
+	}();
+	return JumpChance;
+}
+
+void USMBotInputComponent::ChooseNextAction(const ASMPlayerCharacter* InCharacter)
+{
+	NextDecisionTime = GetWorld()->GetTimeSeconds() + FMath::FRandRange(DecisionIntervalRange.X, DecisionIntervalRange.Y);
+
+	MoveInput = FMath::FRand() < 0.2f ? FVector2D::ZeroVector : FVector2D(FMath::FRandRange(-1.0, 1.0), FMath::FRandRange(-1.0, 1.0));
+	bPendingJump = FMath::FRand() < GetJumpChance();
+
+	// 잡기는 가장 가까운 캐릭터를 조준한 상태에서 시도해야 실제 플레이와 비슷한 적중률이 나옵니다.
+	const ASMPlayerCharacter* NearestCharacter = FindNearestCharacter(InCharacter);
+	if (NearestCharacter && FMath::FRand() < CatchChance)
+	{
+		AimDirection = (NearestCharacter->GetActorLocation() - InCharacter->GetActorLocation()).GetSafeNormal2D();
+		bPendingCatch = true;
+	}
+	else
+	{
+		AimDirection = FRotator(0.0, FMath::FRandRange(0.0, 360.0), 0.0).Vector();
+	}
+
+	if (AimDirection.IsZero())
+	{
+		AimDirection = FVector::ForwardVector;
+	}
+}
+
+const ASMPlayerCharacter* USMBotInputComponent::FindNearestCharacter(const ASMPlayerCharacter* InCharacter) const
+{
+	const ASMPlayerCharacter* NearestCharacter = nullptr;
+	double NearestDistanceSquared = TNumericLimits<double>::Max();
+	for (TActorIterator<ASMPlayerCharacter> It(GetWorld()); It; ++It)
+	{
+		if (*It == InCharacter)
+		{
+			continue;
+		}
+
+		const double DistanceSquared = FVector::DistSquared(It->GetActorLocation(), InCharacter->GetActorLocation());
+		if (DistanceSquared < NearestDistanceSquared)
+		{
+			NearestDistanceSquared = DistanceSquared;
+			NearestCharacter = *It;
+		}
+	}
+
+	return NearestCharacter;
+}
@@ -0,0 +1,54 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "SMBotInputComponent.generated.h"
+
+class ASMPlayerCharacter;
+
+/**
+ * 부하 테스트용 헤드리스 봇 입력입니다.
+ * 실제 플레이어와 같은 경로를 거치도록 Enhanced Input에 입력을 주입해 이동, 점프, 잡기를 수행하고, 커서 대신 에임 위치를 지정합니다.
+ */
+UCLASS()
+class STEREOMIXPROTOTYPE_API USMBotInputComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	USMBotInputComponent();
+
+public:
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	/** 커맨드라인에 -SMBot이 있으면 봇 모드로 동작합니다. */
+	static bool IsBotModeEnabled();
+
+	/** 행동을 정할 때마다 점프할 확률입니다. -SMBotJumpChance=로 바꿀 수 있으며 점프 위주의 보정 측정에 사용합니다. */
+	static float GetJumpChance();
+
+protected:
+	/** 다음 행동(이동 방향, 점프, 잡기, 조준 대상)을 무작위로 결정합니다. */
+	void ChooseNextAction(const ASMPlayerCharacter* InCharacter);
+
+	const ASMPlayerCharacter* FindNearestCharacter(const ASMPlayerCharacter* InCharacter) const;
+
+	/** 행동을 다시 결정하는 간격의 범위입니다. */
+	const FVector2D DecisionIntervalRange = FVector2D(0.5, 2.0);
+
+	static constexpr float DefaultJumpChance = 0.3f;
+
+	const float CatchChance = 0.4f;
+
+	FVector2D MoveInput = FVector2D::ZeroVector;
+
+	FVector AimDirection = FVector::ForwardVector;
+
+	float NextDecisionTime = 0.0f;
+
+	uint32 bPendingJump:1;
+
+	uint32 bPendingCatch:1;
+};
@@ -3,12 +3,203 @@
 
 #include "Player/SMPlayerController.h"
 
+#include "Character/SMPlayerCharacter.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "EngineUtils.h"
+#include "Game/SMGameMode.h"
+#include "Player/SMBotInputComponent.h"
+
 ASMPlayerController::ASMPlayerController()
 {
 	bShowMouseCursor = true;
+
+	bHasAimOverride = false;
 }
 
 void ASMPlayerController::BeginPlay()
 {
 	Super::BeginPlay();
+
+	if (IsLocalController() && USMBotInputComponent::IsBotModeEnabled())
+	{
+		BotInputComponent = NewObject<USMBotInputComponent>(this, TEXT("BotInputComponent"));
+		BotInputComponent->RegisterComponent();
+	}
+}
+
+void ASMPlayerController::PawnLeavingGame()
+{
+	ASMGameMode* GameMode = GetWorld()->GetAuthGameMode<ASMGameMode>();
+	ASMPlayerCharacter* Character = Cast<ASMPlayerCharacter>(GetPawn());
+	if (GameMode && Character)
+	{
+		GameMode->ReleaseCharacter(Character);
+		return;
+	}
+
+	Super::PawnLeavingGame();
+}
+
+const FSMAimData& ASMPlayerController::GetAimData()
+{
+	if (AimData.FrameNumber != GFrameCounter)
+	{
+		UpdateAimData();
+	}
+
+	return AimData;
+}
+
+void ASMPlayerController::UpdateAimData()
+{
+	AimData.FrameNumber = GFrameCounter;
+	AimData.bIsValid = false;
+
+	const APawn* CachedPawn = GetPawn();
+	if (!CachedPawn)
+	{
+		return;
+	}
+
+	const FVector PawnLocation = CachedPawn->GetActorLocation();
+	FVector AimLocation;
+	if (bHasAimOverride)
+	{
+		AimLocation = FVector(AimOverrideLocation.X, AimOverrideLocation.Y, PawnLocation.Z);
+	}
+	else
+	{
+		FVector WorldOrigin;
+		FVector WorldDirection;
+		if (!DeprojectMousePositionToWorld(WorldOrigin, WorldDirection))
+		{
+			return;
+		}
+
+		// 광선이 수평면과 평행하거나 평면을 등지고 있다면 교점이 없습니다.
+		if (FMath::IsNearlyZero(WorldDirection.Z))
+		{
+			return;
+		}
+
+		const double Distance = (PawnLocation.Z - WorldOrigin.Z) / WorldDirection.Z;
+		if (Distance <= 0.0)
+		{
+			return;
+		}
+
+		AimLocation = WorldOrigin + (WorldDirection * Distance);
+	}
+
+	const FVector AimDirection = (AimLocation - PawnLocation).GetSafeNormal2D();
+	if (AimDirection.IsZero())
+	{
+		return;
+	}
+
+	AimData.AimLocation = AimLocation;
+	AimData.AimDirection = AimDirection;
+	AimData.AimYaw = AimDirection.Rotation().Yaw;
+	AimData.bIsValid = true;
 }
+
+void ASMPlayerController::SetAimOverride(const FVector& InAimLocation)
+{
+	AimOverrideLocation = InAimLocation;
+	bHasAimOverride = true;
+}
+
+#if !UE_BUILD_SHIPPING
+/**
+ * 제거한 에임 평면 방식과 해석적 에임 계산의 프레임당 비용을 비교합니다. 두 방식 모두 프레임마다 한 번 실행되므로 호출당 비용이 곧 프레임당 비용입니다.
+ * 에임 평면 방식은 이전과 같이 폰에 붙은 100배 크기의 숨겨진 평면을 만들고, 평면만 가진 오브젝트 타입으로 커서 아래를 트레이스합니다.
+ * 사용법: SM.Bench.Aim [반복 횟수]
+ */
+static FAutoConsoleCommandWithWorldAndArgs SMBenchAimCommand(
+	TEXT("SM.Bench.Aim"),
+	TEXT("제거한 에임 평면 트레이스와 해석적 에임 계산의 프레임당 비용을 비교합니다. 인자: 반복 횟수(기본 10000)"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		const int32 Iterations = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 10000;
+
+		UStaticMesh* PlaneMesh = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Plane.Plane"));
+		if (!PlaneMesh)
+		{
+			UE_LOG(LogSMPlayerController, Warning, TEXT("[SM.Bench.Aim] 엔진 평면 메시를 불러오지 못했습니다."));
+			return;
+		}
+
+		// 이전 AimPlane 채널은 평면만 막았으므로, 다른 지오메트리가 쓰지 않는 오브젝트 타입을 평면에만 주고 그 타입만 트레이스합니다.
+		constexpr ECollisionChannel AimPlaneObjectType = ECC_GameTraceChannel2;
+		FCollisionObjectQueryParams AimPlaneObjectQueryParams;
+		AimPlaneObjectQueryParams.AddObjectTypesToQuery(AimPlaneObjectType);
+
+		for (TActorIterator<ASMPlayerController> It(World); It; ++It)
+		{
+			ASMPlayerController* PlayerController = *It;
+			APawn* CachedPawn = PlayerController->GetPawn();
+			if (!PlayerController->IsLocalController() || !CachedPawn)
+			{
+				continue;
+			}
+
+			UStaticMeshComponent* AimPlane = NewObject<UStaticMeshComponent>(CachedPawn, TEXT("BenchAimPlane"));
+			AimPlane->SetStaticMesh(PlaneMesh);
+			AimPlane->SetVisibility(false);
+			AimPlane->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+			AimPlane->SetCollisionObjectType(AimPlaneObjectType);
+			AimPlane->SetCollisionResponseToAllChannels(ECR_Ignore);
+			AimPlane->SetupAttachment(CachedPawn->GetRootComponent());
+			AimPlane->SetRelativeScale3D(FVector(100.0));
+			AimPlane->RegisterComponent();
+
+			const FCollisionQueryParams CollisionQueryParams(SCENE_QUERY_STAT(BenchAimPlane), false);
+			FHitResult HitResult;
+			int32 NumHits = 0;
+			const double PlaneStartTime = FPlatformTime::Seconds();
+			for (int32 i = 0; i < Iterations; ++i)
+			{
+				// GetHitResultUnderCursor와 같이 커서를 역투영한 광선을 HitResultTraceDistance만큼 트레이스합니다.
+				FVector WorldOrigin;
+				FVector WorldDirection;
+				if (PlayerController->DeprojectMousePositionToWorld(WorldOrigin, WorldDirection)
+					&& World->LineTraceSingleByObjectType(HitResult, WorldOrigin, WorldOrigin + WorldDirection * PlayerController->HitResultTraceDistance, AimPlaneObjectQueryParams, CollisionQueryParams))
+				{
+					++NumHits;
+				}
+			}
+			const double PlaneTime = FPlatformTime::Seconds() - PlaneStartTime;
+
+			AimPlane->DestroyComponent();
+
+			const double AnalyticStartTime = FPlatformTime::Seconds();
+			for (int32 i = 0; i < Iterations; ++i)
+			{
+				PlayerController->UpdateAimData();
+			}
+			const double AnalyticTime = FPlatformTime::Seconds() - AnalyticStartTime;
+
+			UE_LOG(LogSMPlayerController, Log, TEXT("[SM.Bench.Aim] %d회 - 에임 평면 트레이스(이전): %.3fus/프레임 (적중 %d회), 해석적 계산(이후): %.3fus/프레임"),
+				Iterations, PlaneTime * 1e6 / Iterations, NumHits, AnalyticTime * 1e6 / Iterations);
+		}
+	}));
+
+/** 커넥션별 Yaw 동기화 RPC 횟수와 사용 바이트를 출력합니다. */
+static FAutoConsoleCommandWithWorld SMNetYawStatsCommand(
+	TEXT("SM.Net.YawStats"),
+	TEXT("플레이어 컨트롤러(커넥션)별 Yaw 동기화 RPC 횟수와 RPC 헤더 추정치를 포함한 바이트를 출력합니다."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		const float ElapsedTime = FMath::Max(World->GetTimeSeconds(), UE_SMALL_NUMBER);
+		for (TActorIterator<ASMPlayerController> It(World); It; ++It)
+		{
+			const FSMYawSyncStats& Stats = It->GetYawSyncStats();
+			UE_LOG(LogSMPlayerController, Log, TEXT("[SM.Net.YawStats] %s - 송신: %u회 %llu바이트 (%.1f회/s), 수신: %u회 %llu바이트 (%.1f회/s), 생략: %u프레임"),
+				*It->GetName(),
+				Stats.Sent.Count, Stats.Sent.Bytes, Stats.Sent.Count / ElapsedTime,
+				Stats.Received.Count, Stats.Received.Bytes, Stats.Received.Count / ElapsedTime,
+				Stats.SkippedCount);
+		}
+	}));
+#endif
@@ -6,7 +6,54 @@
 #include "GameFramework/PlayerController.h"
 #include "SMPlayerController.generated.h"
 
+class USMBotInputComponent;
 class USMCharacterAssetData;
+
+DECLARE_LOG_CATEGORY_CLASS(LogSMPlayerController, Log, All);
+
+/** 마우스 커서로부터 계산된 에임 정보입니다. 프레임당 한 번만 갱신됩니다. */
+struct FSMAimData
+{
+	/** 커서 광선과 캐릭터 높이의 수평면이 만나는 지점입니다. */
+	FVector AimLocation = FVector::ZeroVector;
+
+	/** 캐릭터 기준으로 AimLocation을 향하는 수평 방향입니다. */
+	FVector AimDirection = FVector::ZeroVector;
+
+	float AimYaw = 0.0f;
+
+	uint64 FrameNumber = 0;
+
+	uint32 bIsValid = false;
+};
+
+/** RPC 호출 횟수와 크기(RPC 헤더 추정치 포함)를 커넥션 단위로 집계합니다. */
+struct FSMRPCStats
+{
+	void Add(uint32 InBytes)
+	{
+		++Count;
+		Bytes += InBytes;
+	}
+
+	uint32 Count = 0;
+
+	uint64 Bytes = 0;
+};
+
+/** Yaw 동기화 채널의 송수신 통계입니다. */
+struct FSMYawSyncStats
+{
+	/** 클라이언트에서 서버로 전송한 RPC입니다. */
+	FSMRPCStats Sent;
+
+	/** 서버에서 수신한 RPC입니다. */
+	FSMRPCStats Received;
+
+	/** 전송 주기 제한이나 데드밴드로 인해 전송하지 않은 프레임 수입니다. */
+	uint32 SkippedCount = 0;
+};
+
 /**
  * 
  */
@@ -17,7 +64,60 @@ class STEREOMIXPROTOTYPE_API ASMPlayerController : public APlayerController
 
 public:
 	ASMPlayerController();
-	
+
 protected:
 	virtual void BeginPlay() override;
+
+	/** 접속을 끊거나 컨트롤러가 파괴될 때 캐릭터를 파괴하지 않고 게임 모드의 풀에 반환합니다. */
+	virtual void PawnLeavingGame() override;
+
+public: // Aim Section
+	/** 이번 프레임의 에임 정보를 반환합니다. 프레임의 첫 호출에서만 계산하고 이후에는 캐싱된 값을 사용합니다. */
+	const FSMAimData& GetAimData();
+
+	/** 커서를 월드로 디프로젝트하고 캐릭터 높이의 수평면과 해석적으로 교차시켜 에임 정보를 갱신합니다. */
+	void UpdateAimData();
+
+	/** 커서 대신 지정한 월드 위치를 조준합니다. 커서가 없는 헤드리스 봇이 사용합니다. */
+	void SetAimOverride(const FVector& InAimLocation);
+
+	void ClearAimOverride() { bHasAimOverride = false; }
+
+protected:
+	FSMAimData AimData;
+
+	FVector AimOverrideLocation;
+
+	uint32 bHasAimOverride:1;
+
+protected: // Bot Section
+	/** -SMBot 커맨드라인으로 실행된 클라이언트에서만 생성됩니다. */
+	UPROPERTY()
+	TObjectPtr<USMBotInputComponent> BotInputComponent;
+
+public: // Net Stats Section
+	void RecordYawSyncSent(uint32 InBytes) { YawSyncStats.Sent.Add(InBytes); }
+
+	void RecordYawSyncReceived(uint32 InBytes) { YawSyncStats.Received.Add(InBytes); }
+
+	void RecordYawSyncSkipped() { ++YawSyncStats.SkippedCount; }
+
+	const FSMYawSyncStats& GetYawSyncStats() const { return YawSyncStats; }
+
+	void RecordCatchReceived(uint32 InBytes) { CatchReceived.Add(InBytes); }
+
+	void RecordCatchAccepted() { ++NumCatchAccepted; }
+
+	const FSMRPCStats& GetCatchReceived() const { return CatchReceived; }
+
+	uint32 GetNumCatchAccepted() const { return NumCatchAccepted; }
+
+protected:
+	FSMYawSyncStats YawSyncStats;
+
+	/** 서버에서 수신한 잡기 RPC입니다. */
+	FSMRPCStats CatchReceived;
+
+	/** 서버 검증을 통과한 잡기 횟수입니다. */
+	uint32 NumCatchAccepted = 0;
 };
@@ -0,0 +1,130 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystem/SMAssetSubsystem.h"
+
+#include "Character/SMCharacterAssetData.h"
+#include "Data/AssetPath.h"
+#include "Engine/AssetManager.h"
+
+void USMAssetSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	PostLoadMapHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(this, &USMAssetSubsystem::HandlePostLoadMapWithWorld);
+
+	RequestCharacterAssetData();
+}
+
+void USMAssetSubsystem::Deinitialize()
+{
+	FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapHandle);
+
+	if (CharacterAssetDataHandle.IsValid())
+	{
+		CharacterAssetDataHandle->CancelHandle();
+		CharacterAssetDataHandle.Reset();
+	}
+
+	OnCharacterAssetDataLoaded.Clear();
+	CharacterAssetData = nullptr;
+
+	Super::Deinitialize();
+}
+
+void USMAssetSubsystem::CallOrRegister_OnCharacterAssetDataLoaded(FSMOnCharacterAssetDataLoaded::FDelegate&& InDelegate)
+{
+	if (CharacterAssetData)
+	{
+		InDelegate.Execute(CharacterAssetData);
+		return;
+	}
+
+	OnCharacterAssetDataLoaded.Add(MoveTemp(InDelegate));
+}
+
+void USMAssetSubsystem::ReportFirstSpawnLatency(double InSpawnTime)
+{
+	if (bFirstSpawnReported)
+	{
+		return;
+	}
+
+	bFirstSpawnReported = true;
+
+	const double Now = FPlatformTime::Seconds();
+	UE_LOG(LogSMAsset, Log, TEXT("첫 캐릭터 스폰 후 에셋 데이터 준비까지 %.2fms (프로세스 시작 후 %.1fms)"), (Now - InSpawnTime) * 1000.0, (Now - GStartTime) * 1000.0);
+}
+
+void USMAssetSubsystem::RequestCharacterAssetData()
+{
+	if (CharacterAssetData || (CharacterAssetDataHandle.IsValid() && CharacterAssetDataHandle->IsLoadingInProgress()))
+	{
+		return;
+	}
+
+	UAssetManager* AssetManager = UAssetManager::GetIfInitialized();
+	if (!AssetManager)
+	{
+		return;
+	}
+
+	// 입력 에셋은 서버에서 사용되지 않으므로 데디케이티드 서버는 번들 없이 데이터 에셋만 로드합니다.
+	TArray<FName> Bundles;
+	if (!IsRunningDedicatedServer())
+	{
+		Bundles.Add(USMCharacterAssetData::ClientBundle);
+	}
+
+	LoadRequestTime = FPlatformTime::Seconds();
+
+	const FPrimaryAssetId CharacterAssetId(USMCharacterAssetData::PrimaryAssetType, CHARACTER_ASSET_NAME);
+	CharacterAssetDataHandle = AssetManager->LoadPrimaryAsset(CharacterAssetId, Bundles, FStreamableDelegate::CreateUObject(this, &USMAssetSubsystem::HandleCharacterAssetDataLoaded));
+
+	// 이미 메모리에 있는 경우 핸들 없이 끝날 수 있습니다.
+	if (!CharacterAssetDataHandle.IsValid())
+	{
+		HandleCharacterAssetDataLoaded();
+	}
+}
+
+void USMAssetSubsystem::HandleCharacterAssetDataLoaded()
+{
+	if (CharacterAssetData)
+	{
+		return;
+	}
+
+	const FPrimaryAssetId CharacterAssetId(USMCharacterAssetData::PrimaryAssetType, CHARACTER_ASSET_NAME);
+	CharacterAssetData = UAssetManager::Get().GetPrimaryAssetObject<USMCharacterAssetData>(CharacterAssetId);
+	if (!CharacterAssetData)
+	{
+		UE_LOG(LogSMAsset, Error, TEXT("캐릭터 에셋 데이터(%s)를 로드하지 못했습니다. DefaultGame.ini의 PrimaryAssetTypesToScan을 확인하세요."), *CharacterAssetId.ToString());
+		return;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	UE_LOG(LogSMAsset, Log, TEXT("캐릭터 에셋 데이터 로드 완료: 요청 후 %.2fms (프로세스 시작 후 %.1fms)"), (Now - LoadRequestTime) * 1000.0, (Now - GStartTime) * 1000.0);
+
+#if !UE_BUILD_SHIPPING
+	// 번들 없이 로드했는데 입력 에셋이 메모리에 있다면 패키지가 아직 입력 에셋을 하드 참조로 임포트하고 있는 것입니다.
+	const bool bInputAssetsLoaded = CharacterAssetData->MoveAction.Get() || CharacterAssetData->JumpAction.Get() || CharacterAssetData->HoldAction.Get() || CharacterAssetData->DefaultMappingContext.Get();
+	if (IsRunningDedicatedServer() && bInputAssetsLoaded)
+	{
+		UE_LOG(LogSMAsset, Warning, TEXT("%s가 입력 에셋을 하드 참조로 임포트하고 있습니다. Scripts/Asset/resave_character_asset.sh로 다시 저장하세요."), *GetNameSafe(CharacterAssetData->GetPackage()));
+	}
+
+	// resave_character_asset.sh가 다시 저장하기 전과 후의 시작 시간과 메모리를 비교할 때 사용합니다.
+	UE_LOG(LogSMAsset, Display, TEXT("[SM.Asset] loadMs=%.2f sinceStartMs=%.1f usedPhysicalMB=%.1f inputAssetsLoaded=%d"),
+		(Now - LoadRequestTime) * 1000.0, (Now - GStartTime) * 1000.0, FPlatformMemory::GetStats().UsedPhysical / (1024.0 * 1024.0), bInputAssetsLoaded ? 1 : 0);
+#endif
+
+	OnCharacterAssetDataLoaded.Broadcast(CharacterAssetData);
+	OnCharacterAssetDataLoaded.Clear();
+}
+
+void USMAssetSubsystem::HandlePostLoadMapWithWorld(UWorld* InLoadedWorld)
+{
+	// 이전 요청이 실패했거나 에셋 매니저가 늦게 초기화된 경우를 위해 맵을 로드할 때마다 다시 확인합니다.
+	RequestCharacterAssetData();
+}
@@ -0,0 +1,60 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "SMAssetSubsystem.generated.h"
+
+class USMCharacterAssetData;
+struct FStreamableHandle;
+
+DECLARE_LOG_CATEGORY_CLASS(LogSMAsset, Log, All);
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FSMOnCharacterAssetDataLoaded, USMCharacterAssetData* /*AssetData*/);
+
+/**
+ * 캐릭터 에셋 데이터를 에셋 매니저로 비동기 로드하고 게임 인스턴스가 살아있는 동안 유지하는 서브시스템입니다.
+ * 게임 시작과 맵 로드 시점에 로드를 요청하며, 캐릭터는 로드가 끝나면 콜백으로 에셋 데이터를 전달받기 때문에 스폰이 I/O를 기다리지 않습니다.
+ * 데디케이티드 서버는 Client 번들을 로드하지 않습니다.
+ */
+UCLASS()
+class STEREOMIXPROTOTYPE_API USMAssetSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+public:
+	/** 로드가 끝났으면 캐릭터 에셋 데이터를, 아니면 nullptr를 반환합니다. */
+	USMCharacterAssetData* GetCharacterAssetData() const { return CharacterAssetData; }
+
+	/** 이미 로드되었다면 즉시 호출하고, 아니면 로드가 끝났을 때 호출되도록 등록합니다. */
+	void CallOrRegister_OnCharacterAssetDataLoaded(FSMOnCharacterAssetDataLoaded::FDelegate&& InDelegate);
+
+	/** 캐릭터가 처음 스폰된 시점부터 에셋 데이터를 받기까지 걸린 시간을 한 번만 기록합니다. */
+	void ReportFirstSpawnLatency(double InSpawnTime);
+
+protected:
+	/** 로드 중이 아니고 아직 로드되지 않았다면 비동기 로드를 요청합니다. */
+	void RequestCharacterAssetData();
+
+	void HandleCharacterAssetDataLoaded();
+
+	void HandlePostLoadMapWithWorld(UWorld* InLoadedWorld);
+
+	UPROPERTY()
+	TObjectPtr<USMCharacterAssetData> CharacterAssetData;
+
+	TSharedPtr<FStreamableHandle> CharacterAssetDataHandle;
+
+	FSMOnCharacterAssetDataLoaded OnCharacterAssetDataLoaded;
+
+	FDelegateHandle PostLoadMapHandle;
+
+	double LoadRequestTime = 0.0;
+
+	uint32 bFirstSpawnReported = false;
+};
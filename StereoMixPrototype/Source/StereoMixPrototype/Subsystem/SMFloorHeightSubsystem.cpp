@@ -0,0 +1,610 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystem/SMFloorHeightSubsystem.h"
+
+#include "EngineUtils.h"
+#include "Data/AssetPath.h"
+#include "HAL/PlatformFileManager.h"
+#include "Log/SMPerfMetric.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+static bool GSMFloorHeightFieldEnabled = true;
+
+static FAutoConsoleVariableRef CVarSMFloorHeightFieldEnabled(
+	TEXT("SM.Floor.HeightField"),
+	GSMFloorHeightFieldEnabled,
+	TEXT("바닥 높이를 구워둔 높이 필드로 조회합니다. 끄면 항상 트레이스합니다."));
+
+static float GSMFloorTolerance = 5.0f;
+
+static FAutoConsoleVariableRef CVarSMFloorTolerance(
+	TEXT("SM.Floor.Tolerance"),
+	GSMFloorTolerance,
+	TEXT("높이 필드와 트레이스의 허용 오차(cm)입니다. 바닥이 조회 위치보다 이만큼 높으면 머리 위 지오메트리로 보고 트레이스합니다."));
+
+namespace
+{
+	/** 캐릭터 무브먼트의 기본 WalkableFloorAngle(44.765도)에 해당하는 법선의 Z입니다. 이보다 가파른 면은 바닥으로 굽지 않습니다. */
+	constexpr float WalkableFloorZ = 0.71f;
+
+	/** 칸의 격자점 높이 차가 칸 크기에 이 값을 곱한 것보다 크면 난간이나 계단 모서리로 보고 보간하지 않습니다. 45도 경사입니다. */
+	constexpr float MaxCellSlope = 1.0f;
+
+	constexpr float DefaultBakeCellSize = 50.0f;
+
+	/** 한 변 4096개, 32MB를 넘는 높이 필드는 칸 크기를 잘못 준 것으로 보고 굽지 않습니다. */
+	constexpr int64 MaxBakeSamples = 4096 * 4096;
+}
+
+void USMFloorHeightSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	const FString FilePath = GetFilePath(&InWorld);
+	if (!LoadFromFile(FilePath))
+	{
+		UE_LOG(LogSMFloorHeight, Log, TEXT("높이 필드가 없어 바닥 높이를 트레이스로 구합니다. (%s)"), *FilePath);
+	}
+
+	for (TActorIterator<AActor> It(&InWorld); It; ++It)
+	{
+		RegisterMovableFloors(*It);
+	}
+
+	ActorSpawnedHandle = InWorld.AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &USMFloorHeightSubsystem::HandleActorSpawned));
+}
+
+void USMFloorHeightSubsystem::Deinitialize()
+{
+	GetWorld()->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+	MovableFloors.Reset();
+
+	Unload();
+
+	Super::Deinitialize();
+}
+
+bool USMFloorHeightSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+bool USMFloorHeightSubsystem::IsEnabled()
+{
+	return GSMFloorHeightFieldEnabled;
+}
+
+float USMFloorHeightSubsystem::GetTolerance()
+{
+	return GSMFloorTolerance;
+}
+
+FString USMFloorHeightSubsystem::GetFilePath(const UWorld* InWorld)
+{
+	const FString MapName = UWorld::RemovePIEPrefix(InWorld->GetMapName());
+	return FPaths::ProjectContentDir() / FLOOR_HEIGHT_FIELD_DIRECTORY / MapName + TEXT(".smfh");
+}
+
+bool USMFloorHeightSubsystem::Bake(UWorld* InWorld, float InCellSize, TArray64<uint8>& OutData)
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	// 트레이스 대상이 될 수 있는 정적 지오메트리의 범위만 굽습니다.
+	FBox Bounds(ForceInit);
+	for (TActorIterator<AActor> It(InWorld); It; ++It)
+	{
+		It->ForEachComponent<UPrimitiveComponent>(false, [&Bounds](const UPrimitiveComponent* Component)
+		{
+			if (Component->Mobility == EComponentMobility::Static && Component->IsQueryCollisionEnabled() && Component->GetCollisionObjectType() == ECC_WorldStatic)
+			{
+				Bounds += Component->Bounds.GetBox();
+			}
+		});
+	}
+
+	if (!Bounds.IsValid)
+	{
+		UE_LOG(LogSMFloorHeight, Warning, TEXT("[SM.Floor.Bake] 정적 지오메트리가 없습니다."));
+		return false;
+	}
+
+	FSMFloorHeightFieldHeader BakeHeader;
+	BakeHeader.Magic = FSMFloorHeightFieldHeader::MagicValue;
+	BakeHeader.Version = FSMFloorHeightFieldHeader::CurrentVersion;
+	BakeHeader.OriginX = Bounds.Min.X;
+	BakeHeader.OriginY = Bounds.Min.Y;
+	BakeHeader.CellSize = FMath::Max(InCellSize, 1.0f);
+	BakeHeader.SizeX = FMath::CeilToInt32((Bounds.Max.X - Bounds.Min.X) / BakeHeader.CellSize) + 1;
+	BakeHeader.SizeY = FMath::CeilToInt32((Bounds.Max.Y - Bounds.Min.Y) / BakeHeader.CellSize) + 1;
+
+	const int64 NumSamples = static_cast<int64>(BakeHeader.SizeX) * BakeHeader.SizeY;
+	if (NumSamples > MaxBakeSamples)
+	{
+		UE_LOG(LogSMFloorHeight, Warning, TEXT("[SM.Floor.Bake] %dx%d개는 너무 많습니다. 칸 크기를 키워야 합니다."), BakeHeader.SizeX, BakeHeader.SizeY);
+		return false;
+	}
+
+	// 범위의 가장 높은 면도 맞도록 조금 위에서 시작합니다.
+	const double TraceStartZ = Bounds.Max.Z + 100.0;
+	const double TraceEndZ = Bounds.Min.Z - 100.0;
+	FCollisionObjectQueryParams CollisionObjectQueryParams;
+	CollisionObjectQueryParams.AddObjectTypesToQuery(ECC_WorldStatic);
+	const FCollisionQueryParams CollisionQueryParams(SCENE_QUERY_STAT(BakeFloorHeight), false);
+
+	// 먼저 실수로 굽고, 바닥의 범위를 알게 된 뒤 양자화합니다. 빈 격자점은 float의 최댓값, 동적 격자점은 최솟값으로 표시합니다.
+	TArray<float> RawHeights;
+	RawHeights.SetNumUninitialized(static_cast<int32>(NumSamples));
+	float MinHeight = TNumericLimits<float>::Max();
+	float MaxHeight = TNumericLimits<float>::Lowest();
+	int32 NumEmpty = 0;
+	int32 NumDynamic = 0;
+	FHitResult HitResult;
+	for (int32 Y = 0; Y < BakeHeader.SizeY; ++Y)
+	{
+		for (int32 X = 0; X < BakeHeader.SizeX; ++X)
+		{
+			const double SampleX = BakeHeader.OriginX + X * BakeHeader.CellSize;
+			const double SampleY = BakeHeader.OriginY + Y * BakeHeader.CellSize;
+			float& RawHeight = RawHeights[Y * BakeHeader.SizeX + X];
+
+			if (!InWorld->LineTraceSingleByObjectType(HitResult, FVector(SampleX, SampleY, TraceStartZ), FVector(SampleX, SampleY, TraceEndZ), CollisionObjectQueryParams, CollisionQueryParams))
+			{
+				RawHeight = TNumericLimits<float>::Max();
+				++NumEmpty;
+				continue;
+			}
+
+			const UPrimitiveComponent* HitComponent = HitResult.GetComponent();
+			if (!HitComponent || HitComponent->Mobility != EComponentMobility::Static)
+			{
+				RawHeight = TNumericLimits<float>::Lowest();
+				++NumDynamic;
+				continue;
+			}
+
+			// 벽 위나 가파른 경사는 런타임에 트레이스하도록 비워둡니다.
+			if (HitResult.ImpactNormal.Z < WalkableFloorZ)
+			{
+				RawHeight = TNumericLimits<float>::Max();
+				++NumEmpty;
+				continue;
+			}
+
+			RawHeight = static_cast<float>(HitResult.ImpactPoint.Z);
+			MinHeight = FMath::Min(MinHeight, RawHeight);
+			MaxHeight = FMath::Max(MaxHeight, RawHeight);
+		}
+	}
+
+	if (MinHeight > MaxHeight)
+	{
+		UE_LOG(LogSMFloorHeight, Warning, TEXT("[SM.Floor.Bake] 걸을 수 있는 정적 바닥이 없습니다."));
+		return false;
+	}
+
+	BakeHeader.MinHeight = MinHeight;
+	BakeHeader.HeightStep = FMath::Max((MaxHeight - MinHeight) / MaxHeightValue, 0.01f);
+
+	OutData.SetNumUninitialized(sizeof(FSMFloorHeightFieldHeader) + NumSamples * sizeof(uint16));
+	FMemory::Memcpy(OutData.GetData(), &BakeHeader, sizeof(FSMFloorHeightFieldHeader));
+	uint16* BakedHeights = reinterpret_cast<uint16*>(OutData.GetData() + sizeof(FSMFloorHeightFieldHeader));
+	for (int64 SampleIndex = 0; SampleIndex < NumSamples; ++SampleIndex)
+	{
+		const float RawHeight = RawHeights[SampleIndex];
+		if (RawHeight == TNumericLimits<float>::Max())
+		{
+			BakedHeights[SampleIndex] = EmptyHeight;
+		}
+		else if (RawHeight == TNumericLimits<float>::Lowest())
+		{
+			BakedHeights[SampleIndex] = DynamicHeight;
+		}
+		else
+		{
+			BakedHeights[SampleIndex] = static_cast<uint16>(FMath::Clamp(FMath::RoundToInt32((RawHeight - MinHeight) / BakeHeader.HeightStep), 0, static_cast<int32>(MaxHeightValue)));
+		}
+	}
+
+	UE_LOG(LogSMFloorHeight, Log, TEXT("[SM.Floor.Bake] %dx%d개 (%.0fcm 간격), 바닥 없음 %d개, 동적 %d개, 높이 %.0f~%.0fcm (%.3fcm 단위), %lldKB, %.1fs"),
+		BakeHeader.SizeX, BakeHeader.SizeY, BakeHeader.CellSize, NumEmpty, NumDynamic, MinHeight, MaxHeight, BakeHeader.HeightStep,
+		OutData.Num() / 1024, FPlatformTime::Seconds() - StartTime);
+	return true;
+}
+
+bool USMFloorHeightSubsystem::LoadFromFile(const FString& InFilePath)
+{
+	Unload();
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	if (!PlatformFile.FileExists(*InFilePath))
+	{
+		return false;
+	}
+
+	MappedFile.Reset(PlatformFile.OpenMapped(*InFilePath));
+	if (MappedFile)
+	{
+		MappedRegion.Reset(MappedFile->MapRegion());
+	}
+
+	if (MappedRegion && SetData(MappedRegion->GetMappedPtr(), MappedRegion->GetMappedSize()))
+	{
+		UE_LOG(LogSMFloorHeight, Log, TEXT("높이 필드를 메모리 맵으로 열었습니다. %dx%d개 (%s)"), Header.SizeX, Header.SizeY, *InFilePath);
+		return true;
+	}
+
+	MappedRegion.Reset();
+	MappedFile.Reset();
+
+	TArray64<uint8> Data;
+	if (!FFileHelper::LoadFileToArray(Data, *InFilePath) || !LoadFromData(MoveTemp(Data)))
+	{
+		UE_LOG(LogSMFloorHeight, Warning, TEXT("높이 필드 파일이 올바르지 않습니다. SM.Floor.Bake로 다시 구워야 합니다. (%s)"), *InFilePath);
+		return false;
+	}
+
+	UE_LOG(LogSMFloorHeight, Log, TEXT("높이 필드를 읽었습니다. %dx%d개 (%s)"), Header.SizeX, Header.SizeY, *InFilePath);
+	return true;
+}
+
+bool USMFloorHeightSubsystem::LoadFromData(TArray64<uint8>&& InData)
+{
+	Unload();
+
+	LoadedData = MoveTemp(InData);
+	if (!SetData(LoadedData.GetData(), LoadedData.Num()))
+	{
+		Unload();
+		return false;
+	}
+
+	return true;
+}
+
+void USMFloorHeightSubsystem::Unload()
+{
+	Heights = nullptr;
+	Header = FSMFloorHeightFieldHeader();
+
+	// 영역은 파일보다 먼저 닫아야 합니다.
+	MappedRegion.Reset();
+	MappedFile.Reset();
+	LoadedData.Empty();
+}
+
+bool USMFloorHeightSubsystem::SetData(const uint8* InData, int64 InSize)
+{
+	if (!InData || InSize < static_cast<int64>(sizeof(FSMFloorHeightFieldHeader)))
+	{
+		return false;
+	}
+
+	FSMFloorHeightFieldHeader NewHeader;
+	FMemory::Memcpy(&NewHeader, InData, sizeof(FSMFloorHeightFieldHeader));
+	if (NewHeader.Magic != FSMFloorHeightFieldHeader::MagicValue || NewHeader.Version != FSMFloorHeightFieldHeader::CurrentVersion
+		|| NewHeader.SizeX < 2 || NewHeader.SizeY < 2 || NewHeader.CellSize <= 0.0f || NewHeader.HeightStep <= 0.0f)
+	{
+		return false;
+	}
+
+	const int64 NumSamples = static_cast<int64>(NewHeader.SizeX) * NewHeader.SizeY;
+	if (InSize < static_cast<int64>(sizeof(FSMFloorHeightFieldHeader)) + NumSamples * static_cast<int64>(sizeof(uint16)))
+	{
+		return false;
+	}
+
+	Header = NewHeader;
+	Heights = reinterpret_cast<const uint16*>(InData + sizeof(FSMFloorHeightFieldHeader));
+	return true;
+}
+
+void USMFloorHeightSubsystem::RegisterMovableFloors(const AActor* InActor)
+{
+	InActor->ForEachComponent<UPrimitiveComponent>(false, [this](const UPrimitiveComponent* Component)
+	{
+		if (Component->Mobility != EComponentMobility::Static && Component->IsQueryCollisionEnabled() && Component->GetCollisionObjectType() == ECC_WorldStatic)
+		{
+			MovableFloors.Add(Component);
+		}
+	});
+}
+
+void USMFloorHeightSubsystem::HandleActorSpawned(AActor* InActor)
+{
+	MovableFloors.RemoveAllSwap([](const TWeakObjectPtr<const UPrimitiveComponent>& MovableFloor) { return !MovableFloor.IsValid(); });
+	RegisterMovableFloors(InActor);
+}
+
+bool USMFloorHeightSubsystem::IsMovableFloorBelow(const FVector& InLocation, float InFloorHeight) const
+{
+	for (const TWeakObjectPtr<const UPrimitiveComponent>& MovableFloor : MovableFloors)
+	{
+		const UPrimitiveComponent* Component = MovableFloor.Get();
+		if (!Component || !Component->IsQueryCollisionEnabled())
+		{
+			continue;
+		}
+
+		const FBox Box = Component->Bounds.GetBox();
+		if (InLocation.X >= Box.Min.X && InLocation.X <= Box.Max.X && InLocation.Y >= Box.Min.Y && InLocation.Y <= Box.Max.Y
+			&& Box.Min.Z <= InLocation.Z && Box.Max.Z >= InFloorHeight - GSMFloorTolerance)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool USMFloorHeightSubsystem::SampleFloorHeight(const FVector& InLocation, float& OutFloorHeight)
+{
+	++Stats.NumSamples;
+
+	if (!Heights)
+	{
+		++Stats.NumFallbacks;
+		return false;
+	}
+
+	const double GridX = (InLocation.X - Header.OriginX) / Header.CellSize;
+	const double GridY = (InLocation.Y - Header.OriginY) / Header.CellSize;
+	const int32 X0 = FMath::FloorToInt32(GridX);
+	const int32 Y0 = FMath::FloorToInt32(GridY);
+	if (X0 < 0 || Y0 < 0 || X0 + 1 >= Header.SizeX || Y0 + 1 >= Header.SizeY)
+	{
+		++Stats.NumFallbacks;
+		return false;
+	}
+
+	const int32 Index00 = Y0 * Header.SizeX + X0;
+	const uint16 Height00 = Heights[Index00];
+	const uint16 Height10 = Heights[Index00 + 1];
+	const uint16 Height01 = Heights[Index00 + Header.SizeX];
+	const uint16 Height11 = Heights[Index00 + Header.SizeX + 1];
+
+	// 빈 격자점과 동적 격자점은 MaxHeightValue보다 큽니다.
+	const uint16 MaxCorner = FMath::Max(FMath::Max(Height00, Height10), FMath::Max(Height01, Height11));
+	const uint16 MinCorner = FMath::Min(FMath::Min(Height00, Height10), FMath::Min(Height01, Height11));
+	if (MaxCorner > MaxHeightValue || (MaxCorner - MinCorner) * Header.HeightStep > Header.CellSize * MaxCellSlope)
+	{
+		++Stats.NumFallbacks;
+		return false;
+	}
+
+	const float Height = FMath::BiLerp<float>(Height00, Height10, Height01, Height11, static_cast<float>(GridX - X0), static_cast<float>(GridY - Y0));
+	const float FloorHeight = Header.MinHeight + Height * Header.HeightStep;
+
+	// 높이 필드는 가장 위의 바닥이므로 다리 아래처럼 조회 위치보다 높다면 트레이스가 맞출 바닥과 다릅니다.
+	if (FloorHeight > InLocation.Z + GSMFloorTolerance)
+	{
+		++Stats.NumFallbacks;
+		return false;
+	}
+
+	// 굽지 않은 발판이 구운 바닥 위로 움직여 왔다면 트레이스는 발판을 맞춥니다.
+	if (MovableFloors.Num() > 0 && IsMovableFloorBelow(InLocation, FloorHeight))
+	{
+		++Stats.NumFallbacks;
+		++Stats.NumMovableFloorFallbacks;
+		return false;
+	}
+
+	OutFloorHeight = FloorHeight;
+	return true;
+}
+
+void USMFloorHeightSubsystem::PrintReport() const
+{
+	UE_LOG(LogSMFloorHeight, Log, TEXT("[SM.Floor] %s, 높이 필드 %s - 조회 %llu회, 트레이스로 대신함 %llu회 (%.1f%%, 움직이는 바닥 %llu회, 움직이는 바닥 %d개)"),
+		IsEnabled() ? TEXT("켜짐") : TEXT("꺼짐"), IsLoaded() ? TEXT("있음") : TEXT("없음"), Stats.NumSamples, Stats.NumFallbacks,
+		Stats.NumSamples > 0 ? 100.0 * Stats.NumFallbacks / Stats.NumSamples : 0.0, Stats.NumMovableFloorFallbacks, MovableFloors.Num());
+}
+
+static FAutoConsoleCommandWithWorldAndArgs SMFloorReportCommand(
+	TEXT("SM.Floor.Report"),
+	TEXT("높이 필드 조회 수와 트레이스로 대신한 비율을 출력합니다. 인자로 reset을 주면 통계를 초기화합니다."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		USMFloorHeightSubsystem* FloorHeightSubsystem = World ? World->GetSubsystem<USMFloorHeightSubsystem>() : nullptr;
+		if (!FloorHeightSubsystem)
+		{
+			return;
+		}
+
+		if (Args.Num() > 0 && Args[0] == TEXT("reset"))
+		{
+			FloorHeightSubsystem->ResetStats();
+			return;
+		}
+
+		FloorHeightSubsystem->PrintReport();
+	}));
+
+#if !UE_BUILD_SHIPPING
+/**
+ * 현재 맵의 높이 필드를 굽고 콘텐츠 폴더에 저장한 뒤 다시 불러옵니다. 맵의 정적 지오메트리를 바꿨다면 다시 구워 함께 커밋합니다.
+ * 사용법: SM.Floor.Bake [칸 크기(cm), 기본 50]
+ */
+static FAutoConsoleCommandWithWorldAndArgs SMFloorBakeCommand(
+	TEXT("SM.Floor.Bake"),
+	TEXT("현재 맵의 정적 지오메트리로 바닥 높이 필드를 굽고 저장합니다. 인자: 칸 크기(cm, 기본 50)"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		USMFloorHeightSubsystem* FloorHeightSubsystem = World ? World->GetSubsystem<USMFloorHeightSubsystem>() : nullptr;
+		if (!FloorHeightSubsystem)
+		{
+			UE_LOG(LogSMFloorHeight, Warning, TEXT("[SM.Floor.Bake] 게임 월드에서만 실행할 수 있습니다."));
+			return;
+		}
+
+		const float CellSize = Args.Num() > 0 ? FMath::Max(1.0f, FCString::Atof(*Args[0])) : DefaultBakeCellSize;
+		TArray64<uint8> Data;
+		if (!USMFloorHeightSubsystem::Bake(World, CellSize, Data))
+		{
+			return;
+		}
+
+		const FString FilePath = USMFloorHeightSubsystem::GetFilePath(World);
+		IFileManager::Get().MakeDirectory(*FPaths::GetPath(FilePath), true);
+		if (!FFileHelper::SaveArrayToFile(Data, *FilePath))
+		{
+			UE_LOG(LogSMFloorHeight, Warning, TEXT("[SM.Floor.Bake] 저장하지 못했습니다. (%s)"), *FilePath);
+			return;
+		}
+
+		UE_LOG(LogSMFloorHeight, Log, TEXT("[SM.Floor.Bake] 저장했습니다. (%s)"), *FilePath);
+		FloorHeightSubsystem->LoadFromFile(FilePath);
+	}));
+
+/**
+ * 높이 필드 범위 안의 임의의 바닥 위, 캐릭터 발 높이에서 아래로 트레이스한 바닥과 높이 필드를 비교합니다.
+ * 바닥은 각 위치의 기둥에 겹쳐 있는 걸을 수 있는 면(다리 위, 다리 아래 등) 중 하나를 고르며, 발 높이는 점프를 고려해 바닥 위 0~MaxFootHeight 사이입니다.
+ * 높이 필드로 답한 위치 중 허용 오차(SM.Floor.Tolerance)를 넘은 비율과 트레이스로 대신한 비율, 호출당 비용을 출력합니다. 오차의 평균과 최대는 허용 오차를 넘은 위치도 포함합니다.
+ * 맵에 구운 파일이 없다면 메모리에서 구워 측정합니다.
+ * 사용법: SM.Bench.FloorHeight [샘플 수]
+ */
+static FAutoConsoleCommandWithWorldAndArgs SMBenchFloorHeightCommand(
+	TEXT("SM.Bench.FloorHeight"),
+	TEXT("임의의 위치에서 높이 필드 조회와 바닥 트레이스의 비용과 오차를 비교합니다. 인자: 샘플 수(기본 10000)"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		USMFloorHeightSubsystem* FloorHeightSubsystem = World ? World->GetSubsystem<USMFloorHeightSubsystem>() : nullptr;
+		if (!FloorHeightSubsystem)
+		{
+			UE_LOG(LogSMFloorHeight, Warning, TEXT("[SM.Bench.FloorHeight] 게임 월드에서만 실행할 수 있습니다."));
+			return;
+		}
+
+		if (!FloorHeightSubsystem->IsLoaded())
+		{
+			UE_LOG(LogSMFloorHeight, Warning, TEXT("[SM.Bench.FloorHeight] 구운 높이 필드가 없어 메모리에서 구워 측정합니다. SM.Floor.Bake로 저장해야 런타임에 사용됩니다."));
+			TArray64<uint8> Data;
+			if (!USMFloorHeightSubsystem::Bake(World, DefaultBakeCellSize, Data) || !FloorHeightSubsystem->LoadFromData(MoveTemp(Data)))
+			{
+				return;
+			}
+		}
+
+		const int32 NumSamples = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 10000;
+		const FSMFloorHeightFieldHeader& Header = FloorHeightSubsystem->GetHeader();
+		const double TraceStartZ = Header.MinHeight + USMFloorHeightSubsystem::MaxHeightValue * Header.HeightStep + 100.0;
+		const double TraceEndZ = Header.MinHeight - 100.0;
+
+		// DistanceHeightFromFloor의 트레이스와 같은 조건입니다.
+		FCollisionObjectQueryParams CollisionObjectQueryParams;
+		CollisionObjectQueryParams.AddObjectTypesToQuery(ECC_WorldStatic);
+		const FCollisionQueryParams CollisionQueryParams(SCENE_QUERY_STAT(DistanceHeigh), false);
+
+		// 위치마다 위에서부터 겹쳐 있는 바닥을 찾아 그중 하나의 위, 발 높이에서 조회합니다. 위쪽 바닥만 고르면 다리 아래에서 트레이스로 대신하는 경우를 측정하지 못합니다.
+		constexpr int32 MaxFloorsPerColumn = 4;
+		constexpr double MaxFootHeight = 200.0;
+		FRandomStream RandomStream(1234);
+		TArray<FVector> Locations;
+		Locations.Reserve(NumSamples);
+		TArray<double, TInlineAllocator<MaxFloorsPerColumn>> ColumnFloors;
+		FHitResult HitResult;
+		int32 NumColumns = 0;
+		while (Locations.Num() < NumSamples && NumColumns < NumSamples * 4)
+		{
+			++NumColumns;
+			const double SampleX = Header.OriginX + RandomStream.FRandRange(0.0, (Header.SizeX - 1) * Header.CellSize);
+			const double SampleY = Header.OriginY + RandomStream.FRandRange(0.0, (Header.SizeY - 1) * Header.CellSize);
+
+			ColumnFloors.Reset();
+			double StartZ = TraceStartZ;
+			int32 NumColumnTraces = 0;
+			while (ColumnFloors.Num() < MaxFloorsPerColumn && NumColumnTraces++ < MaxFloorsPerColumn * 2
+				&& World->LineTraceSingleByObjectType(HitResult, FVector(SampleX, SampleY, StartZ), FVector(SampleX, SampleY, TraceEndZ), CollisionObjectQueryParams, CollisionQueryParams))
+			{
+				if (HitResult.ImpactNormal.Z >= WalkableFloorZ)
+				{
+					ColumnFloors.Add(HitResult.ImpactPoint.Z);
+				}
+
+				// 맞은 면 아래에서 다시 트레이스해 그 아래의 바닥을 찾습니다.
+				StartZ = HitResult.ImpactPoint.Z - 10.0;
+			}
+
+			if (ColumnFloors.Num() == 0)
+			{
+				continue;
+			}
+
+			const double FloorZ = ColumnFloors[RandomStream.RandRange(0, ColumnFloors.Num() - 1)];
+			Locations.Emplace(SampleX, SampleY, FloorZ + RandomStream.FRandRange(1.0, MaxFootHeight));
+		}
+
+		if (Locations.Num() == 0)
+		{
+			UE_LOG(LogSMFloorHeight, Warning, TEXT("[SM.Bench.FloorHeight] 높이 필드 범위에서 걸을 수 있는 바닥을 찾지 못했습니다."));
+			return;
+		}
+
+		const int32 NumLocations = Locations.Num();
+		TArray<float> TraceHeights;
+		TraceHeights.SetNumUninitialized(NumLocations);
+		double StartTime = FPlatformTime::Seconds();
+		for (int32 i = 0; i < NumLocations; ++i)
+		{
+			const FVector End(Locations[i].X, Locations[i].Y, TraceEndZ);
+			const bool bHit = World->LineTraceSingleByObjectType(HitResult, Locations[i], End, CollisionObjectQueryParams, CollisionQueryParams);
+			TraceHeights[i] = bHit ? static_cast<float>(HitResult.ImpactPoint.Z) : TNumericLimits<float>::Lowest();
+		}
+		const double TraceTime = FPlatformTime::Seconds() - StartTime;
+
+		TArray<float> FieldHeights;
+		FieldHeights.SetNumUninitialized(NumLocations);
+		StartTime = FPlatformTime::Seconds();
+		for (int32 i = 0; i < NumLocations; ++i)
+		{
+			float FloorHeight;
+			FieldHeights[i] = FloorHeightSubsystem->SampleFloorHeight(Locations[i], FloorHeight) ? FloorHeight : TNumericLimits<float>::Max();
+		}
+		const double SampleTime = FPlatformTime::Seconds() - StartTime;
+
+		// 오차의 평균과 최대는 허용 오차를 넘은 위치도 포함합니다. 트레이스가 바닥을 찾지 못한 위치는 오차를 정할 수 없으므로 따로 셉니다.
+		int32 NumAnswered = 0;
+		int32 NumOutOfTolerance = 0;
+		int32 NumMissingFloor = 0;
+		float MaxError = 0.0f;
+		double TotalError = 0.0;
+		for (int32 i = 0; i < NumLocations; ++i)
+		{
+			if (FieldHeights[i] == TNumericLimits<float>::Max())
+			{
+				continue;
+			}
+
+			++NumAnswered;
+
+			if (TraceHeights[i] == TNumericLimits<float>::Lowest())
+			{
+				++NumMissingFloor;
+				++NumOutOfTolerance;
+				continue;
+			}
+
+			const float Error = FMath::Abs(FieldHeights[i] - TraceHeights[i]);
+			if (Error > USMFloorHeightSubsystem::GetTolerance())
+			{
+				++NumOutOfTolerance;
+			}
+
+			MaxError = FMath::Max(MaxError, Error);
+			TotalError += Error;
+		}
+
+		const int32 NumMeasured = NumAnswered - NumMissingFloor;
+		const double OutOfTolerancePercent = NumAnswered > 0 ? 100.0 * NumOutOfTolerance / NumAnswered : 0.0;
+		const double FallbackPercent = 100.0 * (NumLocations - NumAnswered) / NumLocations;
+		UE_LOG(LogSMFloorHeight, Log, TEXT("[SM.Bench.FloorHeight] %d회 - 트레이스 %.3fus/회, 높이 필드 %.1fns/회, 트레이스로 대신함 %.1f%%, 허용 오차(%.1fcm) 초과 %.2f%% (바닥 없음 %d회), 오차 평균 %.2fcm, 최대 %.2fcm"),
+			NumLocations, TraceTime * 1e6 / NumLocations, SampleTime * 1e9 / NumLocations, FallbackPercent, USMFloorHeightSubsystem::GetTolerance(),
+			OutOfTolerancePercent, NumMissingFloor, NumMeasured > 0 ? TotalError / NumMeasured : 0.0, MaxError);
+		SM_PERF_METRIC(TEXT("floor.traceUs"), TraceTime * 1e6 / NumLocations);
+		SM_PERF_METRIC(TEXT("floor.sampleNs"), SampleTime * 1e9 / NumLocations);
+		SM_PERF_METRIC(TEXT("floor.fallbackPct"), FallbackPercent);
+		SM_PERF_METRIC(TEXT("floor.outOfTolerancePct"), OutOfTolerancePercent);
+	}));
+#endif
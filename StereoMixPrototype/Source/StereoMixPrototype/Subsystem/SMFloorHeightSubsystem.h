@@ -0,0 +1,158 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/MappedFileHandle.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SMFloorHeightSubsystem.generated.h"
+
+DECLARE_LOG_CATEGORY_CLASS(LogSMFloorHeight, Log, All);
+
+/**
+ * 높이 필드 파일의 헤더입니다. 헤더 뒤에 SizeX * SizeY개의 uint16 높이가 행 우선으로 이어집니다.
+ * 높이는 MinHeight + 값 * HeightStep이며 EmptyHeight, DynamicHeight는 특수 값입니다.
+ */
+struct FSMFloorHeightFieldHeader
+{
+	uint32 Magic = 0;
+
+	uint32 Version = 0;
+
+	/** 첫 번째 샘플의 XY 위치입니다. 샘플은 CellSize 간격의 격자점에 있습니다. */
+	double OriginX = 0.0;
+
+	double OriginY = 0.0;
+
+	float CellSize = 0.0f;
+
+	int32 SizeX = 0;
+
+	int32 SizeY = 0;
+
+	float MinHeight = 0.0f;
+
+	float HeightStep = 0.0f;
+
+	uint32 Reserved = 0;
+
+	static constexpr uint32 MagicValue = 0x48464D53; // 'SMFH'
+
+	static constexpr uint32 CurrentVersion = 1;
+};
+
+static_assert(sizeof(FSMFloorHeightFieldHeader) == 48, "높이 필드 파일 형식이 바뀌었다면 CurrentVersion을 올려야 합니다.");
+
+/** 높이 필드 조회 통계입니다. SM.Floor.Report로 출력합니다. */
+struct FSMFloorHeightStats
+{
+	uint64 NumSamples = 0;
+
+	/** 높이 필드로 답하지 못해 트레이스로 대신한 조회 수입니다. */
+	uint64 NumFallbacks = 0;
+
+	/** 그중 움직이는 바닥이 조회 위치 아래에 있어 트레이스로 대신한 조회 수입니다. */
+	uint64 NumMovableFloorFallbacks = 0;
+};
+
+/**
+ * 맵의 정적 지오메트리를 미리 구워둔 2D 높이 필드로 바닥 높이를 O(1)에 조회하는 서브시스템입니다.
+ * SM.Floor.Bake로 맵마다 FLOOR_HEIGHT_FIELD_DIRECTORY에 파일을 만들고, 런타임에는 월드 시작 시 파일을 메모리 맵으로 열어
+ * 격자점 네 개를 이선형 보간합니다. 파일은 패키징 시 pak 밖에 그대로 스테이징되므로 메모리 맵을 지원하는 플랫폼에서는 읽어 들이지 않습니다.
+ *
+ * 굽는 동안 정적이 아닌 지오메트리가 먼저 맞은 격자점은 동적으로 표시하며, 동적이거나 빈 격자점이 포함된 칸,
+ * 격자점의 높이 차가 커서 보간이 부정확한 칸(난간, 계단 모서리)에서는 false를 반환하므로 호출하는 쪽은 실제 트레이스를 사용해야 합니다.
+ * 굽지 않은 위치로 움직이는 WorldStatic 바닥(이동하는 발판)은 런타임에 범위를 확인해 조회 위치 아래에 있다면 마찬가지로 false를 반환합니다.
+ *
+ * SM.Floor.HeightField 0           높이 필드를 사용하지 않고 항상 트레이스합니다.
+ * SM.Floor.Tolerance               높이 필드와 트레이스의 허용 오차(cm)입니다. 벤치마크의 판정 기준입니다.
+ * SM.Floor.Bake [칸 크기]          현재 맵의 높이 필드를 굽고 파일로 저장한 뒤 다시 불러옵니다.
+ * SM.Floor.Report [reset]          조회 수와 트레이스로 대신한 비율을 출력합니다.
+ * SM.Bench.FloorHeight [샘플 수]   임의의 위치에서 높이 필드와 트레이스의 비용과 오차를 비교합니다.
+ */
+UCLASS()
+class STEREOMIXPROTOTYPE_API USMFloorHeightSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	virtual void Deinitialize() override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+public:
+	static bool IsEnabled();
+
+	static float GetTolerance();
+
+	/** 맵의 높이 필드 파일 경로입니다. */
+	static FString GetFilePath(const UWorld* InWorld);
+
+	/**
+	 * InWorld의 정적 지오메트리를 InCellSize 간격으로 위에서 아래로 트레이스해 높이 필드 파일의 내용을 만듭니다.
+	 * 트레이스는 DistanceHeightFromFloor와 같이 ECC_WorldStatic 오브젝트를 대상으로 합니다.
+	 */
+	static bool Bake(UWorld* InWorld, float InCellSize, TArray64<uint8>& OutData);
+
+	/** 파일을 메모리 맵으로 엽니다. 메모리 맵을 지원하지 않는 플랫폼에서는 파일 전체를 읽습니다. */
+	bool LoadFromFile(const FString& InFilePath);
+
+	/** 메모리에 있는 높이 필드를 사용합니다. 굽기 직후나 파일이 없는 맵의 벤치마크에서 사용합니다. */
+	bool LoadFromData(TArray64<uint8>&& InData);
+
+	void Unload();
+
+	bool IsLoaded() const { return Heights != nullptr; }
+
+	const FSMFloorHeightFieldHeader& GetHeader() const { return Header; }
+
+	/** 높이 필드로 InLocation 아래 바닥의 높이를 구합니다. 답할 수 없는 위치라면 false를 반환하며 트레이스로 대신한 것으로 기록합니다. */
+	bool SampleFloorHeight(const FVector& InLocation, float& OutFloorHeight);
+
+	const FSMFloorHeightStats& GetStats() const { return Stats; }
+
+	void ResetStats() { Stats = FSMFloorHeightStats(); }
+
+	void PrintReport() const;
+
+	/** 바닥이 없는 격자점입니다. */
+	static constexpr uint16 EmptyHeight = 0xFFFF;
+
+	/** 정적이 아닌 지오메트리가 먼저 맞은 격자점입니다. */
+	static constexpr uint16 DynamicHeight = 0xFFFE;
+
+	static constexpr uint16 MaxHeightValue = 0xFFFD;
+
+protected:
+	/** InData가 올바른 높이 필드인지 확인하고 헤더와 높이 배열을 가리킵니다. */
+	bool SetData(const uint8* InData, int64 InSize);
+
+	/** DistanceHeightFromFloor의 트레이스가 맞출 수 있지만 굽지 않은, 정적이 아닌 WorldStatic 컴포넌트를 등록합니다. */
+	void RegisterMovableFloors(const AActor* InActor);
+
+	void HandleActorSpawned(AActor* InActor);
+
+	/** 움직이는 바닥이 InLocation과 InFloorHeight 사이의 기둥에 걸쳐 있는지 확인합니다. */
+	bool IsMovableFloorBelow(const FVector& InLocation, float InFloorHeight) const;
+
+	TArray<TWeakObjectPtr<const UPrimitiveComponent>> MovableFloors;
+
+	FDelegateHandle ActorSpawnedHandle;
+
+	TUniquePtr<IMappedFileHandle> MappedFile;
+
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+
+	/** 메모리 맵을 사용하지 않을 때의 데이터입니다. */
+	TArray64<uint8> LoadedData;
+
+	FSMFloorHeightFieldHeader Header;
+
+	/** MappedRegion이나 LoadedData 안의 높이 배열입니다. */
+	const uint16* Heights = nullptr;
+
+	FSMFloorHeightStats Stats;
+};
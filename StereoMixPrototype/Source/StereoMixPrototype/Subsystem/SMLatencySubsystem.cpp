@@ -0,0 +1,260 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystem/SMLatencySubsystem.h"
+
+#include "Dom/JsonObject.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+#if !UE_BUILD_SHIPPING
+static bool GSMLatencyEnabled = false;
+
+static FAutoConsoleVariableRef CVarSMLatencyEnabled(
+	TEXT("SM.Latency"),
+	GSMLatencyEnabled,
+	TEXT("입력부터 서버 적용, 응답 수신까지의 지연 시간을 기록합니다. -SMLatency 또는 -SMLatencyReport로 실행하면 켜집니다."));
+
+static float GSMLatencyExportInterval = 10.0f;
+
+static FAutoConsoleVariableRef CVarSMLatencyExportInterval(
+	TEXT("SM.Latency.ExportInterval"),
+	GSMLatencyExportInterval,
+	TEXT("-SMLatencyReport가 지정된 경우 이 주기(초)마다 결과 JSON을 다시 기록합니다. 0이면 월드 종료 시에만 기록합니다."));
+#else
+static constexpr bool GSMLatencyEnabled = false;
+
+static constexpr float GSMLatencyExportInterval = 0.0f;
+#endif
+
+namespace
+{
+	const TCHAR* const ActionNames[] =
+	{
+#define SM_LATENCY_ACTION_NAME(Name) TEXT(#Name),
+		SM_LATENCY_ACTION_LIST(SM_LATENCY_ACTION_NAME)
+#undef SM_LATENCY_ACTION_NAME
+	};
+
+	const TCHAR* const StageNames[] =
+	{
+#define SM_LATENCY_STAGE_NAME(Name, Description) TEXT(#Name),
+		SM_LATENCY_STAGE_LIST(SM_LATENCY_STAGE_NAME)
+#undef SM_LATENCY_STAGE_NAME
+	};
+
+	const TCHAR* const StageDescriptions[] =
+	{
+#define SM_LATENCY_STAGE_DESCRIPTION(Name, Description) TEXT(Description),
+		SM_LATENCY_STAGE_LIST(SM_LATENCY_STAGE_DESCRIPTION)
+#undef SM_LATENCY_STAGE_DESCRIPTION
+	};
+}
+
+void FSMLatencyHistogram::Add(double InMilliseconds)
+{
+	const double Milliseconds = FMath::Max(InMilliseconds, 0.0);
+	const int32 BucketIndex = FMath::Min(FMath::FloorToInt32(Milliseconds / BucketWidthMs), NumBuckets - 1);
+	++Buckets[BucketIndex];
+	++Count;
+	Sum += Milliseconds;
+	Max = FMath::Max(Max, Milliseconds);
+}
+
+double FSMLatencyHistogram::GetPercentile(double InPercentile) const
+{
+	if (Count == 0)
+	{
+		return 0.0;
+	}
+
+	const uint64 TargetCount = FMath::Max<uint64>(FMath::CeilToInt64(InPercentile * Count), 1);
+	uint64 AccumulatedCount = 0;
+	for (int32 i = 0; i < NumBuckets; ++i)
+	{
+		AccumulatedCount += Buckets[i];
+		if (AccumulatedCount >= TargetCount)
+		{
+			// 범위를 넘는 샘플이 담긴 마지막 버킷은 최대값으로 대신합니다.
+			return i == NumBuckets - 1 ? Max : FMath::Min((i + 1) * BucketWidthMs, Max);
+		}
+	}
+
+	return Max;
+}
+
+bool USMLatencySubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	// 입력마다 타임스탬프를 남기고 히스토그램을 유지하는 비용이 있으므로 배포 빌드에서는 만들지 않습니다.
+	return !UE_BUILD_SHIPPING && Super::ShouldCreateSubsystem(Outer);
+}
+
+void USMLatencySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+#if !UE_BUILD_SHIPPING
+	FParse::Value(FCommandLine::Get(), TEXT("SMLatencyReport="), ReportPath);
+	if (!ReportPath.IsEmpty() || FParse::Param(FCommandLine::Get(), TEXT("SMLatency")))
+	{
+		GSMLatencyEnabled = true;
+	}
+#endif
+	LastExportTime = FPlatformTime::Seconds();
+}
+
+void USMLatencySubsystem::Deinitialize()
+{
+	if (!ReportPath.IsEmpty())
+	{
+		WriteReport();
+	}
+
+	Super::Deinitialize();
+}
+
+void USMLatencySubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (ReportPath.IsEmpty() || GSMLatencyExportInterval <= 0.0f)
+	{
+		return;
+	}
+
+	// 헤드리스 클라이언트는 종료 신호로 끝나는 경우가 있어 주기적으로 덮어씁니다.
+	const double CurrentTime = FPlatformTime::Seconds();
+	if (CurrentTime - LastExportTime >= GSMLatencyExportInterval)
+	{
+		LastExportTime = CurrentTime;
+		WriteReport();
+	}
+}
+
+TStatId USMLatencySubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USMLatencySubsystem, STATGROUP_Tickables);
+}
+
+bool USMLatencySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+bool USMLatencySubsystem::IsEnabled()
+{
+	return GSMLatencyEnabled;
+}
+
+void USMLatencySubsystem::RecordSample(ESMLatencyAction InAction, ESMLatencyStage InStage, double InSeconds)
+{
+	if (!IsEnabled())
+	{
+		return;
+	}
+
+	Histograms[static_cast<int32>(InAction)][static_cast<int32>(InStage)].Add(InSeconds * 1000.0);
+}
+
+TSharedRef<FJsonObject> USMLatencySubsystem::BuildReport() const
+{
+	TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+	for (int32 ActionIndex = 0; ActionIndex < static_cast<int32>(ESMLatencyAction::Max); ++ActionIndex)
+	{
+		TSharedRef<FJsonObject> ActionObject = MakeShared<FJsonObject>();
+		for (int32 StageIndex = 0; StageIndex < static_cast<int32>(ESMLatencyStage::Max); ++StageIndex)
+		{
+			const FSMLatencyHistogram& Histogram = Histograms[ActionIndex][StageIndex];
+			if (Histogram.Count == 0)
+			{
+				continue;
+			}
+
+			TSharedRef<FJsonObject> StageObject = MakeShared<FJsonObject>();
+			StageObject->SetNumberField(TEXT("count"), Histogram.Count);
+			StageObject->SetNumberField(TEXT("avg"), Histogram.GetAverage());
+			StageObject->SetNumberField(TEXT("p50"), Histogram.GetPercentile(0.5));
+			StageObject->SetNumberField(TEXT("p90"), Histogram.GetPercentile(0.9));
+			StageObject->SetNumberField(TEXT("p99"), Histogram.GetPercentile(0.99));
+			StageObject->SetNumberField(TEXT("max"), Histogram.Max);
+			ActionObject->SetObjectField(StageNames[StageIndex], StageObject);
+		}
+
+		if (ActionObject->Values.Num() > 0)
+		{
+			Report->SetObjectField(ActionNames[ActionIndex], ActionObject);
+		}
+	}
+
+	return Report;
+}
+
+void USMLatencySubsystem::PrintReport() const
+{
+	for (int32 StageIndex = 0; StageIndex < static_cast<int32>(ESMLatencyStage::Max); ++StageIndex)
+	{
+		UE_LOG(LogSMLatency, Log, TEXT("[SM.Latency] %s: %s"), StageNames[StageIndex], StageDescriptions[StageIndex]);
+	}
+
+	for (int32 ActionIndex = 0; ActionIndex < static_cast<int32>(ESMLatencyAction::Max); ++ActionIndex)
+	{
+		for (int32 StageIndex = 0; StageIndex < static_cast<int32>(ESMLatencyStage::Max); ++StageIndex)
+		{
+			const FSMLatencyHistogram& Histogram = Histograms[ActionIndex][StageIndex];
+			if (Histogram.Count == 0)
+			{
+				continue;
+			}
+
+			UE_LOG(LogSMLatency, Log, TEXT("[SM.Latency] %-5s %-13s %7llu회 - 평균 %6.1fms, p50 %6.1fms, p99 %6.1fms, 최대 %6.1fms"),
+				ActionNames[ActionIndex], StageNames[StageIndex], Histogram.Count,
+				Histogram.GetAverage(), Histogram.GetPercentile(0.5), Histogram.GetPercentile(0.99), Histogram.Max);
+		}
+	}
+}
+
+void USMLatencySubsystem::ResetHistograms()
+{
+	for (int32 ActionIndex = 0; ActionIndex < static_cast<int32>(ESMLatencyAction::Max); ++ActionIndex)
+	{
+		for (int32 StageIndex = 0; StageIndex < static_cast<int32>(ESMLatencyStage::Max); ++StageIndex)
+		{
+			Histograms[ActionIndex][StageIndex] = FSMLatencyHistogram();
+		}
+	}
+}
+
+void USMLatencySubsystem::WriteReport() const
+{
+	FString ReportString;
+	const TSharedRef<TJsonWriter<>> JsonWriter = TJsonWriterFactory<>::Create(&ReportString);
+	FJsonSerializer::Serialize(BuildReport(), JsonWriter);
+
+	if (!FFileHelper::SaveStringToFile(ReportString, *ReportPath))
+	{
+		UE_LOG(LogSMLatency, Error, TEXT("지연 시간 결과를 저장하지 못했습니다: %s"), *ReportPath);
+	}
+}
+
+#if !UE_BUILD_SHIPPING
+static FAutoConsoleCommandWithWorldAndArgs SMLatencyReportCommand(
+	TEXT("SM.Latency.Report"),
+	TEXT("이동, 점프, 잡기 입력의 구간별 지연 시간을 출력합니다. 인자로 reset을 주면 기록을 초기화합니다."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		USMLatencySubsystem* LatencySubsystem = World ? World->GetSubsystem<USMLatencySubsystem>() : nullptr;
+		if (!LatencySubsystem)
+		{
+			return;
+		}
+
+		if (Args.Num() > 0 && Args[0] == TEXT("reset"))
+		{
+			LatencySubsystem->ResetHistograms();
+			return;
+		}
+
+		LatencySubsystem->PrintReport();
+	}));
+#endif
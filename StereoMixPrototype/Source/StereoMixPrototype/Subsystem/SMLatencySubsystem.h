@@ -0,0 +1,121 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SMLatencySubsystem.generated.h"
+
+class FJsonObject;
+
+DECLARE_LOG_CATEGORY_CLASS(LogSMLatency, Log, All);
+
+/** 지연 시간을 측정하는 입력 액션 목록입니다. Op(이름) */
+#define SM_LATENCY_ACTION_LIST(Op) \
+	Op(Move) \
+	Op(Jump) \
+	Op(Hold)
+
+/**
+ * 입력부터 결과 수신까지의 구간 목록입니다. Op(이름, 설명)
+ * ClientQueue, RoundTrip, Total은 입력한 클라이언트에서, ServerProcess는 서버에서 기록됩니다.
+ * RoundTrip에서 ServerProcess를 빼면 네트워크 왕복 시간의 추정치가 됩니다.
+ */
+#define SM_LATENCY_STAGE_LIST(Op) \
+	Op(ClientQueue, "입력부터 서버로 전송(세이브드 무브 또는 RPC)까지") \
+	Op(ServerProcess, "서버 수신부터 적용 또는 응답 전송까지") \
+	Op(RoundTrip, "전송부터 서버 응답 수신까지") \
+	Op(Total, "입력부터 서버 응답 수신까지")
+
+enum class ESMLatencyAction : uint8
+{
+#define SM_LATENCY_ACTION_ENUM(Name) Name,
+	SM_LATENCY_ACTION_LIST(SM_LATENCY_ACTION_ENUM)
+#undef SM_LATENCY_ACTION_ENUM
+	Max
+};
+
+enum class ESMLatencyStage : uint8
+{
+#define SM_LATENCY_STAGE_ENUM(Name, Description) Name,
+	SM_LATENCY_STAGE_LIST(SM_LATENCY_STAGE_ENUM)
+#undef SM_LATENCY_STAGE_ENUM
+	Max
+};
+
+/** 1ms 단위 고정 버킷 히스토그램입니다. 샘플 수와 관계없이 메모리가 일정합니다. */
+struct FSMLatencyHistogram
+{
+	void Add(double InMilliseconds);
+
+	/** 0~1 사이의 백분위에 해당하는 값(ms)입니다. 버킷의 상한을 반환합니다. */
+	double GetPercentile(double InPercentile) const;
+
+	double GetAverage() const { return Count > 0 ? Sum / Count : 0.0; }
+
+	static constexpr int32 NumBuckets = 1000;
+
+	static constexpr double BucketWidthMs = 1.0;
+
+	/** 마지막 버킷은 범위를 넘는 샘플을 모두 담습니다. */
+	uint32 Buckets[NumBuckets] = {};
+
+	uint64 Count = 0;
+
+	double Sum = 0.0;
+
+	double Max = 0.0;
+};
+
+/**
+ * 이동, 점프, 잡기 입력이 서버에 적용되고 결과가 돌아오기까지의 지연 시간을 구간별 히스토그램으로 기록합니다.
+ * 각 구간의 시간은 한 프로세스 안에서 측정하므로 클라이언트와 서버의 시계를 맞출 필요가 없습니다.
+ *
+ * 기록은 기본으로 꺼져 있고 배포 빌드에서는 서브시스템을 만들지 않습니다. SM.Latency 1, -SMLatency 또는 -SMLatencyReport로 켭니다.
+ *
+ * SM.Latency.Report [reset]   액션과 구간별 p50, p99를 출력합니다.
+ * -SMLatencyReport=경로        결과 JSON을 SM.Latency.ExportInterval 주기와 월드 종료 시에 이 경로에 기록합니다. 헤드리스 실행에서 사용합니다.
+ */
+UCLASS()
+class STEREOMIXPROTOTYPE_API USMLatencySubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+public:
+	static bool IsEnabled();
+
+	/** 구간의 시간을 초 단위로 기록합니다. */
+	void RecordSample(ESMLatencyAction InAction, ESMLatencyStage InStage, double InSeconds);
+
+	const FSMLatencyHistogram& GetHistogram(ESMLatencyAction InAction, ESMLatencyStage InStage) const { return Histograms[static_cast<int32>(InAction)][static_cast<int32>(InStage)]; }
+
+	/** 샘플이 있는 액션과 구간의 결과를 JSON으로 만듭니다. 부하 테스트 결과에도 포함됩니다. */
+	TSharedRef<FJsonObject> BuildReport() const;
+
+	void PrintReport() const;
+
+	void ResetHistograms();
+
+protected:
+	void WriteReport() const;
+
+	FSMLatencyHistogram Histograms[static_cast<int32>(ESMLatencyAction::Max)][static_cast<int32>(ESMLatencyStage::Max)];
+
+	FString ReportPath;
+
+	double LastExportTime = 0.0;
+};
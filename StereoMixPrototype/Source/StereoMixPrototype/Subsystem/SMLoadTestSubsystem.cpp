@@ -0,0 +1,346 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystem/SMLoadTestSubsystem.h"
+
+#include "Character/SMCharacterMovementComponent.h"
+#include "Character/SMPlayerCharacter.h"
+#include "CoreGlobals.h"
+#include "Dom/JsonObject.h"
+#include "Engine/NetConnection.h"
+#include "Engine/NetDriver.h"
+#include "Misc/FileHelper.h"
+#include "Player/SMPlayerController.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "Subsystem/SMLatencySubsystem.h"
+#include "Subsystem/SMNetUpdateSubsystem.h"
+#include "Subsystem/SMTickSignificanceSubsystem.h"
+
+bool USMLoadTestSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	return IsLoadTestEnabled() && Super::ShouldCreateSubsystem(Outer);
+}
+
+void USMLoadTestSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	const TCHAR* CommandLine = FCommandLine::Get();
+	FParse::Value(CommandLine, TEXT("SMLoadTestDuration="), Duration);
+	FParse::Value(CommandLine, TEXT("SMLoadTestWarmup="), Warmup);
+	FParse::Value(CommandLine, TEXT("SMLoadTestExpectedClients="), ExpectedClients);
+	if (!FParse::Value(CommandLine, TEXT("SMLoadTestReport="), ReportPath))
+	{
+		ReportPath = FPaths::ProjectSavedDir() / TEXT("LoadTest") / TEXT("Summary.json");
+	}
+
+	WorldStartTime = FPlatformTime::Seconds();
+
+	// 대략적인 샘플 수만큼 미리 할당해 측정 중 재할당을 줄입니다.
+	const int32 ExpectedSamples = FMath::CeilToInt(Duration * 120.0f);
+	FrameTimes.Reserve(ExpectedSamples);
+	GameThreadTimes.Reserve(ExpectedSamples);
+}
+
+void USMLoadTestSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (bIsFinished || GetWorld()->GetNetMode() == NM_Client)
+	{
+		return;
+	}
+
+	const double CurrentTime = FPlatformTime::Seconds();
+	if (!bIsMeasuring)
+	{
+		const UNetDriver* NetDriver = GetWorld()->GetNetDriver();
+		const int32 NumClients = NetDriver ? NetDriver->ClientConnections.Num() : 0;
+		const bool bAllClientsJoined = ExpectedClients > 0 && NumClients >= ExpectedClients;
+		if (bAllClientsJoined || CurrentTime - WorldStartTime >= Warmup)
+		{
+			StartMeasuring();
+		}
+		return;
+	}
+
+	FrameTimes.Add(DeltaTime * 1000.0f);
+	GameThreadTimes.Add(FPlatformTime::ToMilliseconds(GGameThreadTime));
+
+	if (CurrentTime - MeasureStartTime >= Duration)
+	{
+		FinishMeasuring();
+	}
+}
+
+TStatId USMLoadTestSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USMLoadTestSubsystem, STATGROUP_Tickables);
+}
+
+bool USMLoadTestSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+bool USMLoadTestSubsystem::IsLoadTestEnabled()
+{
+	static const bool bLoadTestEnabled = FParse::Param(FCommandLine::Get(), TEXT("SMLoadTest"));
+	return bLoadTestEnabled;
+}
+
+void USMLoadTestSubsystem::StartMeasuring()
+{
+	bIsMeasuring = true;
+	MeasureStartTime = FPlatformTime::Seconds();
+	CaptureConnectionBaselines();
+
+	USMTickSignificanceSubsystem* TickSignificanceSubsystem = GetWorld()->GetSubsystem<USMTickSignificanceSubsystem>();
+	if (TickSignificanceSubsystem)
+	{
+		TickSignificanceSubsystem->ResetStats();
+	}
+
+	USMNetUpdateSubsystem* NetUpdateSubsystem = GetWorld()->GetSubsystem<USMNetUpdateSubsystem>();
+	if (NetUpdateSubsystem)
+	{
+		NetUpdateSubsystem->ResetStats();
+	}
+
+	const UNetDriver* NetDriver = GetWorld()->GetNetDriver();
+	UE_LOG(LogSMLoadTest, Log, TEXT("부하 테스트 측정 시작: 클라이언트 %d명, %.0f초"), NetDriver ? NetDriver->ClientConnections.Num() : 0, Duration);
+}
+
+void USMLoadTestSubsystem::FinishMeasuring()
+{
+	bIsMeasuring = false;
+	bIsFinished = true;
+
+	WriteReport(BuildReport());
+
+	FPlatformMisc::RequestExit(false);
+}
+
+void USMLoadTestSubsystem::CaptureConnectionBaselines()
+{
+	ConnectionBaselines.Reset();
+
+	const UNetDriver* NetDriver = GetWorld()->GetNetDriver();
+	if (!NetDriver)
+	{
+		return;
+	}
+
+	for (UNetConnection* Connection : NetDriver->ClientConnections)
+	{
+		FConnectionBaseline& Baseline = ConnectionBaselines.Add(Connection);
+		Baseline.InBytes = static_cast<int64>(Connection->InTotalBytes);
+		Baseline.OutBytes = static_cast<int64>(Connection->OutTotalBytes);
+		Baseline.InPackets = static_cast<int64>(Connection->InTotalPackets);
+		Baseline.OutPackets = static_cast<int64>(Connection->OutTotalPackets);
+
+		const ASMPlayerController* PlayerController = Cast<ASMPlayerController>(Connection->PlayerController);
+		if (PlayerController)
+		{
+			Baseline.YawRPCs = PlayerController->GetYawSyncStats().Received.Count;
+			Baseline.YawRPCBytes = PlayerController->GetYawSyncStats().Received.Bytes;
+			Baseline.CatchRPCs = PlayerController->GetCatchReceived().Count;
+			Baseline.CatchAccepted = PlayerController->GetNumCatchAccepted();
+		}
+
+		const USMCharacterMovementComponent* MovementComponent = GetMovementComponent(Connection);
+		if (MovementComponent)
+		{
+			Baseline.MovementComponent = MovementComponent;
+			Baseline.MovementCorrections = MovementComponent->GetNumServerCorrections();
+		}
+	}
+}
+
+const USMCharacterMovementComponent* USMLoadTestSubsystem::GetMovementComponent(const UNetConnection* InConnection)
+{
+	const APlayerController* PlayerController = InConnection->PlayerController;
+	const ASMPlayerCharacter* Character = PlayerController ? Cast<ASMPlayerCharacter>(PlayerController->GetPawn()) : nullptr;
+	return Character ? Cast<USMCharacterMovementComponent>(Character->GetCharacterMovement()) : nullptr;
+}
+
+TSharedRef<FJsonObject> USMLoadTestSubsystem::BuildReport() const
+{
+	const double MeasuredTime = FMath::Max(FPlatformTime::Seconds() - MeasureStartTime, UE_SMALL_NUMBER);
+
+	TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+	Report->SetStringField(TEXT("map"), GetWorld()->GetMapName());
+	Report->SetNumberField(TEXT("durationSeconds"), MeasuredTime);
+	Report->SetNumberField(TEXT("frameCount"), FrameTimes.Num());
+	Report->SetObjectField(TEXT("frameTimeMs"), MakePercentileObject(FrameTimes));
+	Report->SetObjectField(TEXT("gameThreadTimeMs"), MakePercentileObject(GameThreadTimes));
+
+	int64 TotalInBytes = 0;
+	int64 TotalOutBytes = 0;
+	uint32 TotalYawRPCs = 0;
+	uint32 TotalCatchRPCs = 0;
+	uint32 TotalCatchAccepted = 0;
+	uint32 TotalCorrections = 0;
+
+	TArray<TSharedPtr<FJsonValue>> ConnectionValues;
+	const UNetDriver* NetDriver = GetWorld()->GetNetDriver();
+	if (NetDriver)
+	{
+		for (UNetConnection* Connection : NetDriver->ClientConnections)
+		{
+			const FConnectionBaseline* Baseline = ConnectionBaselines.Find(Connection);
+			const FConnectionBaseline EmptyBaseline;
+			if (!Baseline)
+			{
+				Baseline = &EmptyBaseline;
+			}
+
+			const int64 InBytes = static_cast<int64>(Connection->InTotalBytes) - Baseline->InBytes;
+			const int64 OutBytes = static_cast<int64>(Connection->OutTotalBytes) - Baseline->OutBytes;
+
+			TSharedRef<FJsonObject> ConnectionObject = MakeShared<FJsonObject>();
+			ConnectionObject->SetStringField(TEXT("address"), Connection->LowLevelGetRemoteAddress(true));
+			ConnectionObject->SetNumberField(TEXT("inBytes"), InBytes);
+			ConnectionObject->SetNumberField(TEXT("outBytes"), OutBytes);
+			ConnectionObject->SetNumberField(TEXT("inBytesPerSecond"), InBytes / MeasuredTime);
+			ConnectionObject->SetNumberField(TEXT("outBytesPerSecond"), OutBytes / MeasuredTime);
+			ConnectionObject->SetNumberField(TEXT("inPackets"), static_cast<int64>(Connection->InTotalPackets) - Baseline->InPackets);
+			ConnectionObject->SetNumberField(TEXT("outPackets"), static_cast<int64>(Connection->OutTotalPackets) - Baseline->OutPackets);
+
+			// RPC 수와 보정 횟수도 측정 시작 시점의 값을 뺀 측정 구간의 값입니다.
+			const ASMPlayerController* PlayerController = Cast<ASMPlayerController>(Connection->PlayerController);
+			if (PlayerController)
+			{
+				const FSMYawSyncStats& YawSyncStats = PlayerController->GetYawSyncStats();
+				const uint32 YawRPCs = YawSyncStats.Received.Count - Baseline->YawRPCs;
+				const uint32 CatchRPCs = PlayerController->GetCatchReceived().Count - Baseline->CatchRPCs;
+				const uint32 CatchAccepted = PlayerController->GetNumCatchAccepted() - Baseline->CatchAccepted;
+				ConnectionObject->SetNumberField(TEXT("yawRPCs"), YawRPCs);
+				ConnectionObject->SetNumberField(TEXT("yawRPCBytes"), YawSyncStats.Received.Bytes - Baseline->YawRPCBytes);
+				ConnectionObject->SetNumberField(TEXT("catchRPCs"), CatchRPCs);
+				ConnectionObject->SetNumberField(TEXT("catchAccepted"), CatchAccepted);
+				TotalYawRPCs += YawRPCs;
+				TotalCatchRPCs += CatchRPCs;
+				TotalCatchAccepted += CatchAccepted;
+
+				const USMCharacterMovementComponent* MovementComponent = GetMovementComponent(Connection);
+				if (MovementComponent)
+				{
+					const uint32 BaselineCorrections = Baseline->MovementComponent == MovementComponent ? Baseline->MovementCorrections : 0;
+					const uint32 Corrections = MovementComponent->GetNumServerCorrections() - BaselineCorrections;
+					ConnectionObject->SetNumberField(TEXT("movementCorrections"), Corrections);
+					TotalCorrections += Corrections;
+				}
+			}
+
+			TotalInBytes += InBytes;
+			TotalOutBytes += OutBytes;
+			ConnectionValues.Add(MakeShared<FJsonValueObject>(ConnectionObject));
+		}
+	}
+
+	const int32 NumConnections = ConnectionValues.Num();
+	Report->SetNumberField(TEXT("numConnections"), NumConnections);
+	Report->SetArrayField(TEXT("connections"), ConnectionValues);
+
+	TSharedRef<FJsonObject> Totals = MakeShared<FJsonObject>();
+	Totals->SetNumberField(TEXT("inBytesPerSecond"), TotalInBytes / MeasuredTime);
+	Totals->SetNumberField(TEXT("outBytesPerSecond"), TotalOutBytes / MeasuredTime);
+	Totals->SetNumberField(TEXT("outBytesPerSecondPerConnection"), NumConnections > 0 ? TotalOutBytes / MeasuredTime / NumConnections : 0.0);
+	Totals->SetNumberField(TEXT("yawRPCs"), TotalYawRPCs);
+	Totals->SetNumberField(TEXT("catchRPCs"), TotalCatchRPCs);
+	Totals->SetNumberField(TEXT("catchAccepted"), TotalCatchAccepted);
+	Totals->SetNumberField(TEXT("movementCorrections"), TotalCorrections);
+	Report->SetObjectField(TEXT("totals"), Totals);
+
+	const USMTickSignificanceSubsystem* TickSignificanceSubsystem = GetWorld()->GetSubsystem<USMTickSignificanceSubsystem>();
+	if (TickSignificanceSubsystem)
+	{
+		const FSMTickSignificanceStats& TickStats = TickSignificanceSubsystem->GetStats();
+		const double NumTickFrames = FMath::Max(TickStats.NumFrames, 1u);
+
+		TSharedRef<FJsonObject> TickObject = MakeShared<FJsonObject>();
+		TickObject->SetNumberField(TEXT("skippedActorTicksPerFrame"), TickStats.NumSkippedActorTicks / NumTickFrames);
+		TickObject->SetNumberField(TEXT("skippedMeshTicksPerFrame"), TickStats.NumSkippedMeshTicks / NumTickFrames);
+		TickObject->SetNumberField(TEXT("deferredEvaluations"), TickStats.NumDeferredEvaluations);
+		TickObject->SetNumberField(TEXT("maxEvaluationTimeMs"), TickStats.MaxEvaluationTimeMs);
+		Report->SetObjectField(TEXT("tickSignificance"), TickObject);
+	}
+
+	const USMNetUpdateSubsystem* NetUpdateSubsystem = GetWorld()->GetSubsystem<USMNetUpdateSubsystem>();
+	if (NetUpdateSubsystem)
+	{
+		const FSMNetUpdateStats& NetUpdateStats = NetUpdateSubsystem->GetStats();
+
+		TSharedRef<FJsonObject> NetUpdateObject = MakeShared<FJsonObject>();
+		NetUpdateObject->SetBoolField(TEXT("enabled"), USMNetUpdateSubsystem::IsEnabled());
+		NetUpdateObject->SetNumberField(TEXT("updatesPerCharacterPerSecond"), NetUpdateStats.GetActorUpdatesPerCharacterPerSecond());
+		NetUpdateObject->SetNumberField(TEXT("connectionUpdatesPerCharacterPerSecond"), NetUpdateStats.GetConnectionUpdatesPerCharacterPerSecond());
+		NetUpdateObject->SetNumberField(TEXT("forcedUpdates"), NetUpdateStats.NumForcedUpdates);
+
+		// 활동 비율이 다르면 업데이트 수를 비교할 수 없으므로 함께 기록합니다.
+		TSharedRef<FJsonObject> ActivityObject = MakeShared<FJsonObject>();
+		const double CharacterSeconds = FMath::Max(NetUpdateStats.CharacterSeconds, UE_SMALL_NUMBER);
+		for (int32 ActivityIndex = 0; ActivityIndex < static_cast<int32>(ESMNetUpdateActivity::Max); ++ActivityIndex)
+		{
+			ActivityObject->SetNumberField(USMNetUpdateSubsystem::GetActivityName(static_cast<ESMNetUpdateActivity>(ActivityIndex)), NetUpdateStats.ActivitySeconds[ActivityIndex] / CharacterSeconds * 100.0);
+		}
+		NetUpdateObject->SetObjectField(TEXT("activityPercent"), ActivityObject);
+		Report->SetObjectField(TEXT("netUpdate"), NetUpdateObject);
+	}
+
+	// 서버에서는 ServerProcess 구간만 기록됩니다. 클라이언트 구간은 봇의 -SMLatencyReport 결과에 있습니다.
+	const USMLatencySubsystem* LatencySubsystem = GetWorld()->GetSubsystem<USMLatencySubsystem>();
+	if (LatencySubsystem)
+	{
+		Report->SetObjectField(TEXT("latencyMs"), LatencySubsystem->BuildReport());
+	}
+
+	return Report;
+}
+
+void USMLoadTestSubsystem::WriteReport(const TSharedRef<FJsonObject>& InReport) const
+{
+	FString ReportString;
+	const TSharedRef<TJsonWriter<>> JsonWriter = TJsonWriterFactory<>::Create(&ReportString);
+	FJsonSerializer::Serialize(InReport, JsonWriter);
+
+	if (FFileHelper::SaveStringToFile(ReportString, *ReportPath))
+	{
+		UE_LOG(LogSMLoadTest, Log, TEXT("부하 테스트 결과 저장: %s"), *ReportPath);
+	}
+	else
+	{
+		UE_LOG(LogSMLoadTest, Error, TEXT("부하 테스트 결과를 저장하지 못했습니다: %s"), *ReportPath);
+	}
+}
+
+TSharedRef<FJsonObject> USMLoadTestSubsystem::MakePercentileObject(TArray<float> InSamples)
+{
+	TSharedRef<FJsonObject> PercentileObject = MakeShared<FJsonObject>();
+	if (InSamples.Num() == 0)
+	{
+		return PercentileObject;
+	}
+
+	InSamples.Sort();
+	const auto GetPercentile = [&InSamples](float Percentile)
+	{
+		const int32 Index = FMath::Clamp(FMath::FloorToInt(Percentile * (InSamples.Num() - 1)), 0, InSamples.Num() - 1);
+		return InSamples[Index];
+	};
+
+	double Sum = 0.0;
+	for (const float Sample : InSamples)
+	{
+		Sum += Sample;
+	}
+
+	PercentileObject->SetNumberField(TEXT("avg"), Sum / InSamples.Num());
+	PercentileObject->SetNumberField(TEXT("p50"), GetPercentile(0.5f));
+	PercentileObject->SetNumberField(TEXT("p90"), GetPercentile(0.9f));
+	PercentileObject->SetNumberField(TEXT("p99"), GetPercentile(0.99f));
+	PercentileObject->SetNumberField(TEXT("max"), InSamples.Last());
+	return PercentileObject;
+}
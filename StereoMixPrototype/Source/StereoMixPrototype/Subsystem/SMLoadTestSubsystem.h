@@ -0,0 +1,105 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "SMLoadTestSubsystem.generated.h"
+
+class FJsonObject;
+class UNetConnection;
+class USMCharacterMovementComponent;
+
+DECLARE_LOG_CATEGORY_CLASS(LogSMLoadTest, Log, All);
+
+/**
+ * 데디케이티드 서버 부하 테스트의 측정과 결과 기록을 담당합니다. 커맨드라인에 -SMLoadTest가 있을 때만 생성됩니다.
+ *
+ * -SMLoadTestDuration=초        측정 시간입니다. 끝나면 결과를 기록하고 서버를 종료합니다.
+ * -SMLoadTestWarmup=초          측정 전에 봇의 접속을 기다리는 최대 시간입니다.
+ * -SMLoadTestExpectedClients=N  이 수만큼 접속하면 대기 시간이 남아도 측정을 시작합니다.
+ * -SMLoadTestReport=경로        결과 JSON 파일의 경로입니다.
+ */
+UCLASS()
+class STEREOMIXPROTOTYPE_API USMLoadTestSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+public:
+	/** -SMLoadTest 커맨드라인으로 실행되었는지 확인합니다. */
+	static bool IsLoadTestEnabled();
+
+	bool IsMeasuring() const { return bIsMeasuring; }
+
+protected:
+	void StartMeasuring();
+
+	void FinishMeasuring();
+
+	/** 측정 시작 시점의 커넥션 통계를 기록해 측정 구간의 차이만 보고할 수 있게 합니다. */
+	void CaptureConnectionBaselines();
+
+	/** 측정 결과를 JSON으로 만듭니다. 이후 기능에서 항목을 추가할 수 있도록 분리되어 있습니다. */
+	TSharedRef<FJsonObject> BuildReport() const;
+
+	void WriteReport(const TSharedRef<FJsonObject>& InReport) const;
+
+	static TSharedRef<FJsonObject> MakePercentileObject(TArray<float> InSamples);
+
+	struct FConnectionBaseline
+	{
+		int64 InBytes = 0;
+		int64 OutBytes = 0;
+		int64 InPackets = 0;
+		int64 OutPackets = 0;
+		uint32 YawRPCs = 0;
+		uint64 YawRPCBytes = 0;
+		uint32 CatchRPCs = 0;
+		uint32 CatchAccepted = 0;
+
+		/** 보정 횟수는 이동 컴포넌트에 누적되므로 측정 중 리스폰으로 컴포넌트가 바뀌면 기준값을 사용하지 않습니다. */
+		TWeakObjectPtr<const USMCharacterMovementComponent> MovementComponent;
+
+		uint32 MovementCorrections = 0;
+	};
+
+	/** 커넥션의 캐릭터 이동 컴포넌트입니다. 없다면 nullptr입니다. */
+	static const USMCharacterMovementComponent* GetMovementComponent(const UNetConnection* InConnection);
+
+	TMap<TObjectKey<UNetConnection>, FConnectionBaseline> ConnectionBaselines;
+
+	/** 프레임 간격(슬립 포함)입니다. */
+	TArray<float> FrameTimes;
+
+	/** 실제 게임 스레드 작업 시간입니다. */
+	TArray<float> GameThreadTimes;
+
+	float Duration = 60.0f;
+
+	float Warmup = 30.0f;
+
+	int32 ExpectedClients = 0;
+
+	FString ReportPath;
+
+	double WorldStartTime = 0.0;
+
+	double MeasureStartTime = 0.0;
+
+	uint32 bIsMeasuring = false;
+
+	uint32 bIsFinished = false;
+};
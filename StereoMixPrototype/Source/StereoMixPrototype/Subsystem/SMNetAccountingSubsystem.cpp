@@ -0,0 +1,363 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystem/SMNetAccountingSubsystem.h"
+
+#include "Engine/NetConnection.h"
+#include "Engine/NetDriver.h"
+#include "GameFramework/Actor.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+#if !UE_BUILD_SHIPPING
+static bool GSMNetAccountingEnabled = false;
+
+static FAutoConsoleVariableRef CVarSMNetAccountingEnabled(
+	TEXT("SM.Net.Accounting"),
+	GSMNetAccountingEnabled,
+	TEXT("캐릭터의 프로퍼티, RPC, 이동 복제의 커넥션별 송수신 비트를 추정해 집계합니다."));
+
+static float GSMNetAccountingExportInterval = 10.0f;
+
+static FAutoConsoleVariableRef CVarSMNetAccountingExportInterval(
+	TEXT("SM.Net.Accounting.ExportInterval"),
+	GSMNetAccountingExportInterval,
+	TEXT("이 주기(초)마다 구간 집계를 Saved/NetAccounting/의 CSV에 추가합니다. 0이면 기록하지 않습니다."));
+#else
+static constexpr bool GSMNetAccountingEnabled = false;
+
+static constexpr float GSMNetAccountingExportInterval = 0.0f;
+#endif
+
+namespace
+{
+	const TCHAR* const AccountNames[] =
+	{
+#define SM_NET_ACCOUNT_NAME(Name, Group) TEXT(#Name),
+		SM_NET_ACCOUNT_LIST(SM_NET_ACCOUNT_NAME)
+#undef SM_NET_ACCOUNT_NAME
+	};
+
+	const TCHAR* const AccountGroups[] =
+	{
+#define SM_NET_ACCOUNT_GROUP(Name, Group) TEXT(#Group),
+		SM_NET_ACCOUNT_LIST(SM_NET_ACCOUNT_GROUP)
+#undef SM_NET_ACCOUNT_GROUP
+	};
+
+	const TCHAR* const DirectionNames[] = { TEXT("In"), TEXT("Out") };
+}
+
+bool USMNetAccountingSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	// 커넥션과 캐릭터마다 집계하는 비용이 있으므로 배포 빌드에서는 만들지 않습니다.
+	return !UE_BUILD_SHIPPING && Super::ShouldCreateSubsystem(Outer);
+}
+
+void USMNetAccountingSubsystem::Deinitialize()
+{
+	if (IsEnabled() && GSMNetAccountingExportInterval > 0.0f)
+	{
+		ExportWindow();
+	}
+
+	Super::Deinitialize();
+}
+
+void USMNetAccountingSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (!IsEnabled())
+	{
+		return;
+	}
+
+	const double CurrentTime = FPlatformTime::Seconds();
+	if (AccountStartTime == 0.0)
+	{
+		AccountStartTime = CurrentTime;
+		WindowStartTime = CurrentTime;
+	}
+
+	if (GSMNetAccountingExportInterval > 0.0f && CurrentTime - WindowStartTime >= GSMNetAccountingExportInterval)
+	{
+		ExportWindow();
+
+		// 사라진 액터와 커넥션은 구간이 끝날 때 정리합니다.
+		for (auto It = MovementCaches.CreateIterator(); It; ++It)
+		{
+			if (!It.Key().ResolveObjectPtr())
+			{
+				It.RemoveCurrent();
+			}
+		}
+		for (auto It = Accounts.CreateIterator(); It; ++It)
+		{
+			if (!It.Value().Connection.IsValid())
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+}
+
+TStatId USMNetAccountingSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USMNetAccountingSubsystem, STATGROUP_Tickables);
+}
+
+bool USMNetAccountingSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+bool USMNetAccountingSubsystem::IsEnabled()
+{
+	return GSMNetAccountingEnabled;
+}
+
+void USMNetAccountingSubsystem::Record(UNetConnection* InConnection, ESMNetAccount InAccount, ESMNetDirection InDirection, uint32 InBits)
+{
+	if (!IsEnabled() || !InConnection)
+	{
+		return;
+	}
+
+	FConnectionAccount& Account = FindOrAddAccount(InConnection);
+	Account.Counters[static_cast<int32>(InAccount)][static_cast<int32>(InDirection)].Add(InBits);
+	Account.WindowCounters[static_cast<int32>(InAccount)][static_cast<int32>(InDirection)].Add(InBits);
+}
+
+void USMNetAccountingSubsystem::RecordToRelevantConnections(const AActor* InActor, ESMNetAccount InAccount, uint32 InBits)
+{
+	const UNetDriver* NetDriver = GetWorld()->GetNetDriver();
+	if (!IsEnabled() || !NetDriver)
+	{
+		return;
+	}
+
+	for (UNetConnection* Connection : NetDriver->ClientConnections)
+	{
+		if (Connection && Connection->FindActorChannelRef(InActor))
+		{
+			Record(Connection, InAccount, ESMNetDirection::Out, InBits);
+		}
+	}
+}
+
+void USMNetAccountingSubsystem::RecordFromServer(ESMNetAccount InAccount, uint32 InBits)
+{
+	const UNetDriver* NetDriver = GetWorld()->GetNetDriver();
+	if (NetDriver)
+	{
+		Record(NetDriver->ServerConnection, InAccount, ESMNetDirection::In, InBits);
+	}
+}
+
+void USMNetAccountingSubsystem::RecordToServer(ESMNetAccount InAccount, uint32 InBits)
+{
+	const UNetDriver* NetDriver = GetWorld()->GetNetDriver();
+	if (NetDriver)
+	{
+		Record(NetDriver->ServerConnection, InAccount, ESMNetDirection::Out, InBits);
+	}
+}
+
+void USMNetAccountingSubsystem::RecordMovementOut(UNetConnection* InConnection, const AActor* InActor)
+{
+	if (!IsEnabled() || !InConnection || !InActor)
+	{
+		return;
+	}
+
+	// 이동의 변경 여부와 크기는 커넥션 수와 관계없이 프레임당 한 번만 계산합니다.
+	FMovementCache& Cache = MovementCaches.FindOrAdd(InActor);
+	if (Cache.FrameNumber != GFrameCounter)
+	{
+		const FVector Location = InActor->GetActorLocation();
+		const FRotator Rotation = InActor->GetActorRotation();
+		const FVector Velocity = InActor->GetVelocity();
+		Cache.bChanged = !Location.Equals(Cache.Location, 0.01) || !Rotation.Equals(Cache.Rotation, 0.01) || !Velocity.Equals(Cache.Velocity, 0.01);
+		Cache.Location = Location;
+		Cache.Rotation = Rotation;
+		Cache.Velocity = Velocity;
+		Cache.Bits = Cache.bChanged ? GetMovementBits(InActor) : 0;
+		Cache.FrameNumber = GFrameCounter;
+	}
+
+	if (Cache.bChanged)
+	{
+		Record(InConnection, ESMNetAccount::ReplicatedMovement, ESMNetDirection::Out, PropertyHeaderBits + Cache.Bits);
+	}
+}
+
+uint32 USMNetAccountingSubsystem::GetMovementBits(const AActor* InActor)
+{
+	FRepMovement Movement = InActor->GetReplicatedMovement();
+	Movement.Location = InActor->GetActorLocation();
+	Movement.Rotation = InActor->GetActorRotation();
+	Movement.LinearVelocity = InActor->GetVelocity();
+
+	FNetBitWriter Writer(nullptr, 1024);
+	bool bSuccess = false;
+	Movement.NetSerialize(Writer, nullptr, bSuccess);
+	return static_cast<uint32>(Writer.GetNumBits());
+}
+
+void USMNetAccountingSubsystem::PrintReport() const
+{
+	const double Elapsed = FMath::Max(FPlatformTime::Seconds() - AccountStartTime, UE_KINDA_SMALL_NUMBER);
+
+	double TotalAttributedOutBytes = 0.0;
+	double TotalOutBytes = 0.0;
+	for (const TPair<TObjectKey<UNetConnection>, FConnectionAccount>& Pair : Accounts)
+	{
+		const FConnectionAccount& Account = Pair.Value;
+		const UNetConnection* Connection = Account.Connection.Get();
+		if (!Connection)
+		{
+			continue;
+		}
+
+		const double InBytes = static_cast<int64>(Connection->InTotalBytes) - Account.InBytesAtStart;
+		const double OutBytes = static_cast<int64>(Connection->OutTotalBytes) - Account.OutBytesAtStart;
+		TotalOutBytes += OutBytes;
+
+		UE_LOG(LogSMNetAccounting, Log, TEXT("[SM.Net.Accounting] %s - %.1f초, 전체 수신 %.0fB/s, 송신 %.0fB/s"), *Account.Name, Elapsed, InBytes / Elapsed, OutBytes / Elapsed);
+
+		double AttributedIn = 0.0;
+		double AttributedOut = 0.0;
+		for (int32 i = 0; i < static_cast<int32>(ESMNetAccount::Max); ++i)
+		{
+			const FSMNetAccountCounter& In = Account.Counters[i][static_cast<int32>(ESMNetDirection::In)];
+			const FSMNetAccountCounter& Out = Account.Counters[i][static_cast<int32>(ESMNetDirection::Out)];
+			if (In.Count == 0 && Out.Count == 0)
+			{
+				continue;
+			}
+
+			AttributedIn += In.Bits / 8.0;
+			AttributedOut += Out.Bits / 8.0;
+			UE_LOG(LogSMNetAccounting, Log, TEXT("    %-9s %-28s 수신 %6llu회 %8.1fB/s | 송신 %6llu회 %8.1fB/s"),
+				AccountGroups[i], AccountNames[i], In.Count, In.Bits / 8.0 / Elapsed, Out.Count, Out.Bits / 8.0 / Elapsed);
+		}
+
+		TotalAttributedOutBytes += AttributedOut;
+		UE_LOG(LogSMNetAccounting, Log, TEXT("    추정치를 뺀 나머지: 수신 %.0fB/s, 송신 %.0fB/s"), (InBytes - AttributedIn) / Elapsed, (OutBytes - AttributedOut) / Elapsed);
+	}
+
+	const UNetDriver* NetDriver = GetWorld()->GetNetDriver();
+	const int32 NumClients = NetDriver ? NetDriver->ClientConnections.Num() : 0;
+	if (NumClients > 0)
+	{
+		UE_LOG(LogSMNetAccounting, Log, TEXT("[SM.Net.Accounting] 플레이어당 송신: 전체 %.0fB/s, 캐릭터 항목 추정 %.0fB/s (커넥션 %d개)"),
+			TotalOutBytes / Elapsed / NumClients, TotalAttributedOutBytes / Elapsed / NumClients, NumClients);
+	}
+}
+
+void USMNetAccountingSubsystem::ResetAccounts()
+{
+	Accounts.Reset();
+	AccountStartTime = FPlatformTime::Seconds();
+	WindowStartTime = AccountStartTime;
+}
+
+USMNetAccountingSubsystem::FConnectionAccount& USMNetAccountingSubsystem::FindOrAddAccount(UNetConnection* InConnection)
+{
+	FConnectionAccount* Account = Accounts.Find(InConnection);
+	if (Account)
+	{
+		return *Account;
+	}
+
+	FConnectionAccount& NewAccount = Accounts.Add(InConnection);
+	NewAccount.Connection = InConnection;
+	NewAccount.Name = InConnection->PlayerController ? InConnection->PlayerController->GetName() : InConnection->LowLevelGetRemoteAddress(true);
+	NewAccount.InBytesAtStart = static_cast<int64>(InConnection->InTotalBytes);
+	NewAccount.OutBytesAtStart = static_cast<int64>(InConnection->OutTotalBytes);
+	NewAccount.InBytesAtWindowStart = NewAccount.InBytesAtStart;
+	NewAccount.OutBytesAtWindowStart = NewAccount.OutBytesAtStart;
+	return NewAccount;
+}
+
+void USMNetAccountingSubsystem::ExportWindow()
+{
+	const double CurrentTime = FPlatformTime::Seconds();
+	const double WindowTime = FMath::Max(CurrentTime - WindowStartTime, UE_KINDA_SMALL_NUMBER);
+	WindowStartTime = CurrentTime;
+
+	if (Accounts.Num() == 0)
+	{
+		return;
+	}
+
+	const bool bNewFile = ExportPath.IsEmpty();
+	if (bNewFile)
+	{
+		const TCHAR* NetModeName = GetWorld()->GetNetMode() == NM_Client ? TEXT("Client") : TEXT("Server");
+		ExportPath = FPaths::ProjectSavedDir() / TEXT("NetAccounting") / FString::Printf(TEXT("%s_%s.csv"), NetModeName, *FDateTime::Now().ToString());
+	}
+
+	TStringBuilder<4096> Builder;
+	if (bNewFile)
+	{
+		// 항목별 행은 추정치만, 커넥션 전체 행은 실제 송수신량만 기록합니다.
+		Builder.Append(TEXT("time,connection,group,account,direction,count,estimatedBytesPerSecond,measuredBytesPerSecond\n"));
+	}
+
+	const double Time = CurrentTime - AccountStartTime;
+	for (TPair<TObjectKey<UNetConnection>, FConnectionAccount>& Pair : Accounts)
+	{
+		FConnectionAccount& Account = Pair.Value;
+		for (int32 i = 0; i < static_cast<int32>(ESMNetAccount::Max); ++i)
+		{
+			for (int32 Direction = 0; Direction < static_cast<int32>(ESMNetDirection::Max); ++Direction)
+			{
+				FSMNetAccountCounter& Counter = Account.WindowCounters[i][Direction];
+				if (Counter.Count > 0)
+				{
+					Builder.Appendf(TEXT("%.1f,%s,%s,%s,%s,%llu,%.1f,\n"), Time, *Account.Name, AccountGroups[i], AccountNames[i], DirectionNames[Direction], Counter.Count, Counter.Bits / 8.0 / WindowTime);
+				}
+				Counter = FSMNetAccountCounter();
+			}
+		}
+
+		const UNetConnection* Connection = Account.Connection.Get();
+		if (Connection)
+		{
+			const int64 InBytes = static_cast<int64>(Connection->InTotalBytes);
+			const int64 OutBytes = static_cast<int64>(Connection->OutTotalBytes);
+			Builder.Appendf(TEXT("%.1f,%s,Connection,Total,In,0,,%.1f\n"), Time, *Account.Name, (InBytes - Account.InBytesAtWindowStart) / WindowTime);
+			Builder.Appendf(TEXT("%.1f,%s,Connection,Total,Out,0,,%.1f\n"), Time, *Account.Name, (OutBytes - Account.OutBytesAtWindowStart) / WindowTime);
+			Account.InBytesAtWindowStart = InBytes;
+			Account.OutBytesAtWindowStart = OutBytes;
+		}
+	}
+
+	FFileHelper::SaveStringToFile(Builder.ToView(), *ExportPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM, &IFileManager::Get(), FILEWRITE_Append);
+}
+
+#if !UE_BUILD_SHIPPING
+static FAutoConsoleCommandWithWorldAndArgs SMNetAccountingReportCommand(
+	TEXT("SM.Net.Accounting.Report"),
+	TEXT("커넥션별 캐릭터 프로퍼티, RPC, 이동 복제의 추정 송수신량과 실제 전체 송수신량을 출력합니다. 인자로 reset을 주면 집계를 초기화합니다."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		USMNetAccountingSubsystem* NetAccountingSubsystem = World ? World->GetSubsystem<USMNetAccountingSubsystem>() : nullptr;
+		if (!NetAccountingSubsystem)
+		{
+			return;
+		}
+
+		if (Args.Num() > 0 && Args[0] == TEXT("reset"))
+		{
+			NetAccountingSubsystem->ResetAccounts();
+			return;
+		}
+
+		NetAccountingSubsystem->PrintReport();
+	}));
+#endif
@@ -0,0 +1,171 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "SMNetAccountingSubsystem.generated.h"
+
+class UNetConnection;
+
+DECLARE_LOG_CATEGORY_CLASS(LogSMNetAccounting, Log, All);
+
+/**
+ * 집계 항목 목록입니다. Op(이름, 분류)
+ * 분류는 요약과 CSV에서 Property, Movement, RPC로 묶어 보여주기 위해 사용합니다.
+ */
+#define SM_NET_ACCOUNT_LIST(Op) \
+	Op(ReplicatedState, Property) \
+	Op(CatchPredictionAck, Property) \
+	Op(AttachedCaster, Property) \
+	Op(ReplicatedMovement, Movement) \
+	Op(ServerMove, Movement) \
+	Op(MoveResponse, Movement) \
+	Op(ServerRotateToMousePointer, RPC) \
+	Op(ServerRPCPerformPull, RPC)
+
+enum class ESMNetAccount : uint8
+{
+#define SM_NET_ACCOUNT_ENUM(Name, Group) Name,
+	SM_NET_ACCOUNT_LIST(SM_NET_ACCOUNT_ENUM)
+#undef SM_NET_ACCOUNT_ENUM
+	Max
+};
+
+enum class ESMNetDirection : uint8
+{
+	In,
+	Out,
+	Max
+};
+
+struct FSMNetAccountCounter
+{
+	void Add(uint32 InBits)
+	{
+		++Count;
+		Bits += InBits;
+	}
+
+	uint64 Count = 0;
+
+	uint64 Bits = 0;
+};
+
+/**
+ * 커넥션별로 ASMPlayerCharacter의 프로퍼티, RPC, 이동 복제가 사용한 비트를 추정해 집계합니다. 개발 빌드에서만 생성되며 기본으로 꺼져 있습니다.
+ * 이동(패킹된 무브, 무브 응답, FRepMovement)은 데이터를 직렬화한 비트에 추정 헤더를 더한 값이고, 프로퍼티와 RPC는 파라미터 크기에 추정 헤더를 더한 고정값입니다.
+ * 프로퍼티는 전송될 때가 아니라 값이 바뀔 때 관련 커넥션마다 기록되므로 실제 전송과는 시점과 횟수가 다를 수 있습니다.
+ * 커넥션의 실제 전체 송수신 바이트를 함께 기록해 추정치와 비교하고 집계되지 않은 나머지(패킷 헤더, 다른 액터 등)도 확인할 수 있습니다.
+ *
+ * SM.Net.Accounting                  집계를 켜고 끕니다.
+ * SM.Net.Accounting.ExportInterval   이 주기(초)마다 구간 결과를 Saved/NetAccounting/의 CSV에 추가합니다. 0이면 기록하지 않습니다.
+ * SM.Net.Accounting.Report [reset]   커넥션별 요약을 출력합니다.
+ */
+UCLASS()
+class STEREOMIXPROTOTYPE_API USMNetAccountingSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+public:
+	static bool IsEnabled();
+
+	/** 커넥션 하나의 송수신을 기록합니다. */
+	void Record(UNetConnection* InConnection, ESMNetAccount InAccount, ESMNetDirection InDirection, uint32 InBits);
+
+	/** 서버에서 액터 채널이 열려 있는 모든 커넥션으로의 송신을 기록합니다. 모든 관련 커넥션에 보내지는 프로퍼티와 멀티캐스트 RPC에 사용합니다. */
+	void RecordToRelevantConnections(const AActor* InActor, ESMNetAccount InAccount, uint32 InBits);
+
+	/** 클라이언트에서 서버로부터의 수신을 기록합니다. */
+	void RecordFromServer(ESMNetAccount InAccount, uint32 InBits);
+
+	/** 클라이언트에서 서버로의 송신을 기록합니다. */
+	void RecordToServer(ESMNetAccount InAccount, uint32 InBits);
+
+	/**
+	 * 이번 프레임에 커넥션으로 복제된 캐릭터의 이동 복제를 기록합니다. 리플리케이션 그래프가 복제를 마친 뒤 호출합니다.
+	 * 이동이 직전 프레임과 같다면 복제되지 않으므로 기록하지 않습니다.
+	 */
+	void RecordMovementOut(UNetConnection* InConnection, const AActor* InActor);
+
+	/** 현재 위치, 회전, 속도로 만든 이동 복제 하나를 직렬화한 비트 수입니다. */
+	static uint32 GetMovementBits(const AActor* InActor);
+
+	void PrintReport() const;
+
+	void ResetAccounts();
+
+public:
+	/** RPC 하나의 함수 식별자와 번치 헤더의 추정치입니다. */
+	static constexpr uint32 RPCHeaderBits = 16;
+
+	/** 프로퍼티 하나의 핸들 추정치입니다. */
+	static constexpr uint32 PropertyHeaderBits = 8;
+
+	/** 오브젝트 참조 하나의 NetGUID 추정치입니다. */
+	static constexpr uint32 ObjectReferenceBits = 32;
+
+protected:
+	struct FConnectionAccount
+	{
+		FString Name;
+
+		TWeakObjectPtr<UNetConnection> Connection;
+
+		FSMNetAccountCounter Counters[static_cast<int32>(ESMNetAccount::Max)][static_cast<int32>(ESMNetDirection::Max)];
+
+		/** 마지막 내보내기 이후의 값입니다. */
+		FSMNetAccountCounter WindowCounters[static_cast<int32>(ESMNetAccount::Max)][static_cast<int32>(ESMNetDirection::Max)];
+
+		int64 InBytesAtStart = 0;
+
+		int64 OutBytesAtStart = 0;
+
+		int64 InBytesAtWindowStart = 0;
+
+		int64 OutBytesAtWindowStart = 0;
+	};
+
+	struct FMovementCache
+	{
+		FVector Location = FVector::ZeroVector;
+
+		FRotator Rotation = FRotator::ZeroRotator;
+
+		FVector Velocity = FVector::ZeroVector;
+
+		uint64 FrameNumber = 0;
+
+		uint32 Bits = 0;
+
+		uint32 bChanged = false;
+	};
+
+	FConnectionAccount& FindOrAddAccount(UNetConnection* InConnection);
+
+	/** 지난 구간의 결과를 CSV에 추가하고 구간을 다시 시작합니다. */
+	void ExportWindow();
+
+	TMap<TObjectKey<UNetConnection>, FConnectionAccount> Accounts;
+
+	TMap<TObjectKey<AActor>, FMovementCache> MovementCaches;
+
+	double AccountStartTime = 0.0;
+
+	double WindowStartTime = 0.0;
+
+	FString ExportPath;
+};
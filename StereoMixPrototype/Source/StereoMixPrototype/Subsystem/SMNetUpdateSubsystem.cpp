@@ -0,0 +1,234 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystem/SMNetUpdateSubsystem.h"
+
+#include "Character/SMPlayerCharacter.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Subsystem/SMPullSubsystem.h"
+
+static bool GSMNetUpdateEnabled = true;
+
+static FAutoConsoleVariableRef CVarSMNetUpdateEnabled(
+	TEXT("SM.Net.Update"),
+	GSMNetUpdateEnabled,
+	TEXT("캐릭터의 활동에 따라 NetUpdateFrequency와 NetPriority를 조절합니다. 끄면 모든 캐릭터가 클래스 기본값을 사용합니다."));
+
+static float GSMNetUpdateIdleSpeed = 10.0f;
+
+static FAutoConsoleVariableRef CVarSMNetUpdateIdleSpeed(
+	TEXT("SM.Net.Update.IdleSpeed"),
+	GSMNetUpdateIdleSpeed,
+	TEXT("지면에서 이 속도(cm/s)보다 느린 캐릭터는 멈춰 있는 것으로 보고 업데이트 빈도를 낮춥니다."));
+
+namespace
+{
+	const TCHAR* const ActivityNames[] =
+	{
+#define SM_NET_UPDATE_ACTIVITY_NAME(Name, Frequency, Priority, Description) TEXT(#Name),
+		SM_NET_UPDATE_ACTIVITY_LIST(SM_NET_UPDATE_ACTIVITY_NAME)
+#undef SM_NET_UPDATE_ACTIVITY_NAME
+	};
+
+	const float ActivityFrequencies[] =
+	{
+#define SM_NET_UPDATE_ACTIVITY_FREQUENCY(Name, Frequency, Priority, Description) Frequency,
+		SM_NET_UPDATE_ACTIVITY_LIST(SM_NET_UPDATE_ACTIVITY_FREQUENCY)
+#undef SM_NET_UPDATE_ACTIVITY_FREQUENCY
+	};
+
+	const float ActivityPriorities[] =
+	{
+#define SM_NET_UPDATE_ACTIVITY_PRIORITY(Name, Frequency, Priority, Description) Priority,
+		SM_NET_UPDATE_ACTIVITY_LIST(SM_NET_UPDATE_ACTIVITY_PRIORITY)
+#undef SM_NET_UPDATE_ACTIVITY_PRIORITY
+	};
+}
+
+void USMNetUpdateSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	Entries.RemoveAllSwap([](const FEntry& Entry) { return !Entry.Character.IsValid(); });
+
+	if (GetWorld()->GetNetMode() == NM_Client)
+	{
+		return;
+	}
+
+	const bool bEnabled = IsEnabled();
+	if (bEnabled != static_cast<bool>(bWasEnabled))
+	{
+		// 끌 때는 기본값으로 되돌리고, 다시 켤 때는 모든 캐릭터에 활동을 다시 적용합니다.
+		if (!bEnabled)
+		{
+			RestoreAllEntries();
+		}
+
+		for (FEntry& Entry : Entries)
+		{
+			Entry.Activity = ESMNetUpdateActivity::Max;
+		}
+
+		bWasEnabled = bEnabled;
+	}
+
+	// 꺼져 있어도 비교를 위해 활동과 업데이트 수는 계속 집계합니다.
+	++Stats.NumFrames;
+	Stats.ElapsedTime += DeltaTime;
+	Stats.CharacterSeconds += static_cast<double>(DeltaTime) * Entries.Num();
+	for (FEntry& Entry : Entries)
+	{
+		EvaluateEntry(Entry, false);
+		Stats.ActivitySeconds[static_cast<int32>(Entry.Activity)] += DeltaTime;
+	}
+}
+
+TStatId USMNetUpdateSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USMNetUpdateSubsystem, STATGROUP_Tickables);
+}
+
+bool USMNetUpdateSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+bool USMNetUpdateSubsystem::IsEnabled()
+{
+	return GSMNetUpdateEnabled;
+}
+
+const TCHAR* USMNetUpdateSubsystem::GetActivityName(ESMNetUpdateActivity InActivity)
+{
+	return InActivity < ESMNetUpdateActivity::Max ? ActivityNames[static_cast<int32>(InActivity)] : TEXT("Unknown");
+}
+
+void USMNetUpdateSubsystem::RegisterCharacter(ASMPlayerCharacter* InCharacter)
+{
+	FEntry& Entry = Entries.AddDefaulted_GetRef();
+	Entry.Character = InCharacter;
+}
+
+void USMNetUpdateSubsystem::UnregisterCharacter(ASMPlayerCharacter* InCharacter)
+{
+	Entries.RemoveAllSwap([InCharacter](const FEntry& Entry) { return Entry.Character.Get() == InCharacter; });
+}
+
+void USMNetUpdateSubsystem::NotifyStateChanged(ASMPlayerCharacter* InCharacter)
+{
+	FEntry* Entry = Entries.FindByPredicate([InCharacter](const FEntry& Entry) { return Entry.Character.Get() == InCharacter; });
+	if (Entry)
+	{
+		EvaluateEntry(*Entry, true);
+	}
+}
+
+void USMNetUpdateSubsystem::PrintReport() const
+{
+	UE_LOG(LogSMNetUpdate, Log, TEXT("[SM.Net.Update] %s, %.1f초 - 캐릭터당 초당 업데이트 %.2f회, 커넥션별 %.2f회, 즉시 복제 요청 %llu회"),
+		IsEnabled() ? TEXT("켜짐") : TEXT("꺼짐"), Stats.ElapsedTime,
+		Stats.GetActorUpdatesPerCharacterPerSecond(), Stats.GetConnectionUpdatesPerCharacterPerSecond(), Stats.NumForcedUpdates);
+
+	const double CharacterSeconds = FMath::Max(Stats.CharacterSeconds, UE_SMALL_NUMBER);
+	for (int32 ActivityIndex = 0; ActivityIndex < static_cast<int32>(ESMNetUpdateActivity::Max); ++ActivityIndex)
+	{
+		UE_LOG(LogSMNetUpdate, Log, TEXT("[SM.Net.Update] %-8s %5.1f%% (%.0fHz, 우선순위 %.1f)"),
+			ActivityNames[ActivityIndex], Stats.ActivitySeconds[ActivityIndex] / CharacterSeconds * 100.0,
+			ActivityFrequencies[ActivityIndex], ActivityPriorities[ActivityIndex]);
+	}
+}
+
+void USMNetUpdateSubsystem::EvaluateEntry(FEntry& InEntry, bool bInForce)
+{
+	ASMPlayerCharacter* Character = InEntry.Character.Get();
+	if (!Character)
+	{
+		return;
+	}
+
+	const ESMNetUpdateActivity PreviousActivity = InEntry.Activity;
+	InEntry.Activity = CalculateActivity(Character);
+	if (!IsEnabled())
+	{
+		return;
+	}
+
+	const bool bChanged = InEntry.Activity != PreviousActivity;
+	if (bChanged)
+	{
+		ApplyActivity(Character, InEntry.Activity);
+	}
+
+	// 처음 적용할 때는 이미 복제 중이므로 요청하지 않습니다.
+	if (bInForce || (bChanged && PreviousActivity != ESMNetUpdateActivity::Max))
+	{
+		Character->ForceNetUpdate();
+		++Stats.NumForcedUpdates;
+	}
+}
+
+ESMNetUpdateActivity USMNetUpdateSubsystem::CalculateActivity(const ASMPlayerCharacter* InCharacter)
+{
+	if (InCharacter->IsHidden() || InCharacter->GetAttachParentActor())
+	{
+		return ESMNetUpdateActivity::Inactive;
+	}
+
+	const USMPullSubsystem* PullSubsystem = InCharacter->GetWorld()->GetSubsystem<USMPullSubsystem>();
+	if (PullSubsystem && PullSubsystem->IsPulling(InCharacter))
+	{
+		return ESMNetUpdateActivity::Pulled;
+	}
+
+	const UCharacterMovementComponent* CharacterMovement = InCharacter->GetCharacterMovement();
+	if (CharacterMovement->IsFalling())
+	{
+		return ESMNetUpdateActivity::Airborne;
+	}
+
+	return CharacterMovement->Velocity.SizeSquared2D() > FMath::Square(GSMNetUpdateIdleSpeed) ? ESMNetUpdateActivity::Moving : ESMNetUpdateActivity::Idle;
+}
+
+void USMNetUpdateSubsystem::ApplyActivity(ASMPlayerCharacter* InCharacter, ESMNetUpdateActivity InActivity)
+{
+	if (InActivity == ESMNetUpdateActivity::Max)
+	{
+		const AActor* DefaultCharacter = InCharacter->GetClass()->GetDefaultObject<AActor>();
+		InCharacter->NetUpdateFrequency = DefaultCharacter->NetUpdateFrequency;
+		InCharacter->NetPriority = DefaultCharacter->NetPriority;
+		return;
+	}
+
+	InCharacter->NetUpdateFrequency = ActivityFrequencies[static_cast<int32>(InActivity)];
+	InCharacter->NetPriority = ActivityPriorities[static_cast<int32>(InActivity)];
+}
+
+void USMNetUpdateSubsystem::RestoreAllEntries()
+{
+	for (FEntry& Entry : Entries)
+	{
+		ApplyActivity(Entry.Character.Get(), ESMNetUpdateActivity::Max);
+		Entry.Activity = ESMNetUpdateActivity::Max;
+	}
+}
+
+static FAutoConsoleCommandWithWorldAndArgs SMNetUpdateReportCommand(
+	TEXT("SM.Net.Update.Report"),
+	TEXT("캐릭터당 초당 업데이트 수와 활동별 시간 비율을 출력합니다. 인자로 reset을 주면 통계를 초기화합니다."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		USMNetUpdateSubsystem* NetUpdateSubsystem = World ? World->GetSubsystem<USMNetUpdateSubsystem>() : nullptr;
+		if (!NetUpdateSubsystem)
+		{
+			return;
+		}
+
+		if (Args.Num() > 0 && Args[0] == TEXT("reset"))
+		{
+			NetUpdateSubsystem->ResetStats();
+			return;
+		}
+
+		NetUpdateSubsystem->PrintReport();
+	}));
@@ -0,0 +1,140 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SMNetUpdateSubsystem.generated.h"
+
+class ASMPlayerCharacter;
+
+DECLARE_LOG_CATEGORY_CLASS(LogSMNetUpdate, Log, All);
+
+/**
+ * 캐릭터의 네트워크 활동 목록입니다. Op(이름, 초당 업데이트 수, 우선순위, 설명)
+ * 위에서부터 먼저 해당하는 활동으로 분류됩니다.
+ */
+#define SM_NET_UPDATE_ACTIVITY_LIST(Op) \
+	Op(Inactive, 2.0f, 0.5f, "시전자에게 어태치되었거나 풀에 있어 위치를 보낼 필요가 없습니다. 상태 변경은 즉시 전송됩니다.") \
+	Op(Pulled, 30.0f, 3.0f, "서버에서 시전자에게 당겨지는 중입니다.") \
+	Op(Airborne, 30.0f, 3.0f, "점프 등으로 공중에 있습니다. 궤적이 곡선이므로 가장 자주 보냅니다.") \
+	Op(Moving, 15.0f, 2.0f, "지면에서 이동 중입니다.") \
+	Op(Idle, 5.0f, 1.0f, "지면에서 멈춰 있습니다.")
+
+enum class ESMNetUpdateActivity : uint8
+{
+#define SM_NET_UPDATE_ACTIVITY_ENUM(Name, Frequency, Priority, Description) Name,
+	SM_NET_UPDATE_ACTIVITY_LIST(SM_NET_UPDATE_ACTIVITY_ENUM)
+#undef SM_NET_UPDATE_ACTIVITY_ENUM
+	Max
+};
+
+/** 업데이트 빈도 관리 통계입니다. SM.Net.Update.Report로 출력하며 부하 테스트 결과에도 포함됩니다. */
+struct FSMNetUpdateStats
+{
+	uint32 NumFrames = 0;
+
+	double ElapsedTime = 0.0;
+
+	/** 관리 중인 캐릭터 수를 시간으로 적분한 값입니다. 캐릭터당 초당 업데이트 수의 분모입니다. */
+	double CharacterSeconds = 0.0;
+
+	/** 활동별로 캐릭터가 머문 시간입니다. */
+	double ActivitySeconds[static_cast<int32>(ESMNetUpdateActivity::Max)] = {};
+
+	/** 캐릭터가 복제 대상이 된 횟수입니다. (PreReplication 호출 수) */
+	uint64 NumActorUpdates = 0;
+
+	/**
+	 * 리플리케이션 그래프에서 커넥션별로 실제로 복제된 횟수와 수집된 횟수입니다. 기본 넷 드라이버에서는 기록되지 않습니다.
+	 * 수집은 복제 후보로 선정된 것일 뿐이며 주기나 대역폭에 따라 복제되지 않을 수 있습니다.
+	 */
+	uint64 NumConnectionUpdates = 0;
+
+	uint64 NumConnectionGathers = 0;
+
+	/** 활동이나 상태가 바뀌어 즉시 복제를 요청한 횟수입니다. */
+	uint64 NumForcedUpdates = 0;
+
+	double GetActorUpdatesPerCharacterPerSecond() const { return CharacterSeconds > 0.0 ? NumActorUpdates / CharacterSeconds : 0.0; }
+
+	/** 커넥션 하나가 캐릭터 하나를 초당 몇 번 받는지입니다. 수집은 서버 프레임마다 일어나므로 수집 대비 복제 비율에 프레임 레이트를 곱합니다. */
+	double GetConnectionUpdatesPerCharacterPerSecond() const
+	{
+		return NumConnectionGathers > 0 && ElapsedTime > 0.0 ? static_cast<double>(NumConnectionUpdates) / NumConnectionGathers * (NumFrames / ElapsedTime) : 0.0;
+	}
+};
+
+/**
+ * 서버에서 캐릭터마다 활동(당겨짐, 공중, 이동, 정지, 비활성)을 평가해 NetUpdateFrequency와 NetPriority를 조절하는 서브시스템입니다.
+ * 활동이 바뀌거나 잡기처럼 상태가 바뀌면 다음 주기를 기다리지 않도록 즉시 복제를 요청합니다.
+ *
+ * 기본 넷 드라이버는 두 값을 그대로 사용하고, 리플리케이션 그래프는 NetUpdateFrequency의 주기를 거리 구간의 주기에 곱합니다.
+ * (USMReplicationGraphNode_CharacterGrid 참고)
+ *
+ * SM.Net.Update.Report [reset]   캐릭터당 초당 업데이트 수와 활동별 시간 비율을 출력합니다.
+ */
+UCLASS()
+class STEREOMIXPROTOTYPE_API USMNetUpdateSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+public:
+	static bool IsEnabled();
+
+	static const TCHAR* GetActivityName(ESMNetUpdateActivity InActivity);
+
+	void RegisterCharacter(ASMPlayerCharacter* InCharacter);
+
+	void UnregisterCharacter(ASMPlayerCharacter* InCharacter);
+
+	/** 서버에서 잡기 등으로 캐릭터의 상태가 바뀌었을 때 호출합니다. 활동을 다시 평가하고 즉시 복제를 요청합니다. */
+	void NotifyStateChanged(ASMPlayerCharacter* InCharacter);
+
+	/** 캐릭터가 이번 프레임에 복제 대상이 되었음을 기록합니다. */
+	void RecordActorUpdate() { ++Stats.NumActorUpdates; }
+
+	/** 리플리케이션 그래프가 커넥션에 캐릭터를 수집했음을 기록합니다. */
+	void RecordConnectionGather() { ++Stats.NumConnectionGathers; }
+
+	/** 리플리케이션 그래프가 커넥션에 캐릭터를 실제로 복제했음을 기록합니다. */
+	void RecordConnectionUpdate() { ++Stats.NumConnectionUpdates; }
+
+	const FSMNetUpdateStats& GetStats() const { return Stats; }
+
+	void ResetStats() { Stats = FSMNetUpdateStats(); }
+
+	void PrintReport() const;
+
+protected:
+	struct FEntry
+	{
+		TWeakObjectPtr<ASMPlayerCharacter> Character;
+
+		ESMNetUpdateActivity Activity = ESMNetUpdateActivity::Max;
+	};
+
+	/** 활동을 평가하고 바뀌었다면 적용합니다. bInForce라면 바뀌지 않았더라도 즉시 복제를 요청합니다. */
+	void EvaluateEntry(FEntry& InEntry, bool bInForce);
+
+	static ESMNetUpdateActivity CalculateActivity(const ASMPlayerCharacter* InCharacter);
+
+	static void ApplyActivity(ASMPlayerCharacter* InCharacter, ESMNetUpdateActivity InActivity);
+
+	/** 관리를 끌 때 모든 캐릭터를 클래스 기본값으로 되돌립니다. */
+	void RestoreAllEntries();
+
+	TArray<FEntry> Entries;
+
+	FSMNetUpdateStats Stats;
+
+	uint32 bWasEnabled = true;
+};
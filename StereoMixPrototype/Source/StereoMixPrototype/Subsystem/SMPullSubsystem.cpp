@@ -0,0 +1,316 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystem/SMPullSubsystem.h"
+
+#include "Character/SMPlayerCharacter.h"
+#include "Components/CapsuleComponent.h"
+#include "Log/SMBench.h"
+#include "Log/SMPerfMetric.h"
+#include "Log/SMStats.h"
+
+static bool GSMPullLogEndError = false;
+
+static FAutoConsoleVariableRef CVarSMPullLogEndError(
+	TEXT("SM.Pull.LogEndError"),
+	GSMPullLogEndError,
+	TEXT("당기기가 끝나 어태치될 때 스냅된 거리를 [SM.Pull] endErrorCm=값 형식으로 기록합니다."));
+
+void USMPullSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	UpdateCounters();
+
+	if (Targets.Num() == 0)
+	{
+		return;
+	}
+
+	UpdatePulls(DeltaTime);
+	FlushFinishedPulls();
+}
+
+TStatId USMPullSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USMPullSubsystem, STATGROUP_Tickables);
+}
+
+bool USMPullSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void USMPullSubsystem::StartPull(ASMPlayerCharacter* InTarget, ASMPlayerCharacter* InCaster, float InTotalTime)
+{
+	check(InTarget && InCaster);
+
+	CancelPull(InTarget);
+
+	++NumPullsStartedInWindow;
+
+	Targets.Add(InTarget);
+	Casters.Add(InCaster);
+	StartLocations.Add(InTarget->GetActorLocation());
+	EndOffsets.Add(InTarget->GetCapsuleComponent()->GetScaledCapsuleRadius() * 2.0f);
+	ElapsedTimes.Add(0.0f);
+	TotalTimes.Add(FMath::Max(InTotalTime, UE_KINDA_SMALL_NUMBER));
+}
+
+void USMPullSubsystem::CancelPull(const ASMPlayerCharacter* InTarget)
+{
+	for (int32 i = Targets.Num() - 1; i >= 0; --i)
+	{
+		if (Targets[i].Get() == InTarget)
+		{
+			RemovePullAt(i);
+		}
+	}
+}
+
+bool USMPullSubsystem::IsPulling(const ASMPlayerCharacter* InTarget) const
+{
+	for (const TWeakObjectPtr<ASMPlayerCharacter>& Target : Targets)
+	{
+		if (Target.Get() == InTarget)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void USMPullSubsystem::RecordPullEndError(float InErrorDistance)
+{
+	if (GSMPullLogEndError)
+	{
+		UE_LOG(LogSMPull, Log, TEXT("[SM.Pull] endErrorCm=%.2f netMode=%d"), InErrorDistance, static_cast<int32>(GetWorld()->GetNetMode()));
+	}
+}
+
+void USMPullSubsystem::UpdatePulls(float DeltaTime)
+{
+	SM_SCOPE_CYCLE_COUNTER(UpdatePulls);
+
+	FinishedIndices.Reset();
+
+	const int32 NumPulls = Targets.Num();
+	for (int32 i = 0; i < NumPulls; ++i)
+	{
+		ASMPlayerCharacter* Target = Targets[i].Get();
+		const ASMPlayerCharacter* Caster = Casters[i].Get();
+		if (!Target || !Caster)
+		{
+			// 당기기 도중 액터가 사라졌다면 종료 이벤트 없이 제거만 합니다.
+			Targets[i] = nullptr;
+			FinishedIndices.Add(i);
+			continue;
+		}
+
+		// 시전자로부터 대상을 향한 방향
+		const FVector CasterLocation = Caster->GetActorLocation();
+		FVector CasterVector = Target->GetActorLocation() - CasterLocation;
+		CasterVector.Z = 0.0;
+		const FVector CasterDirection = CasterVector.GetSafeNormal();
+
+		// 캡슐 반지름을 통해 EndLocation이 시전자의 위치와 겹치지 않도록 오프셋 지정
+		const FVector EndLocation = CasterLocation + (CasterDirection * EndOffsets[i]);
+
+		// 선형 보간
+		ElapsedTimes[i] += DeltaTime;
+		const float Alpha = FMath::Clamp(ElapsedTimes[i] / TotalTimes[i], 0.0f, 1.0f);
+		Target->SetActorLocation(FMath::Lerp(StartLocations[i], EndLocation, Alpha));
+
+		// 디버거
+		DrawDebugLine(GetWorld(), StartLocations[i], EndLocation, FColor::Cyan, false, 0.1f);
+
+		if (Alpha >= 1.0f)
+		{
+			FinishedIndices.Add(i);
+		}
+	}
+}
+
+void USMPullSubsystem::UpdateCounters()
+{
+	const double CurrentTime = FPlatformTime::Seconds();
+	if (CurrentTime - CatchWindowStartTime >= 1.0)
+	{
+		CatchesPerSecond = NumPullsStartedInWindow / (CurrentTime - CatchWindowStartTime);
+		NumPullsStartedInWindow = 0;
+		CatchWindowStartTime = CurrentTime;
+	}
+
+	SM_SET_COUNTER(ActivePulls, Targets.Num());
+	SM_SET_FLOAT_COUNTER(CatchesPerSecond, CatchesPerSecond);
+}
+
+void USMPullSubsystem::FlushFinishedPulls()
+{
+	if (FinishedIndices.Num() == 0)
+	{
+		return;
+	}
+
+	FinishedPulls.Reset();
+
+	// 뒤에서부터 제거해야 RemoveAtSwap으로 앞쪽의 인덱스가 바뀌지 않습니다.
+	for (int32 i = FinishedIndices.Num() - 1; i >= 0; --i)
+	{
+		const int32 Index = FinishedIndices[i];
+		if (Targets[Index].IsValid())
+		{
+			FinishedPulls.Emplace(Targets[Index], Casters[Index]);
+		}
+
+		RemovePullAt(Index);
+	}
+
+	// 종료 이벤트는 배열 정리가 끝난 뒤에 보내기 때문에, 이벤트 안에서 새 당기기를 시작해도 안전합니다.
+	for (const TPair<TWeakObjectPtr<ASMPlayerCharacter>, TWeakObjectPtr<ASMPlayerCharacter>>& FinishedPull : FinishedPulls)
+	{
+		ASMPlayerCharacter* Target = FinishedPull.Key.Get();
+		ASMPlayerCharacter* Caster = FinishedPull.Value.Get();
+		if (Target && Caster)
+		{
+			Target->HandlePullEnd(Caster);
+		}
+	}
+}
+
+void USMPullSubsystem::RemovePullAt(int32 Index)
+{
+	Targets.RemoveAtSwap(Index, 1, false);
+	Casters.RemoveAtSwap(Index, 1, false);
+	StartLocations.RemoveAtSwap(Index, 1, false);
+	EndOffsets.RemoveAtSwap(Index, 1, false);
+	ElapsedTimes.RemoveAtSwap(Index, 1, false);
+	TotalTimes.RemoveAtSwap(Index, 1, false);
+}
+
+#if !UE_BUILD_SHIPPING
+/**
+ * 대량의 동시 당기기 처리 비용을 측정합니다. 서버(또는 스탠드얼론) 월드에서 실행해야 합니다.
+ * 사용법: SM.Bench.Pull [당기기 수] [프레임 수]
+ */
+static FAutoConsoleCommandWithWorldAndArgs SMBenchPullCommand(
+	TEXT("SM.Bench.Pull"),
+	TEXT("임시 캐릭터를 생성해 동시 당기기를 처리하는 비용을 측정합니다. 인자: 당기기 수(기본 500), 프레임 수(기본 60)"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		USMPullSubsystem* PullSubsystem = World ? World->GetSubsystem<USMPullSubsystem>() : nullptr;
+		if (!PullSubsystem || World->GetNetMode() == NM_Client)
+		{
+			UE_LOG(LogSMPull, Warning, TEXT("[SM.Bench.Pull] 서버 게임 월드에서만 실행할 수 있습니다."));
+			return;
+		}
+
+		const int32 NumPulls = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 500;
+		const int32 NumFrames = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 60;
+		const float DeltaTime = 1.0f / 60.0f;
+
+		// 당기기 처리 비용만 측정하도록 블루프린트가 아닌 기본 캐릭터 클래스를 사용합니다.
+		UClass* CharacterClass = ASMPlayerCharacter::StaticClass();
+
+		TArray<ASMPlayerCharacter*> SpawnedCharacters;
+		SpawnedCharacters.Reserve(NumPulls * 2);
+
+		// 시전자와 대상 쌍을 격자로 배치합니다.
+		const int32 GridSize = FMath::CeilToInt(FMath::Sqrt(static_cast<float>(NumPulls)));
+		for (int32 i = 0; i < NumPulls; ++i)
+		{
+			const FVector CasterLocation(1000.0 * (i % GridSize), 1000.0 * (i / GridSize), 10000.0);
+			ASMPlayerCharacter* Caster = SMBench::SpawnCharacter(World, CharacterClass, FTransform(CasterLocation));
+			ASMPlayerCharacter* Target = SMBench::SpawnCharacter(World, CharacterClass, FTransform(CasterLocation + FVector(300.0, 0.0, 0.0)));
+			if (Caster && Target)
+			{
+				SpawnedCharacters.Add(Caster);
+				SpawnedCharacters.Add(Target);
+				PullSubsystem->StartPull(Target, Caster, 0.1f * FMath::FRandRange(1.0f, 10.0f));
+			}
+		}
+
+		const int32 StartActivePulls = PullSubsystem->GetNumActivePulls();
+		double TotalTime = 0.0;
+		double MaxFrameTime = 0.0;
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			const double FrameStartTime = FPlatformTime::Seconds();
+			PullSubsystem->Tick(DeltaTime);
+			const double FrameTime = FPlatformTime::Seconds() - FrameStartTime;
+
+			TotalTime += FrameTime;
+			MaxFrameTime = FMath::Max(MaxFrameTime, FrameTime);
+		}
+
+		UE_LOG(LogSMPull, Log, TEXT("[SM.Bench.Pull] 동시 당기기 %d개, %d프레임 - 평균 %.3fms, 최대 %.3fms, 남은 당기기 %d개"),
+			StartActivePulls, NumFrames, TotalTime * 1000.0 / NumFrames, MaxFrameTime * 1000.0, PullSubsystem->GetNumActivePulls());
+		SM_PERF_METRIC(TEXT("pull.frameMs.avg"), TotalTime * 1000.0 / NumFrames);
+		SM_PERF_METRIC(TEXT("pull.frameMs.max"), MaxFrameTime * 1000.0);
+
+		for (ASMPlayerCharacter* SpawnedCharacter : SpawnedCharacters)
+		{
+			PullSubsystem->CancelPull(SpawnedCharacter);
+			SpawnedCharacter->Destroy();
+		}
+	}));
+
+/**
+ * 프레임레이트별로 당기기가 끝나기까지 걸리는 시간과 종료 시 위치 오차를 측정합니다.
+ * 종료 오차는 당기기의 마지막 위치와 시전자에게 어태치된 뒤 위치의 차이로, 당기기가 끝날 때 보이는 순간이동 거리입니다.
+ * 사용법: SM.Bench.PullConvergence
+ */
+static FAutoConsoleCommandWithWorld SMBenchPullConvergenceCommand(
+	TEXT("SM.Bench.PullConvergence"),
+	TEXT("30, 60, 120, 240fps에서 당기기의 수렴 시간과 종료 시 위치 오차를 측정합니다."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		USMPullSubsystem* PullSubsystem = World ? World->GetSubsystem<USMPullSubsystem>() : nullptr;
+		if (!PullSubsystem || World->GetNetMode() == NM_Client)
+		{
+			UE_LOG(LogSMPull, Warning, TEXT("[SM.Bench.PullConvergence] 서버 게임 월드에서만 실행할 수 있습니다."));
+			return;
+		}
+
+		UClass* CharacterClass = SMBench::GetCharacterClass(World);
+
+		const int32 FrameRates[] = { 30, 60, 120, 240 };
+		for (const int32 FrameRate : FrameRates)
+		{
+			const FVector CasterLocation(0.0, 0.0, 10000.0);
+			ASMPlayerCharacter* Caster = SMBench::SpawnCharacter(World, CharacterClass, FTransform(CasterLocation));
+			ASMPlayerCharacter* Target = SMBench::SpawnCharacter(World, CharacterClass, FTransform(CasterLocation + FVector(300.0, 0.0, 0.0)));
+			if (!Caster || !Target)
+			{
+				continue;
+			}
+
+			const float DeltaTime = 1.0f / FrameRate;
+			const float PullTotalTime = Caster->GetPullTotalTime();
+			const FVector EndLocation = CasterLocation + FVector(Target->GetCapsuleComponent()->GetScaledCapsuleRadius() * 2.0f, 0.0, 0.0);
+
+			PullSubsystem->StartPull(Target, Caster, PullTotalTime);
+
+			// 무한 루프를 막기 위해 예상 프레임 수의 두 배에서 멈춥니다.
+			const int32 MaxFrames = FMath::CeilToInt(PullTotalTime * FrameRate) * 2 + 2;
+			int32 NumFrames = 0;
+			while (PullSubsystem->IsPulling(Target) && NumFrames < MaxFrames)
+			{
+				PullSubsystem->Tick(DeltaTime);
+				++NumFrames;
+			}
+
+			const double ConvergenceTime = NumFrames * DeltaTime;
+			const double EndError = FVector::Dist(Target->GetActorLocation(), EndLocation);
+			UE_LOG(LogSMPull, Log, TEXT("[SM.Bench.PullConvergence] %dfps - %d프레임, 수렴 %.1fms (설정 %.1fms), 종료 오차 %.2fcm"),
+				FrameRate, NumFrames, ConvergenceTime * 1000.0, PullTotalTime * 1000.0, EndError);
+			SM_PERF_METRIC(TEXT("pull.convergenceMs.fps%d"), ConvergenceTime * 1000.0, FrameRate);
+			SM_PERF_METRIC(TEXT("pull.endErrorCm.fps%d"), EndError, FrameRate);
+
+			PullSubsystem->CancelPull(Target);
+			Target->Destroy();
+			Caster->Destroy();
+		}
+	}));
+#endif
@@ -0,0 +1,88 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SMPullSubsystem.generated.h"
+
+class ASMPlayerCharacter;
+
+DECLARE_LOG_CATEGORY_CLASS(LogSMPull, Log, All);
+
+/**
+ * 진행 중인 모든 당기기를 한 번에 처리하는 서브시스템입니다.
+ * 당기기 데이터는 속성별 배열(SoA)로 저장되며 프레임당 한 번의 순회로 갱신됩니다.
+ * 당기기가 없는 캐릭터는 틱에서 아무 비용도 지불하지 않습니다.
+ */
+UCLASS()
+class STEREOMIXPROTOTYPE_API USMPullSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+public:
+	/** 대상을 시전자 쪽으로 당기기 시작합니다. 서버와, 잡기를 예측하는 시전자 클라이언트에서 호출됩니다. */
+	void StartPull(ASMPlayerCharacter* InTarget, ASMPlayerCharacter* InCaster, float InTotalTime);
+
+	/** 대상의 당기기를 종료 처리 없이 취소합니다. */
+	void CancelPull(const ASMPlayerCharacter* InTarget);
+
+	bool IsPulling(const ASMPlayerCharacter* InTarget) const;
+
+	int32 GetNumActivePulls() const { return Targets.Num(); }
+
+	/** 최근 1초 동안 시작된 당기기 수입니다. 당기기는 잡기가 성공했을 때만 시작되므로 초당 잡기 수와 같습니다. */
+	double GetCatchesPerSecond() const { return CatchesPerSecond; }
+
+	/**
+	 * 당기기가 끝나 대상이 시전자에게 어태치될 때 스냅된 거리를 기록합니다. 화면에 보이던 당기기 끝 위치의 오차입니다.
+	 * SM.Pull.LogEndError가 켜져 있으면 로그로 남겨 네트워크 조건 비교 스크립트에서 집계합니다.
+	 */
+	void RecordPullEndError(float InErrorDistance);
+
+protected:
+	/** 모든 당기기의 위치를 갱신하고 끝난 당기기를 FinishedIndices에 모읍니다. */
+	void UpdatePulls(float DeltaTime);
+
+	/** 진행 중인 당기기 수와 초당 잡기 수를 프로파일링 카운터로 기록합니다. */
+	void UpdateCounters();
+
+	/** 끝난 당기기를 배열에서 제거하고 종료 이벤트를 일괄 처리합니다. */
+	void FlushFinishedPulls();
+
+	void RemovePullAt(int32 Index);
+
+	// 당기기 하나는 모든 배열에서 같은 인덱스를 가집니다.
+	TArray<TWeakObjectPtr<ASMPlayerCharacter>> Targets;
+
+	TArray<TWeakObjectPtr<ASMPlayerCharacter>> Casters;
+
+	TArray<FVector> StartLocations;
+
+	/** 시전자와 겹치지 않도록 EndLocation에 더해지는 오프셋 거리입니다. 시작 시 캡슐 반지름으로 계산됩니다. */
+	TArray<float> EndOffsets;
+
+	TArray<float> ElapsedTimes;
+
+	TArray<float> TotalTimes;
+
+	/** 이번 프레임에 끝난 당기기의 인덱스입니다. 오름차순으로 채워지며 프레임 간 할당을 재사용합니다. */
+	TArray<int32> FinishedIndices;
+
+	/** 종료 이벤트를 보내기 위해 제거 전에 복사해둔 대상과 시전자입니다. */
+	TArray<TPair<TWeakObjectPtr<ASMPlayerCharacter>, TWeakObjectPtr<ASMPlayerCharacter>>> FinishedPulls;
+
+	int32 NumPullsStartedInWindow = 0;
+
+	double CatchWindowStartTime = 0.0;
+
+	double CatchesPerSecond = 0.0;
+};
@@ -0,0 +1,468 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystem/SMSpatialGridSubsystem.h"
+
+#include "Character/SMPlayerCharacter.h"
+#include "Components/CapsuleComponent.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Log/SMBench.h"
+#include "Log/SMPerfMetric.h"
+#include "Log/SMStats.h"
+
+static bool GSMGridCatchPreselect = true;
+
+static FAutoConsoleVariableRef CVarSMGridCatchPreselect(
+	TEXT("SM.Grid.CatchPreselect"),
+	GSMGridCatchPreselect,
+	TEXT("잡기 스윕 전에 격자로 후보를 확인하고, 후보가 없으면 물리 스윕을 건너뜁니다."));
+
+static float GSMGridCellSize = 400.0f;
+
+static FAutoConsoleVariableRef CVarSMGridCellSize(
+	TEXT("SM.Grid.CellSize"),
+	GSMGridCellSize,
+	TEXT("격자 셀 한 변의 길이(cm)입니다. 잡기 스윕(300cm)이 2~3개의 셀에 걸치는 크기가 기본값입니다. 다음 재구성부터 적용됩니다."));
+
+void USMSpatialGridSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	Rebuild();
+}
+
+TStatId USMSpatialGridSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USMSpatialGridSubsystem, STATGROUP_Tickables);
+}
+
+bool USMSpatialGridSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+bool USMSpatialGridSubsystem::IsCatchPreselectEnabled()
+{
+	return GSMGridCatchPreselect;
+}
+
+void USMSpatialGridSubsystem::RegisterCharacter(ASMPlayerCharacter* InCharacter)
+{
+	Characters.Add(InCharacter);
+	MarkDirty();
+}
+
+void USMSpatialGridSubsystem::UnregisterCharacter(ASMPlayerCharacter* InCharacter)
+{
+	Characters.RemoveAllSwap([InCharacter](const TWeakObjectPtr<ASMPlayerCharacter>& Character) { return Character.Get() == InCharacter; });
+
+	// 다음 재구성 전까지 쿼리가 해제된 캐릭터를 반환하지 않도록 지웁니다.
+	for (ASMPlayerCharacter*& SortedCharacter : SortedCharacters)
+	{
+		if (SortedCharacter == InCharacter)
+		{
+			SortedCharacter = nullptr;
+		}
+	}
+}
+
+void USMSpatialGridSubsystem::Rebuild()
+{
+	SM_SCOPE_CYCLE_COUNTER(RebuildSpatialGrid);
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	LastRebuildTime = GetWorld()->GetTimeSeconds();
+	bDirty = false;
+
+	Characters.RemoveAllSwap([](const TWeakObjectPtr<ASMPlayerCharacter>& Character) { return !Character.IsValid(); });
+
+	// 충돌이 꺼진 캐릭터(풀에 있거나 잡힌 캐릭터)는 물리 스윕에도 닿지 않으므로 제외합니다.
+	BuildEntries.Reset();
+	FVector MinLocation(TNumericLimits<double>::Max());
+	FVector MaxLocation(TNumericLimits<double>::Lowest());
+	for (const TWeakObjectPtr<ASMPlayerCharacter>& Character : Characters)
+	{
+		ASMPlayerCharacter* CharacterPtr = Character.Get();
+		if (!CharacterPtr->GetActorEnableCollision() || CharacterPtr->IsHidden())
+		{
+			continue;
+		}
+
+		FBuildEntry& BuildEntry = BuildEntries.AddDefaulted_GetRef();
+		BuildEntry.Character = CharacterPtr;
+		BuildEntry.Location = CharacterPtr->GetActorLocation();
+		MinLocation = FVector::Min(MinLocation, BuildEntry.Location);
+		MaxLocation = FVector::Max(MaxLocation, BuildEntry.Location);
+	}
+
+	const int32 NumEntries = BuildEntries.Num();
+	if (NumEntries == 0)
+	{
+		GridSize = FIntPoint::ZeroValue;
+		CellStarts.Reset();
+		CellStarts.Add(0);
+		SortedLocations.Reset();
+		SortedRadii.Reset();
+		SortedHalfHeights.Reset();
+		SortedCharacters.Reset();
+		return;
+	}
+
+	// 캐릭터가 있는 범위만 덮고, 셀 수가 MaxCells를 넘으면 셀을 키웁니다.
+	const FVector Extent = MaxLocation - MinLocation;
+	CellSize = FMath::Max(GSMGridCellSize, 1.0f);
+	for (;;)
+	{
+		GridSize.X = FMath::FloorToInt32(Extent.X / CellSize) + 1;
+		GridSize.Y = FMath::FloorToInt32(Extent.Y / CellSize) + 1;
+		if (static_cast<int64>(GridSize.X) * GridSize.Y <= MaxCells)
+		{
+			break;
+		}
+
+		CellSize *= 2.0f;
+	}
+	GridOrigin = FVector2D(MinLocation);
+
+	// 계수 정렬: 셀마다 캐릭터 수를 세고, 누적 합으로 시작 위치를 구한 뒤 셀 순서로 흩뿌립니다.
+	const int32 NumCells = GridSize.X * GridSize.Y;
+	CellStarts.Reset();
+	CellStarts.SetNumZeroed(NumCells + 1);
+	for (FBuildEntry& BuildEntry : BuildEntries)
+	{
+		const int32 CellX = FMath::Min(FMath::FloorToInt32((BuildEntry.Location.X - GridOrigin.X) / CellSize), GridSize.X - 1);
+		const int32 CellY = FMath::Min(FMath::FloorToInt32((BuildEntry.Location.Y - GridOrigin.Y) / CellSize), GridSize.Y - 1);
+		BuildEntry.CellIndex = CellY * GridSize.X + CellX;
+		++CellStarts[BuildEntry.CellIndex + 1];
+	}
+
+	for (int32 CellIndex = 0; CellIndex < NumCells; ++CellIndex)
+	{
+		CellStarts[CellIndex + 1] += CellStarts[CellIndex];
+	}
+
+	CellCursors.Reset();
+	CellCursors.Append(CellStarts.GetData(), NumCells);
+	SortedLocations.SetNumUninitialized(NumEntries, false);
+	SortedRadii.SetNumUninitialized(NumEntries, false);
+	SortedHalfHeights.SetNumUninitialized(NumEntries, false);
+	SortedCharacters.SetNumUninitialized(NumEntries, false);
+	MaxRadius = 0.0f;
+	MaxSpeed = 0.0f;
+	for (const FBuildEntry& BuildEntry : BuildEntries)
+	{
+		const UCapsuleComponent* Capsule = BuildEntry.Character->GetCapsuleComponent();
+		const float Radius = Capsule->GetScaledCapsuleRadius();
+		const float HalfHeight = Capsule->GetScaledCapsuleHalfHeight_WithoutHemisphere();
+		MaxRadius = FMath::Max(MaxRadius, Radius);
+
+		// 발사대처럼 최대 속력을 넘는 이동도 있으므로 현재 속력과 함께 확인합니다.
+		const UCharacterMovementComponent* CharacterMovement = BuildEntry.Character->GetCharacterMovement();
+		MaxSpeed = FMath::Max3(MaxSpeed, CharacterMovement->GetMaxSpeed(), static_cast<float>(CharacterMovement->Velocity.Size()));
+
+		const int32 SortedIndex = CellCursors[BuildEntry.CellIndex]++;
+		SortedLocations[SortedIndex] = BuildEntry.Location;
+		SortedRadii[SortedIndex] = Radius;
+		SortedHalfHeights[SortedIndex] = HalfHeight;
+		SortedCharacters[SortedIndex] = BuildEntry.Character;
+	}
+
+	const double RebuildTimeMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+	++Stats.NumRebuilds;
+	Stats.RebuildTimeMs += RebuildTimeMs;
+	Stats.MaxRebuildTimeMs = FMath::Max(Stats.MaxRebuildTimeMs, RebuildTimeMs);
+}
+
+bool USMSpatialGridSubsystem::GetQueryMargin(float InMaxSpeed, float& OutMargin)
+{
+	if (bDirty)
+	{
+		Rebuild();
+	}
+
+	// 같은 프레임에 만든 격자라도 이후 이동한 캐릭터가 있을 수 있으므로 최소 한 프레임만큼은 넓힙니다.
+	const UWorld* World = GetWorld();
+	const float Age = FMath::Max(static_cast<float>(World->GetTimeSeconds() - LastRebuildTime), World->GetDeltaSeconds());
+	if (Age > MaxQueryAge)
+	{
+		return false;
+	}
+
+	OutMargin = (InMaxSpeed + MaxSpeed) * Age;
+	return true;
+}
+
+bool USMSpatialGridSubsystem::GetCellRange(const FVector& InMin, const FVector& InMax, FIntPoint& OutMinCell, FIntPoint& OutMaxCell) const
+{
+	if (GridSize.X == 0)
+	{
+		return false;
+	}
+
+	const int32 MinX = FMath::FloorToInt32((InMin.X - GridOrigin.X) / CellSize);
+	const int32 MinY = FMath::FloorToInt32((InMin.Y - GridOrigin.Y) / CellSize);
+	const int32 MaxX = FMath::FloorToInt32((InMax.X - GridOrigin.X) / CellSize);
+	const int32 MaxY = FMath::FloorToInt32((InMax.Y - GridOrigin.Y) / CellSize);
+	if (MaxX < 0 || MaxY < 0 || MinX >= GridSize.X || MinY >= GridSize.Y)
+	{
+		return false;
+	}
+
+	OutMinCell = FIntPoint(FMath::Max(MinX, 0), FMath::Max(MinY, 0));
+	OutMaxCell = FIntPoint(FMath::Min(MaxX, GridSize.X - 1), FMath::Min(MaxY, GridSize.Y - 1));
+	return true;
+}
+
+template <typename PredicateType>
+void USMSpatialGridSubsystem::Gather(const FVector& InMin, const FVector& InMax, const ASMPlayerCharacter* InIgnoreCharacter, TArray<ASMPlayerCharacter*>& OutCharacters, PredicateType InPredicate)
+{
+	++Stats.NumQueries;
+
+	if (bDirty)
+	{
+		Rebuild();
+	}
+
+	FIntPoint MinCell;
+	FIntPoint MaxCell;
+	if (!GetCellRange(InMin, InMax, MinCell, MaxCell))
+	{
+		return;
+	}
+
+	FoundEntries.Reset();
+	for (int32 CellY = MinCell.Y; CellY <= MaxCell.Y; ++CellY)
+	{
+		const int32 RowStart = CellStarts[CellY * GridSize.X + MinCell.X];
+		const int32 RowEnd = CellStarts[CellY * GridSize.X + MaxCell.X + 1];
+		Stats.NumTestedCharacters += RowEnd - RowStart;
+		for (int32 SortedIndex = RowStart; SortedIndex < RowEnd; ++SortedIndex)
+		{
+			float SortKey;
+			if (InPredicate(SortedIndex, SortKey))
+			{
+				FoundEntries.Emplace(SortKey, SortedIndex);
+			}
+		}
+	}
+
+	FoundEntries.Sort([](const TPair<float, int32>& A, const TPair<float, int32>& B) { return A.Key < B.Key; });
+	for (const TPair<float, int32>& FoundEntry : FoundEntries)
+	{
+		ASMPlayerCharacter* Character = SortedCharacters[FoundEntry.Value];
+		if (Character && Character != InIgnoreCharacter)
+		{
+			OutCharacters.Add(Character);
+			++Stats.NumFoundCharacters;
+		}
+	}
+}
+
+void USMSpatialGridSubsystem::QueryRadius(const FVector& InCenter, float InRadius, TArray<ASMPlayerCharacter*>& OutCharacters, const ASMPlayerCharacter* InIgnoreCharacter)
+{
+	const float RadiusSquared = FMath::Square(InRadius);
+	Gather(InCenter - FVector(InRadius), InCenter + FVector(InRadius), InIgnoreCharacter, OutCharacters, [this, &InCenter, RadiusSquared](int32 InSortedIndex, float& OutSortKey)
+	{
+		OutSortKey = static_cast<float>(FVector::DistSquared(SortedLocations[InSortedIndex], InCenter));
+		return OutSortKey <= RadiusSquared;
+	});
+}
+
+void USMSpatialGridSubsystem::QueryCone(const FVector& InOrigin, const FVector& InDirection, float InHalfAngleDegrees, float InRadius, TArray<ASMPlayerCharacter*>& OutCharacters, const ASMPlayerCharacter* InIgnoreCharacter)
+{
+	const FVector Direction = InDirection.GetSafeNormal();
+	const float RadiusSquared = FMath::Square(InRadius);
+	const float CosHalfAngle = FMath::Cos(FMath::DegreesToRadians(InHalfAngleDegrees));
+	Gather(InOrigin - FVector(InRadius), InOrigin + FVector(InRadius), InIgnoreCharacter, OutCharacters, [this, &InOrigin, &Direction, RadiusSquared, CosHalfAngle](int32 InSortedIndex, float& OutSortKey)
+	{
+		const FVector ToCharacter = SortedLocations[InSortedIndex] - InOrigin;
+		OutSortKey = static_cast<float>(ToCharacter.SizeSquared());
+		if (OutSortKey > RadiusSquared)
+		{
+			return false;
+		}
+
+		// 원뿔의 꼭짓점에 있는 캐릭터는 방향과 관계없이 포함합니다.
+		return OutSortKey <= UE_SMALL_NUMBER || (ToCharacter | Direction) >= CosHalfAngle * FMath::Sqrt(OutSortKey);
+	});
+}
+
+void USMSpatialGridSubsystem::QueryCapsule(const FVector& InStart, const FVector& InEnd, float InRadius, TArray<ASMPlayerCharacter*>& OutCharacters, const ASMPlayerCharacter* InIgnoreCharacter)
+{
+	const FVector BoundsExtent(InRadius + MaxRadius);
+	const FVector BoundsMin = FVector::Min(InStart, InEnd) - BoundsExtent;
+	const FVector BoundsMax = FVector::Max(InStart, InEnd) + BoundsExtent;
+	Gather(BoundsMin, BoundsMax, InIgnoreCharacter, OutCharacters, [this, &InStart, &InEnd, InRadius](int32 InSortedIndex, float& OutSortKey)
+	{
+		// ValidateCatch와 같이 스윕 선분과 캡슐 중심축 선분의 거리로 판정합니다.
+		const FVector& Location = SortedLocations[InSortedIndex];
+		const FVector AxisExtent(0.0, 0.0, SortedHalfHeights[InSortedIndex]);
+
+		FVector ClosestOnSweep;
+		FVector ClosestOnCapsule;
+		FMath::SegmentDistToSegmentSafe(InStart, InEnd, Location - AxisExtent, Location + AxisExtent, ClosestOnSweep, ClosestOnCapsule);
+
+		OutSortKey = static_cast<float>(FVector::DistSquared(InStart, ClosestOnSweep));
+		return FVector::DistSquared(ClosestOnSweep, ClosestOnCapsule) <= FMath::Square(InRadius + SortedRadii[InSortedIndex]);
+	});
+}
+
+void USMSpatialGridSubsystem::RecordCatchPreselection(bool bInSkippedSweep)
+{
+	++Stats.NumCatchPreselections;
+	if (bInSkippedSweep)
+	{
+		++Stats.NumSkippedCatchSweeps;
+	}
+}
+
+void USMSpatialGridSubsystem::PrintReport() const
+{
+	UE_LOG(LogSMSpatialGrid, Log, TEXT("[SM.Grid] 캐릭터 %d명, 셀 %dx%d (%.0fcm) - 재구성 %u회, 평균 %.3fms, 최대 %.3fms"),
+		Characters.Num(), GridSize.X, GridSize.Y, CellSize, Stats.NumRebuilds,
+		Stats.NumRebuilds > 0 ? Stats.RebuildTimeMs / Stats.NumRebuilds : 0.0, Stats.MaxRebuildTimeMs);
+	UE_LOG(LogSMSpatialGrid, Log, TEXT("[SM.Grid] 쿼리 %llu회 - 쿼리당 판정 %.1f명, 결과 %.1f명 / 잡기 후보 선별 %llu회, 물리 스윕 생략 %llu회"),
+		Stats.NumQueries,
+		Stats.NumQueries > 0 ? static_cast<double>(Stats.NumTestedCharacters) / Stats.NumQueries : 0.0,
+		Stats.NumQueries > 0 ? static_cast<double>(Stats.NumFoundCharacters) / Stats.NumQueries : 0.0,
+		Stats.NumCatchPreselections, Stats.NumSkippedCatchSweeps);
+}
+
+static FAutoConsoleCommandWithWorldAndArgs SMGridReportCommand(
+	TEXT("SM.Grid.Report"),
+	TEXT("격자 재구성 비용과 쿼리 통계를 출력합니다. 인자로 reset을 주면 통계를 초기화합니다."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		USMSpatialGridSubsystem* SpatialGridSubsystem = World ? World->GetSubsystem<USMSpatialGridSubsystem>() : nullptr;
+		if (!SpatialGridSubsystem)
+		{
+			return;
+		}
+
+		if (Args.Num() > 0 && Args[0] == TEXT("reset"))
+		{
+			SpatialGridSubsystem->ResetStats();
+			return;
+		}
+
+		SpatialGridSubsystem->PrintReport();
+	}));
+
+#if !UE_BUILD_SHIPPING
+/**
+ * 같은 넓이의 영역에 캐릭터 수를 바꿔가며 배치하고, 모든 캐릭터의 잡기를 물리 스윕과 격자 쿼리로 각각 판정해 비용을 비교합니다.
+ * 두 방식의 적중 여부가 다른 잡기 수도 함께 출력합니다. 격자는 캡슐을 해석적으로 판정하므로 레벨에 캐릭터가 아닌 폰이 없다면 0이어야 합니다.
+ * 사용법: SM.Bench.SpatialGrid [캐릭터당 반복 횟수]
+ */
+static FAutoConsoleCommandWithWorldAndArgs SMBenchSpatialGridCommand(
+	TEXT("SM.Bench.SpatialGrid"),
+	TEXT("3000x3000 영역에 16~256명의 임시 캐릭터를 배치하고 격자 재구성, 격자 쿼리, 물리 스윕의 비용을 측정합니다. 인자: 캐릭터당 반복 횟수(기본 100)"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		USMSpatialGridSubsystem* SpatialGridSubsystem = World ? World->GetSubsystem<USMSpatialGridSubsystem>() : nullptr;
+		if (!SpatialGridSubsystem || World->GetNetMode() == NM_Client)
+		{
+			UE_LOG(LogSMSpatialGrid, Warning, TEXT("[SM.Bench.SpatialGrid] 서버 게임 월드에서만 실행할 수 있습니다."));
+			return;
+		}
+
+		const int32 Iterations = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 100;
+		const int32 PlayerCounts[] = { 16, 32, 64, 128, 256 };
+		const double AreaSize = 3000.0;
+
+		UClass* CharacterClass = SMBench::GetCharacterClass(World);
+
+		FRandomStream RandomStream(1234);
+		for (const int32 NumPlayers : PlayerCounts)
+		{
+			TArray<ASMPlayerCharacter*> SpawnedCharacters;
+			SMBench::SpawnRandomCharacters(World, CharacterClass, NumPlayers, AreaSize, RandomStream, SpawnedCharacters);
+
+			// 레벨에 이미 있던 캐릭터도 격자에 포함되므로 물리 스윕과 같은 조건입니다.
+			double StartTime = FPlatformTime::Seconds();
+			for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+			{
+				SpatialGridSubsystem->Rebuild();
+			}
+			const double RebuildTime = (FPlatformTime::Seconds() - StartTime) / Iterations;
+
+			FCollisionObjectQueryParams CollisionObjectQueryParams;
+			CollisionObjectQueryParams.AddObjectTypesToQuery(ECC_Pawn);
+
+			int32 NumSweepHits = 0;
+			TBitArray<> SweepHits(false, SpawnedCharacters.Num());
+			FHitResult HitResult;
+			StartTime = FPlatformTime::Seconds();
+			for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+			{
+				for (int32 i = 0; i < SpawnedCharacters.Num(); ++i)
+				{
+					const ASMPlayerCharacter* Character = SpawnedCharacters[i];
+					const FVector Start = Character->GetActorLocation();
+					const FVector End = Start + (Character->GetActorForwardVector() * Character->GetCatchDistance());
+					const FCollisionQueryParams CollisionQueryParams(SCENE_QUERY_STAT(Hold), false, Character);
+					const bool bHit = World->SweepSingleByObjectType(HitResult, Start, End, FQuat::Identity, CollisionObjectQueryParams, FCollisionShape::MakeSphere(Character->GetCatchRadius()), CollisionQueryParams);
+					NumSweepHits += bHit ? 1 : 0;
+					SweepHits[i] = bHit;
+				}
+			}
+			const double SweepTime = FPlatformTime::Seconds() - StartTime;
+
+			int32 NumQueryHits = 0;
+			int32 NumMismatches = 0;
+			TArray<ASMPlayerCharacter*> FoundCharacters;
+			StartTime = FPlatformTime::Seconds();
+			for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+			{
+				for (int32 i = 0; i < SpawnedCharacters.Num(); ++i)
+				{
+					const ASMPlayerCharacter* Character = SpawnedCharacters[i];
+					const FVector Start = Character->GetActorLocation();
+					const FVector End = Start + (Character->GetActorForwardVector() * Character->GetCatchDistance());
+					FoundCharacters.Reset();
+					SpatialGridSubsystem->QueryCapsule(Start, End, Character->GetCatchRadius(), FoundCharacters, Character);
+					const bool bHit = FoundCharacters.Num() > 0;
+					NumQueryHits += bHit ? 1 : 0;
+					NumMismatches += bHit != SweepHits[i] ? 1 : 0;
+				}
+			}
+			const double QueryTime = FPlatformTime::Seconds() - StartTime;
+
+			// 관련성이나 AI 대상 탐색에서 쓸 반경, 원뿔 쿼리도 잡기 거리로 측정합니다.
+			StartTime = FPlatformTime::Seconds();
+			for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+			{
+				for (const ASMPlayerCharacter* Character : SpawnedCharacters)
+				{
+					FoundCharacters.Reset();
+					SpatialGridSubsystem->QueryRadius(Character->GetActorLocation(), Character->GetCatchDistance(), FoundCharacters, Character);
+				}
+			}
+			const double RadiusQueryTime = FPlatformTime::Seconds() - StartTime;
+
+			StartTime = FPlatformTime::Seconds();
+			for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+			{
+				for (const ASMPlayerCharacter* Character : SpawnedCharacters)
+				{
+					FoundCharacters.Reset();
+					SpatialGridSubsystem->QueryCone(Character->GetActorLocation(), Character->GetActorForwardVector(), 45.0f, Character->GetCatchDistance(), FoundCharacters, Character);
+				}
+			}
+			const double ConeQueryTime = FPlatformTime::Seconds() - StartTime;
+
+			const int32 NumQueries = FMath::Max(1, SpawnedCharacters.Num() * Iterations);
+			UE_LOG(LogSMSpatialGrid, Log, TEXT("[SM.Bench.SpatialGrid] 캐릭터 %d명 - 재구성 %.3fus, 물리 스윕 %.3fus/회, 격자 캡슐 %.3fus/회, 반경 %.3fus/회, 원뿔 %.3fus/회, 적중 %d/%d회, 불일치 %d회"),
+				SpawnedCharacters.Num(), RebuildTime * 1e6, SweepTime * 1e6 / NumQueries, QueryTime * 1e6 / NumQueries,
+				RadiusQueryTime * 1e6 / NumQueries, ConeQueryTime * 1e6 / NumQueries, NumQueryHits, NumSweepHits, NumMismatches);
+			SM_PERF_METRIC(TEXT("grid.rebuildUs.players%d"), RebuildTime * 1e6, NumPlayers);
+			SM_PERF_METRIC(TEXT("grid.capsuleQueryUs.players%d"), QueryTime * 1e6 / NumQueries, NumPlayers);
+			SM_PERF_METRIC(TEXT("grid.sweepUs.players%d"), SweepTime * 1e6 / NumQueries, NumPlayers);
+
+			SMBench::DestroyCharacters(SpawnedCharacters);
+		}
+
+		SpatialGridSubsystem->Rebuild();
+	}));
+#endif
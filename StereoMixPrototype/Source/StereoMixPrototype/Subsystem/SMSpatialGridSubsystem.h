@@ -0,0 +1,171 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SMSpatialGridSubsystem.generated.h"
+
+class ASMPlayerCharacter;
+
+DECLARE_LOG_CATEGORY_CLASS(LogSMSpatialGrid, Log, All);
+
+/** 격자 통계입니다. SM.Grid.Report로 출력합니다. */
+struct FSMSpatialGridStats
+{
+	uint32 NumRebuilds = 0;
+
+	double RebuildTimeMs = 0.0;
+
+	double MaxRebuildTimeMs = 0.0;
+
+	uint64 NumQueries = 0;
+
+	/** 쿼리가 거리 판정한 캐릭터 수와 그중 조건을 만족한 수입니다. */
+	uint64 NumTestedCharacters = 0;
+
+	uint64 NumFoundCharacters = 0;
+
+	/** 후보가 없어 물리 스윕을 건너뛴 잡기 수와 전체 잡기 수입니다. */
+	uint64 NumSkippedCatchSweeps = 0;
+
+	uint64 NumCatchPreselections = 0;
+};
+
+/**
+ * 캐릭터 위치를 XY 평면의 균일 격자로 색인해 물리 엔진 없이 주변 캐릭터를 찾는 서브시스템입니다.
+ * 프레임마다 한 번 계수 정렬로 다시 만들며, 위치와 캡슐 크기는 셀 순서로 정렬된 속성별 배열(SoA)에 저장되어
+ * 쿼리는 셀 범위의 연속된 메모리만 순회합니다. 잡기 후보 선별, 관련성, 중요도, AI 대상 탐색처럼 근처 캐릭터가 필요한 곳에서 사용합니다.
+ *
+ * 격자는 서브시스템 틱(액터 틱 이후)의 위치이므로 다음 프레임의 이동 중에는 그만큼 어긋날 수 있습니다.
+ * 정확한 판정이 필요하면 GetQueryMargin만큼 넓혀 후보를 찾은 뒤 호출하는 쪽에서 현재 위치로 다시 판정합니다.
+ * 캐릭터의 충돌이나 표시 여부가 바뀌거나 순간 이동하면 MarkDirty로 알리며, 다음 쿼리 전에 다시 만듭니다.
+ *
+ * SM.Grid.CatchPreselect 0       잡기 전에 격자로 후보를 확인하지 않고 항상 물리 스윕을 실행합니다.
+ * SM.Grid.CellSize               셀 한 변의 길이(cm)입니다.
+ * SM.Grid.Report [reset]         재구성 비용과 쿼리 통계를 출력합니다.
+ * SM.Bench.SpatialGrid [반복 횟수]  16~256명에서 격자 쿼리와 물리 스윕의 비용을 비교합니다.
+ */
+UCLASS()
+class STEREOMIXPROTOTYPE_API USMSpatialGridSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+public:
+	static bool IsCatchPreselectEnabled();
+
+	void RegisterCharacter(ASMPlayerCharacter* InCharacter);
+
+	void UnregisterCharacter(ASMPlayerCharacter* InCharacter);
+
+	/** 등록된 캐릭터의 현재 위치로 격자를 다시 만듭니다. 틱에서 호출되며, 같은 프레임에 스폰한 캐릭터를 바로 찾아야 할 때 직접 호출할 수 있습니다. */
+	void Rebuild();
+
+	/** 캐릭터의 충돌, 표시 여부, 어태치가 바뀌어 격자가 실제와 달라졌음을 알립니다. 다음 쿼리 전에 다시 만듭니다. */
+	void MarkDirty() { bDirty = true; }
+
+	/**
+	 * 격자를 만든 뒤 InMaxSpeed로 움직이는 캐릭터와 격자의 캐릭터가 서로 가까워졌을 수 있는 거리를 구합니다. 정확한 판정 전에 후보를 찾을 때 쿼리 범위에 더합니다.
+	 * 격자를 만든 지 MaxQueryAge보다 오래되어 격자를 믿을 수 없다면 false를 반환하므로 호출하는 쪽은 격자 없이 판정해야 합니다.
+	 */
+	bool GetQueryMargin(float InMaxSpeed, float& OutMargin);
+
+	/** 캐릭터의 위치가 InCenter에서 InRadius 안에 있는 캐릭터를 가까운 순서로 찾습니다. */
+	void QueryRadius(const FVector& InCenter, float InRadius, TArray<ASMPlayerCharacter*>& OutCharacters, const ASMPlayerCharacter* InIgnoreCharacter = nullptr);
+
+	/** InOrigin에서 InDirection 방향으로 반각 InHalfAngleDegrees, 거리 InRadius의 원뿔 안에 위치가 있는 캐릭터를 가까운 순서로 찾습니다. */
+	void QueryCone(const FVector& InOrigin, const FVector& InDirection, float InHalfAngleDegrees, float InRadius, TArray<ASMPlayerCharacter*>& OutCharacters, const ASMPlayerCharacter* InIgnoreCharacter = nullptr);
+
+	/**
+	 * 반지름 InRadius의 구체를 InStart에서 InEnd로 스윕했을 때 캡슐이 닿는 캐릭터를 찾습니다. 결과는 스윕 방향으로 가까운 순서입니다.
+	 * 잡기 스윕과 같은 모양이므로 물리 스윕 전에 후보를 선별하는 데 사용합니다.
+	 */
+	void QueryCapsule(const FVector& InStart, const FVector& InEnd, float InRadius, TArray<ASMPlayerCharacter*>& OutCharacters, const ASMPlayerCharacter* InIgnoreCharacter = nullptr);
+
+	/** 잡기 후보 선별 결과를 기록합니다. */
+	void RecordCatchPreselection(bool bInSkippedSweep);
+
+	int32 GetNumCharacters() const { return Characters.Num(); }
+
+	const FSMSpatialGridStats& GetStats() const { return Stats; }
+
+	void ResetStats() { Stats = FSMSpatialGridStats(); }
+
+	void PrintReport() const;
+
+	/** 이보다 오래된 격자로는 후보를 선별하지 않습니다. 프레임이 튀었을 때 넓어진 범위로 선별하는 것보다 물리 스윕이 정확합니다. */
+	static constexpr float MaxQueryAge = 0.1f;
+
+protected:
+	/** InMin, InMax의 XY 범위와 겹치는 셀의 범위를 구합니다. 격자 밖이라면 false를 반환합니다. */
+	bool GetCellRange(const FVector& InMin, const FVector& InMax, FIntPoint& OutMinCell, FIntPoint& OutMaxCell) const;
+
+	/**
+	 * 범위 안의 셀에 있는 캐릭터를 InPredicate(정렬된 인덱스, 정렬 키)로 판정해 통과한 캐릭터를 정렬 키 순서로 OutCharacters에 추가합니다.
+	 * 한 행의 셀들은 정렬된 배열에서 연속되므로 행마다 하나의 구간을 순회합니다.
+	 */
+	template <typename PredicateType>
+	void Gather(const FVector& InMin, const FVector& InMax, const ASMPlayerCharacter* InIgnoreCharacter, TArray<ASMPlayerCharacter*>& OutCharacters, PredicateType InPredicate);
+
+	TArray<TWeakObjectPtr<ASMPlayerCharacter>> Characters;
+
+	// 아래 배열은 셀 순서로 정렬되어 있으며 캐릭터 하나는 모든 배열에서 같은 인덱스를 가집니다.
+	TArray<FVector> SortedLocations;
+
+	TArray<float> SortedRadii;
+
+	/** 캡슐 중심에서 반구를 제외한 중심축 끝까지의 높이입니다. */
+	TArray<float> SortedHalfHeights;
+
+	/** 재구성 이후 등록 해제된 캐릭터는 nullptr로 바뀝니다. */
+	TArray<ASMPlayerCharacter*> SortedCharacters;
+
+	/** 셀마다 정렬된 배열에서 시작하는 인덱스입니다. 마지막 원소는 캐릭터 수입니다. */
+	TArray<int32> CellStarts;
+
+	/** 재구성 중 사용하는 캐릭터별 정보와 셀별 쓰기 위치입니다. 프레임 간 할당을 재사용합니다. */
+	struct FBuildEntry
+	{
+		ASMPlayerCharacter* Character = nullptr;
+
+		FVector Location = FVector::ZeroVector;
+
+		int32 CellIndex = 0;
+	};
+
+	TArray<FBuildEntry> BuildEntries;
+
+	TArray<int32> CellCursors;
+
+	/** 쿼리 결과의 정렬 키와 정렬된 인덱스입니다. 프레임 간 할당을 재사용합니다. */
+	TArray<TPair<float, int32>> FoundEntries;
+
+	FVector2D GridOrigin = FVector2D::ZeroVector;
+
+	float CellSize = 0.0f;
+
+	/** 캡슐 쿼리의 범위를 넓히기 위한 가장 큰 캐릭터의 반지름입니다. */
+	float MaxRadius = 0.0f;
+
+	/** 격자에 있는 캐릭터의 최대 속력과 현재 속력 중 가장 큰 값입니다. GetQueryMargin에서 사용합니다. */
+	float MaxSpeed = 0.0f;
+
+	double LastRebuildTime = 0.0;
+
+	uint32 bDirty = true;
+
+	FIntPoint GridSize = FIntPoint::ZeroValue;
+
+	FSMSpatialGridStats Stats;
+
+	/** 셀 수가 너무 많아지지 않도록 이 값을 넘으면 셀 크기를 키웁니다. */
+	static constexpr int32 MaxCells = 64 * 64;
+};
@@ -0,0 +1,307 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystem/SMTickSignificanceSubsystem.h"
+
+#include "Camera/PlayerCameraManager.h"
+#include "Character/SMPlayerCharacter.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "GameFramework/PlayerController.h"
+
+static bool GSMTickSignificanceEnabled = true;
+
+static FAutoConsoleVariableRef CVarSMTickSignificanceEnabled(
+	TEXT("SM.Tick.Significance"),
+	GSMTickSignificanceEnabled,
+	TEXT("중요도 기반 틱 관리를 사용합니다. 끄면 모든 캐릭터가 기본 설정으로 매 프레임 틱합니다."));
+
+static float GSMTickSignificanceBudgetMs = 0.1f;
+
+static FAutoConsoleVariableRef CVarSMTickSignificanceBudgetMs(
+	TEXT("SM.Tick.BudgetMs"),
+	GSMTickSignificanceBudgetMs,
+	TEXT("프레임당 중요도 평가에 사용할 수 있는 시간(ms)입니다. 초과하면 남은 캐릭터는 다음 프레임에 평가합니다."));
+
+void USMTickSignificanceSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	RemoveEntries([](const FEntry& Entry) { return !Entry.Character.IsValid(); });
+
+	if (!GSMTickSignificanceEnabled)
+	{
+		if (bWasEnabled)
+		{
+			RestoreAllEntries();
+			bWasEnabled = false;
+		}
+		return;
+	}
+
+	bWasEnabled = true;
+
+	FVector ViewLocation;
+	const bool bHasViewLocation = GetLocalViewLocation(ViewLocation);
+	EvaluateEntries(bHasViewLocation ? &ViewLocation : nullptr);
+
+	AccumulateSkippedTicks(DeltaTime);
+}
+
+TStatId USMTickSignificanceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USMTickSignificanceSubsystem, STATGROUP_Tickables);
+}
+
+bool USMTickSignificanceSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void USMTickSignificanceSubsystem::RegisterCharacter(ASMPlayerCharacter* InCharacter)
+{
+	FEntry& Entry = Entries.AddDefaulted_GetRef();
+	Entry.Character = InCharacter;
+}
+
+void USMTickSignificanceSubsystem::UnregisterCharacter(ASMPlayerCharacter* InCharacter)
+{
+	RemoveEntries([InCharacter](const FEntry& Entry) { return Entry.Character.Get() == InCharacter; });
+}
+
+void USMTickSignificanceSubsystem::EvaluateEntries(const FVector* InViewLocation)
+{
+	const int32 NumEntries = Entries.Num();
+	if (NumEntries == 0)
+	{
+		return;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	const double BudgetSeconds = GSMTickSignificanceBudgetMs * 0.001;
+
+	int32 NumEvaluated = 0;
+	while (NumEvaluated < NumEntries)
+	{
+		// 예산을 넘기더라도 프레임당 최소 한 명은 평가해 순환이 멈추지 않게 합니다.
+		if (NumEvaluated > 0 && FPlatformTime::Seconds() - StartTime > BudgetSeconds)
+		{
+			Stats.NumDeferredEvaluations += NumEntries - NumEvaluated;
+			break;
+		}
+
+		EvaluationCursor = EvaluationCursor < NumEntries ? EvaluationCursor : 0;
+		FEntry& Entry = Entries[EvaluationCursor++];
+		++NumEvaluated;
+
+		ASMPlayerCharacter* Character = Entry.Character.Get();
+		const ESMTickSignificance NewSignificance = CalculateSignificance(Character, InViewLocation);
+		if (NewSignificance != Entry.Significance)
+		{
+			ApplySignificance(Character, NewSignificance);
+			Entry.Significance = NewSignificance;
+		}
+	}
+
+	Stats.NumEvaluations += NumEvaluated;
+	Stats.MaxEvaluationTimeMs = FMath::Max(Stats.MaxEvaluationTimeMs, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+ESMTickSignificance USMTickSignificanceSubsystem::CalculateSignificance(const ASMPlayerCharacter* InCharacter, const FVector* InViewLocation) const
+{
+	if (InCharacter->IsLocallyControlled())
+	{
+		return ESMTickSignificance::LocallyControlled;
+	}
+
+	if (InCharacter->HasAuthority())
+	{
+		// 잡힌 캐릭터는 다시 잡힐 수 없으므로 위치 기록이 필요 없고, Yaw 보간도 중단된 상태입니다.
+		const bool bIsCaught = InCharacter->GetReplicatedState().State == EPlayerCharacterState::Caught;
+		return bIsCaught ? ESMTickSignificance::Dormant : ESMTickSignificance::AuthorityActive;
+	}
+
+	if (!InViewLocation)
+	{
+		return ESMTickSignificance::ProxyFar;
+	}
+
+	const double DistanceSquared = FVector::DistSquared(*InViewLocation, InCharacter->GetActorLocation());
+	if (DistanceSquared <= FMath::Square(NearDistance))
+	{
+		return ESMTickSignificance::ProxyNear;
+	}
+
+	return DistanceSquared <= FMath::Square(MidDistance) ? ESMTickSignificance::ProxyMid : ESMTickSignificance::ProxyFar;
+}
+
+void USMTickSignificanceSubsystem::ApplySignificance(ASMPlayerCharacter* InCharacter, ESMTickSignificance InSignificance)
+{
+	USkeletalMeshComponent* Mesh = InCharacter->GetMesh();
+	switch (InSignificance)
+	{
+		case ESMTickSignificance::LocallyControlled:
+		{
+			InCharacter->SetTickGroup(TG_PrePhysics);
+			InCharacter->SetActorTickEnabled(true);
+			Mesh->SetComponentTickInterval(0.0f);
+			break;
+		}
+		case ESMTickSignificance::AuthorityActive:
+		{
+			// 이번 프레임의 이동이 끝난 위치를 기록하기 위해 이동 후에 틱합니다.
+			InCharacter->SetTickGroup(TG_PostPhysics);
+			InCharacter->SetActorTickEnabled(true);
+			Mesh->SetComponentTickInterval(0.0f);
+			break;
+		}
+		case ESMTickSignificance::Dormant:
+		{
+			InCharacter->SetActorTickEnabled(false);
+			Mesh->SetComponentTickInterval(0.0f);
+			break;
+		}
+		case ESMTickSignificance::ProxyNear:
+		{
+			InCharacter->SetActorTickEnabled(false);
+			Mesh->SetComponentTickInterval(0.0f);
+			break;
+		}
+		case ESMTickSignificance::ProxyMid:
+		{
+			InCharacter->SetActorTickEnabled(false);
+			Mesh->SetComponentTickInterval(MidMeshTickInterval);
+			break;
+		}
+		case ESMTickSignificance::ProxyFar:
+		{
+			InCharacter->SetActorTickEnabled(false);
+			Mesh->SetComponentTickInterval(FarMeshTickInterval);
+			break;
+		}
+		default:
+		{
+			InCharacter->SetTickGroup(TG_PrePhysics);
+			InCharacter->SetActorTickEnabled(true);
+			Mesh->SetComponentTickInterval(0.0f);
+			break;
+		}
+	}
+}
+
+void USMTickSignificanceSubsystem::RestoreAllEntries()
+{
+	for (FEntry& Entry : Entries)
+	{
+		ApplySignificance(Entry.Character.Get(), ESMTickSignificance::None);
+		Entry.Significance = ESMTickSignificance::None;
+	}
+}
+
+bool USMTickSignificanceSubsystem::GetLocalViewLocation(FVector& OutViewLocation) const
+{
+	const APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+	if (!PlayerController || !PlayerController->IsLocalController() || !PlayerController->PlayerCameraManager)
+	{
+		return false;
+	}
+
+	OutViewLocation = PlayerController->PlayerCameraManager->GetCameraLocation();
+	return true;
+}
+
+void USMTickSignificanceSubsystem::AccumulateSkippedTicks(float DeltaTime)
+{
+	++Stats.NumFrames;
+	Stats.NumManagedCharacterFrames += Entries.Num();
+
+	for (const FEntry& Entry : Entries)
+	{
+		float MeshTickInterval = 0.0f;
+		switch (Entry.Significance)
+		{
+			case ESMTickSignificance::Dormant:
+			case ESMTickSignificance::ProxyNear:
+			{
+				++Stats.NumSkippedActorTicks;
+				break;
+			}
+			case ESMTickSignificance::ProxyMid:
+			{
+				++Stats.NumSkippedActorTicks;
+				MeshTickInterval = MidMeshTickInterval;
+				break;
+			}
+			case ESMTickSignificance::ProxyFar:
+			{
+				++Stats.NumSkippedActorTicks;
+				MeshTickInterval = FarMeshTickInterval;
+				break;
+			}
+			default:
+			{
+				break;
+			}
+		}
+
+		if (MeshTickInterval > DeltaTime)
+		{
+			Stats.NumSkippedMeshTicks += 1.0 - DeltaTime / MeshTickInterval;
+		}
+	}
+}
+
+void USMTickSignificanceSubsystem::RemoveEntries(TFunctionRef<bool(const FEntry&)> InPredicate)
+{
+	// 뒤쪽 항목을 빈자리로 옮기면 아직 평가하지 않은 항목이 커서 앞으로 가서 한 바퀴 동안 건너뛰어집니다.
+	int32 NumKept = 0;
+	int32 NewEvaluationCursor = EvaluationCursor;
+	for (int32 i = 0; i < Entries.Num(); ++i)
+	{
+		if (InPredicate(Entries[i]))
+		{
+			if (i < EvaluationCursor)
+			{
+				--NewEvaluationCursor;
+			}
+			continue;
+		}
+
+		if (NumKept != i)
+		{
+			Entries[NumKept] = MoveTemp(Entries[i]);
+		}
+		++NumKept;
+	}
+
+	Entries.SetNum(NumKept, false);
+	EvaluationCursor = NewEvaluationCursor;
+}
+
+#if !UE_BUILD_SHIPPING
+static FAutoConsoleCommandWithWorldAndArgs SMTickReportCommand(
+	TEXT("SM.Tick.Report"),
+	TEXT("중요도 기반 틱 관리의 통계를 출력합니다. 인자로 reset을 주면 통계를 초기화합니다."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		USMTickSignificanceSubsystem* TickSignificanceSubsystem = World ? World->GetSubsystem<USMTickSignificanceSubsystem>() : nullptr;
+		if (!TickSignificanceSubsystem)
+		{
+			return;
+		}
+
+		if (Args.Num() > 0 && Args[0] == TEXT("reset"))
+		{
+			TickSignificanceSubsystem->ResetStats();
+			return;
+		}
+
+		const FSMTickSignificanceStats& Stats = TickSignificanceSubsystem->GetStats();
+		const double NumFrames = FMath::Max(Stats.NumFrames, 1u);
+		UE_LOG(LogSMTickSignificance, Log, TEXT("[SM.Tick.Report] %u프레임, 평균 캐릭터 %.1f명 - 건너뛴 액터 틱 %llu회(프레임당 %.1f), 건너뛴 메시 틱 약 %.0f회(프레임당 %.1f)"),
+			Stats.NumFrames, Stats.NumManagedCharacterFrames / NumFrames,
+			Stats.NumSkippedActorTicks, Stats.NumSkippedActorTicks / NumFrames,
+			Stats.NumSkippedMeshTicks, Stats.NumSkippedMeshTicks / NumFrames);
+		UE_LOG(LogSMTickSignificance, Log, TEXT("[SM.Tick.Report] 평가 %llu회, 예산 초과로 미룬 평가 %llu회, 최대 평가 시간 %.3fms (예산 %.3fms)"),
+			Stats.NumEvaluations, Stats.NumDeferredEvaluations, Stats.MaxEvaluationTimeMs, GSMTickSignificanceBudgetMs);
+	}));
+#endif
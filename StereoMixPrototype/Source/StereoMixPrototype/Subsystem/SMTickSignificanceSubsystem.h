@@ -0,0 +1,121 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SMTickSignificanceSubsystem.generated.h"
+
+class ASMPlayerCharacter;
+
+DECLARE_LOG_CATEGORY_CLASS(LogSMTickSignificance, Log, All);
+
+/** 캐릭터의 틱 중요도입니다. 중요도마다 액터 틱의 활성화 여부, 틱 그룹, 메시 틱 간격이 정해집니다. */
+enum class ESMTickSignificance : uint8
+{
+	/** 아직 평가되지 않았습니다. */
+	None,
+	/** 로컬 캐릭터입니다. 입력과 회전을 처리하기 위해 매 프레임 이동 전에 틱합니다. */
+	LocallyControlled,
+	/** 서버의 원격 캐릭터입니다. 위치 기록과 Yaw 보간을 위해 이동 후에 틱합니다. */
+	AuthorityActive,
+	/** 할 일이 없는 캐릭터입니다. 액터 틱을 끕니다. (서버에서 잡힌 캐릭터 등) */
+	Dormant,
+	/** 시뮬레이티드 프록시입니다. 액터 틱은 끄고, 카메라와의 거리에 따라 메시 틱 간격을 늘립니다. */
+	ProxyNear,
+	ProxyMid,
+	ProxyFar
+};
+
+/** 틱 관리 통계입니다. SM.Tick.Report로 출력합니다. */
+struct FSMTickSignificanceStats
+{
+	uint32 NumFrames = 0;
+
+	uint64 NumManagedCharacterFrames = 0;
+
+	/** 액터 틱이 꺼져 있어 실행되지 않은 틱 수입니다. */
+	uint64 NumSkippedActorTicks = 0;
+
+	/** 메시 틱 간격으로 건너뛴 틱 수의 추정치입니다. */
+	double NumSkippedMeshTicks = 0.0;
+
+	uint64 NumEvaluations = 0;
+
+	/** 예산을 초과해 다음 프레임으로 미뤄진 평가 수입니다. */
+	uint64 NumDeferredEvaluations = 0;
+
+	double MaxEvaluationTimeMs = 0.0;
+};
+
+/**
+ * 캐릭터의 중요도를 평가해 틱 설정을 관리하는 서브시스템입니다.
+ * 로컬 조종 여부, 권한, 상태(Normal, Caught), 로컬 카메라와의 거리로 중요도를 정하고, 중요도가 바뀐 경우에만 틱 설정을 변경합니다.
+ * 평가는 프레임당 SM.Tick.BudgetMs 안에서 순환하며 진행되고, 남은 캐릭터는 다음 프레임에 이어서 평가합니다.
+ */
+UCLASS()
+class STEREOMIXPROTOTYPE_API USMTickSignificanceSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+public:
+	void RegisterCharacter(ASMPlayerCharacter* InCharacter);
+
+	void UnregisterCharacter(ASMPlayerCharacter* InCharacter);
+
+	const FSMTickSignificanceStats& GetStats() const { return Stats; }
+
+	void ResetStats() { Stats = FSMTickSignificanceStats(); }
+
+protected:
+	struct FEntry
+	{
+		TWeakObjectPtr<ASMPlayerCharacter> Character;
+
+		ESMTickSignificance Significance = ESMTickSignificance::None;
+	};
+
+	/** 예산 안에서 캐릭터의 중요도를 평가하고 바뀐 경우에만 적용합니다. */
+	void EvaluateEntries(const FVector* InViewLocation);
+
+	ESMTickSignificance CalculateSignificance(const ASMPlayerCharacter* InCharacter, const FVector* InViewLocation) const;
+
+	static void ApplySignificance(ASMPlayerCharacter* InCharacter, ESMTickSignificance InSignificance);
+
+	/** 틱 관리를 끌 때 모든 캐릭터를 기본 틱 설정으로 되돌립니다. */
+	void RestoreAllEntries();
+
+	/** 로컬 카메라 위치입니다. 데디케이티드 서버처럼 로컬 플레이어가 없으면 false를 반환합니다. */
+	bool GetLocalViewLocation(FVector& OutViewLocation) const;
+
+	void AccumulateSkippedTicks(float DeltaTime);
+
+	/** 순서를 유지하며 항목을 제거하고, 커서 앞에서 제거된 수만큼 커서를 당겨 순환 중인 평가 순서가 바뀌지 않게 합니다. */
+	void RemoveEntries(TFunctionRef<bool(const FEntry&)> InPredicate);
+
+	TArray<FEntry> Entries;
+
+	/** 다음 평가를 시작할 인덱스입니다. */
+	int32 EvaluationCursor = 0;
+
+	FSMTickSignificanceStats Stats;
+
+	uint32 bWasEnabled = true;
+
+public:
+	static constexpr float NearDistance = 2000.0f;
+
+	static constexpr float MidDistance = 5000.0f;
+
+	static constexpr float MidMeshTickInterval = 1.0f / 30.0f;
+
+	static constexpr float FarMeshTickInterval = 1.0f / 15.0f;
+};
@@ -0,0 +1,353 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystem/SMTraceSubsystem.h"
+
+#include "Character/SMPlayerCharacter.h"
+#include "CoreGlobals.h"
+#include "Engine/World.h"
+#include "Log/SMBench.h"
+#include "Log/SMPerfMetric.h"
+
+static bool GSMTraceAsyncEnabled = true;
+
+static FAutoConsoleVariableRef CVarSMTraceAsyncEnabled(
+	TEXT("SM.Trace.Async"),
+	GSMTraceAsyncEnabled,
+	TEXT("비동기 트레이스 요청을 엔진의 비동기 트레이스로 실행합니다. 끄면 요청 즉시 게임 스레드에서 실행하고 결과는 같은 시점에 전달합니다."));
+
+void USMTraceSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	TraceDelegate.BindUObject(this, &USMTraceSubsystem::HandleTraceDone);
+}
+
+void USMTraceSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	FlushResults();
+
+	++Stats.NumFrames;
+	Stats.MaxAsyncTracesPerFrame = FMath::Max(Stats.MaxAsyncTracesPerFrame, NumAsyncTracesThisFrame);
+	NumAsyncTracesThisFrame = 0;
+
+	if (Benchmark)
+	{
+		TickBenchmark();
+	}
+}
+
+TStatId USMTraceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USMTraceSubsystem, STATGROUP_Tickables);
+}
+
+bool USMTraceSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+FSMTraceHandle USMTraceSubsystem::RequestTrace(const FVector& InStart, const FVector& InEnd, const FCollisionShape& InShape, const FCollisionObjectQueryParams& InObjectQueryParams, const FCollisionQueryParams& InQueryParams, FSMTraceDelegate InDelegate)
+{
+	FSMTraceHandle Handle;
+	Handle.Id = NextRequestId++;
+	if (NextRequestId == 0)
+	{
+		NextRequestId = 1;
+	}
+
+	if (InDelegate.IsBound())
+	{
+		FPendingDelegate& PendingDelegate = PendingDelegates.Add(Handle.Id);
+		PendingDelegate.Delegate = MoveTemp(InDelegate);
+		PendingDelegate.FrameNumber = GFrameCounter;
+	}
+	else
+	{
+		PendingPollRequests.Add(Handle.Id, GFrameCounter);
+	}
+
+	if (!GSMTraceAsyncEnabled)
+	{
+		FSMTraceResult& DeferredResult = DeferredResults.Emplace_GetRef(Handle.Id, FSMTraceResult()).Value;
+		DeferredResult.bHit = TraceSync(DeferredResult.HitResult, InStart, InEnd, InShape, InObjectQueryParams, InQueryParams);
+		return Handle;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	UWorld* World = GetWorld();
+	if (InShape.IsLine())
+	{
+		World->AsyncLineTraceByObjectType(EAsyncTraceType::Single, InStart, InEnd, InObjectQueryParams, InQueryParams, &TraceDelegate, Handle.Id);
+	}
+	else
+	{
+		World->AsyncSweepByObjectType(EAsyncTraceType::Single, InStart, InEnd, FQuat::Identity, InObjectQueryParams, InShape, InQueryParams, &TraceDelegate, Handle.Id);
+	}
+
+	++Stats.NumAsyncTraces;
+	++NumAsyncTracesThisFrame;
+	Stats.AsyncRequestTimeMs += (FPlatformTime::Seconds() - StartTime) * 1000.0;
+	return Handle;
+}
+
+ESMTraceStatus USMTraceSubsystem::PollResult(const FSMTraceHandle& InHandle, FSMTraceResult& OutResult)
+{
+	if (!InHandle.IsValid())
+	{
+		return ESMTraceStatus::Expired;
+	}
+
+	FCompletedTrace CompletedTrace;
+	if (CompletedTraces.RemoveAndCopyValue(InHandle.Id, CompletedTrace))
+	{
+		OutResult = MoveTemp(CompletedTrace.Result);
+		return ESMTraceStatus::Ready;
+	}
+
+	return PendingPollRequests.Contains(InHandle.Id) ? ESMTraceStatus::Pending : ESMTraceStatus::Expired;
+}
+
+bool USMTraceSubsystem::TraceSync(FHitResult& OutHitResult, const FVector& InStart, const FVector& InEnd, const FCollisionShape& InShape, const FCollisionObjectQueryParams& InObjectQueryParams, const FCollisionQueryParams& InQueryParams)
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	const UWorld* World = GetWorld();
+	const bool bHit = InShape.IsLine()
+		? World->LineTraceSingleByObjectType(OutHitResult, InStart, InEnd, InObjectQueryParams, InQueryParams)
+		: World->SweepSingleByObjectType(OutHitResult, InStart, InEnd, FQuat::Identity, InObjectQueryParams, InShape, InQueryParams);
+
+	++Stats.NumSyncTraces;
+	Stats.SyncTraceTimeMs += (FPlatformTime::Seconds() - StartTime) * 1000.0;
+	return bHit;
+}
+
+void USMTraceSubsystem::PrintReport() const
+{
+	const double NumFrames = FMath::Max(Stats.NumFrames, 1u);
+	UE_LOG(LogSMTrace, Log, TEXT("[SM.Trace] %u프레임 - 동기 %llu회 (프레임당 %.3fms), 비동기 %llu회 (프레임당 최대 %u회, 요청 %.3fms, 전달 %.3fms)"),
+		Stats.NumFrames, Stats.NumSyncTraces, Stats.SyncTraceTimeMs / NumFrames,
+		Stats.NumAsyncTraces, Stats.MaxAsyncTracesPerFrame, Stats.AsyncRequestTimeMs / NumFrames, Stats.AsyncDeliveryTimeMs / NumFrames);
+}
+
+void USMTraceSubsystem::HandleTraceDone(const FTraceHandle& InTraceHandle, FTraceDatum& InTraceDatum)
+{
+	FSMTraceResult Result;
+	if (InTraceDatum.OutHits.Num() > 0)
+	{
+		Result.HitResult = InTraceDatum.OutHits[0];
+		Result.bHit = Result.HitResult.bBlockingHit;
+	}
+
+	DeliverResult(InTraceDatum.UserData, Result);
+}
+
+void USMTraceSubsystem::DeliverResult(uint32 InId, const FSMTraceResult& InResult)
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	FPendingDelegate PendingDelegate;
+	if (PendingDelegates.RemoveAndCopyValue(InId, PendingDelegate))
+	{
+		PendingDelegate.Delegate.ExecuteIfBound(InResult);
+	}
+	else if (PendingPollRequests.Remove(InId) > 0)
+	{
+		FCompletedTrace& CompletedTrace = CompletedTraces.Add(InId);
+		CompletedTrace.Result = InResult;
+		CompletedTrace.FrameNumber = GFrameCounter;
+	}
+
+	Stats.AsyncDeliveryTimeMs += (FPlatformTime::Seconds() - StartTime) * 1000.0;
+}
+
+void USMTraceSubsystem::FlushResults()
+{
+	// 콜백 안에서 새 요청이 들어올 수 있으므로 복사한 뒤 전달합니다.
+	if (DeferredResults.Num() > 0)
+	{
+		TArray<TPair<uint32, FSMTraceResult>> Results = MoveTemp(DeferredResults);
+		DeferredResults.Reset();
+		for (const TPair<uint32, FSMTraceResult>& Result : Results)
+		{
+			DeliverResult(Result.Key, Result.Value);
+		}
+	}
+
+	for (TMap<uint32, FCompletedTrace>::TIterator It = CompletedTraces.CreateIterator(); It; ++It)
+	{
+		if (GFrameCounter - It.Value().FrameNumber > ResultLifetimeFrames)
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	// 월드 정리 등으로 엔진이 결과를 전달하지 않은 요청도 기다리지 않도록 Expired로 바꿉니다.
+	for (TMap<uint32, uint64>::TIterator It = PendingPollRequests.CreateIterator(); It; ++It)
+	{
+		if (GFrameCounter - It.Value() > ResultLifetimeFrames)
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	// 콜백도 같은 기한이 지나면 버립니다. 요청한 오브젝트가 파괴되어 바인딩이 풀린 콜백은 기다리지 않고 버립니다.
+	for (TMap<uint32, FPendingDelegate>::TIterator It = PendingDelegates.CreateIterator(); It; ++It)
+	{
+		if (!It.Value().Delegate.IsBound() || GFrameCounter - It.Value().FrameNumber > ResultLifetimeFrames)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void USMTraceSubsystem::StartBenchmark(const TArray<ASMPlayerCharacter*>& InCharacters, int32 InNumFrames)
+{
+	Benchmark = MakeUnique<FBenchmark>();
+	Benchmark->Characters.Append(InCharacters);
+	Benchmark->NumFrames = InNumFrames;
+	Benchmark->DeliveryTimeMarkMs = Stats.AsyncDeliveryTimeMs;
+}
+
+void USMTraceSubsystem::TickBenchmark()
+{
+	// 결과 전달은 프레임 시작 시 엔진이 호출하므로 지난 틱 이후 누적된 전달 시간을 비동기 단계에 더합니다.
+	Benchmark->TraceTimeMs[1] += Stats.AsyncDeliveryTimeMs - Benchmark->DeliveryTimeMarkMs;
+	Benchmark->DeliveryTimeMarkMs = Stats.AsyncDeliveryTimeMs;
+
+	// 마지막 비동기 프레임의 결과가 전달될 때까지 한 프레임 더 기다립니다.
+	if (Benchmark->Frame >= Benchmark->NumFrames * 2)
+	{
+		FinishBenchmark();
+		return;
+	}
+
+	const int32 Phase = Benchmark->Frame < Benchmark->NumFrames ? 0 : 1;
+	const bool bAsync = Phase == 1;
+	const FSMTraceStats PreviousStats = Stats;
+	++Benchmark->Frame;
+
+	// 잡기 스윕, 바닥 트레이스와 같은 조건입니다.
+	FCollisionObjectQueryParams PawnQueryParams;
+	PawnQueryParams.AddObjectTypesToQuery(ECC_Pawn);
+	FCollisionObjectQueryParams FloorQueryParams;
+	FloorQueryParams.AddObjectTypesToQuery(ECC_WorldStatic);
+	const FCollisionShape CatchShape = FCollisionShape::MakeSphere(50.0f);
+
+	for (const TWeakObjectPtr<ASMPlayerCharacter>& CharacterPtr : Benchmark->Characters)
+	{
+		const ASMPlayerCharacter* Character = CharacterPtr.Get();
+		if (!Character)
+		{
+			continue;
+		}
+
+		const FVector Location = Character->GetActorLocation();
+		const FVector CatchEnd = Location + Character->GetActorForwardVector() * 300.0f;
+		const FVector FloorEnd = Location - FVector(0.0, 0.0, 10000.0);
+		const FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(SMBenchTrace), false, Character);
+		if (bAsync)
+		{
+			RequestTrace(Location, CatchEnd, CatchShape, PawnQueryParams, QueryParams, FSMTraceDelegate::CreateUObject(this, &USMTraceSubsystem::HandleBenchmarkResult));
+			RequestTrace(Location, FloorEnd, FCollisionShape(), FloorQueryParams, QueryParams, FSMTraceDelegate::CreateUObject(this, &USMTraceSubsystem::HandleBenchmarkResult));
+		}
+		else
+		{
+			FHitResult HitResult;
+			Benchmark->NumHits[Phase] += TraceSync(HitResult, Location, CatchEnd, CatchShape, PawnQueryParams, QueryParams) ? 1 : 0;
+			Benchmark->NumHits[Phase] += TraceSync(HitResult, Location, FloorEnd, FCollisionShape(), FloorQueryParams, QueryParams) ? 1 : 0;
+		}
+	}
+
+	Benchmark->TraceTimeMs[Phase] += (Stats.SyncTraceTimeMs - PreviousStats.SyncTraceTimeMs)
+		+ (Stats.AsyncRequestTimeMs - PreviousStats.AsyncRequestTimeMs);
+	Benchmark->GameThreadTimeMs[Phase] += FPlatformTime::ToMilliseconds(GGameThreadTime);
+}
+
+void USMTraceSubsystem::FinishBenchmark()
+{
+	const int32 NumCharacters = Benchmark->Characters.Num();
+	const int32 NumFrames = FMath::Max(Benchmark->NumFrames, 1);
+	const TCHAR* const PhaseNames[] = { TEXT("sync"), TEXT("async") };
+	for (int32 Phase = 0; Phase < 2; ++Phase)
+	{
+		const double TraceTimeUs = Benchmark->TraceTimeMs[Phase] * 1000.0 / NumFrames;
+		UE_LOG(LogSMTrace, Log, TEXT("[SM.Bench.Trace] 캐릭터 %d명, %s %d프레임 - 게임 스레드 트레이스 %.1fus/프레임, 게임 스레드 %.3fms/프레임, 적중 %u회"),
+			NumCharacters, PhaseNames[Phase], NumFrames, TraceTimeUs, Benchmark->GameThreadTimeMs[Phase] / NumFrames, Benchmark->NumHits[Phase]);
+		SM_PERF_METRIC(TEXT("trace.gameThreadUs.%s.chars%d"), TraceTimeUs, PhaseNames[Phase], NumCharacters);
+	}
+
+	for (const TWeakObjectPtr<ASMPlayerCharacter>& CharacterPtr : Benchmark->Characters)
+	{
+		ASMPlayerCharacter* Character = CharacterPtr.Get();
+		if (Character)
+		{
+			Character->Destroy();
+		}
+	}
+
+	Benchmark.Reset();
+}
+
+void USMTraceSubsystem::HandleBenchmarkResult(const FSMTraceResult& InResult)
+{
+	if (Benchmark && InResult.bHit)
+	{
+		++Benchmark->NumHits[1];
+	}
+}
+
+#if !UE_BUILD_SHIPPING
+static FAutoConsoleCommandWithWorldAndArgs SMTraceReportCommand(
+	TEXT("SM.Trace.Report"),
+	TEXT("게임 스레드의 동기, 비동기 트레이스 비용을 출력합니다. 인자로 reset을 주면 통계를 초기화합니다."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		USMTraceSubsystem* TraceSubsystem = World ? World->GetSubsystem<USMTraceSubsystem>() : nullptr;
+		if (!TraceSubsystem)
+		{
+			return;
+		}
+
+		if (Args.Num() > 0 && Args[0] == TEXT("reset"))
+		{
+			TraceSubsystem->ResetStats();
+			return;
+		}
+
+		TraceSubsystem->PrintReport();
+	}));
+
+/**
+ * 캐릭터마다 매 프레임 잡기 스윕과 바닥 트레이스를 실행할 때의 게임 스레드 비용을 동기와 비동기로 비교합니다.
+ * 여러 프레임에 걸쳐 측정하므로 결과는 측정이 끝난 뒤 로그로 출력됩니다.
+ * 사용법: SM.Bench.Trace [캐릭터 수] [프레임 수]
+ */
+static FAutoConsoleCommandWithWorldAndArgs SMBenchTraceCommand(
+	TEXT("SM.Bench.Trace"),
+	TEXT("임시 캐릭터가 매 프레임 트레이스할 때의 게임 스레드 비용을 동기, 비동기로 측정합니다. 인자: 캐릭터 수(기본 64), 단계별 프레임 수(기본 120)"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		USMTraceSubsystem* TraceSubsystem = World ? World->GetSubsystem<USMTraceSubsystem>() : nullptr;
+		if (!TraceSubsystem || World->GetNetMode() == NM_Client)
+		{
+			UE_LOG(LogSMTrace, Warning, TEXT("[SM.Bench.Trace] 서버 게임 월드에서만 실행할 수 있습니다."));
+			return;
+		}
+
+		const int32 NumCharacters = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 64;
+		const int32 NumFrames = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 120;
+		const double AreaSize = 3000.0;
+
+		UClass* CharacterClass = SMBench::GetCharacterClass(World);
+
+		FRandomStream RandomStream(1234);
+		TArray<ASMPlayerCharacter*> SpawnedCharacters;
+		SMBench::SpawnRandomCharacters(World, CharacterClass, NumCharacters, AreaSize, RandomStream, SpawnedCharacters);
+
+		TraceSubsystem->StartBenchmark(SpawnedCharacters, NumFrames);
+	}));
+#endif
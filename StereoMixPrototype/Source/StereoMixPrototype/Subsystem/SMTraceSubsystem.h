@@ -0,0 +1,182 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WorldCollision.h"
+#include "SMTraceSubsystem.generated.h"
+
+class ASMPlayerCharacter;
+
+DECLARE_LOG_CATEGORY_CLASS(LogSMTrace, Log, All);
+
+/** 비동기 트레이스 요청의 핸들입니다. 콜백 없이 요청했다면 다음 프레임부터 PollResult로 결과를 가져갑니다. */
+struct FSMTraceHandle
+{
+	bool IsValid() const { return Id != 0; }
+
+	void Reset() { Id = 0; }
+
+	uint32 Id = 0;
+};
+
+/** PollResult의 결과입니다. */
+enum class ESMTraceStatus : uint8
+{
+	/** 결과가 아직 도착하지 않았습니다. */
+	Pending,
+	/** 결과를 가져왔습니다. */
+	Ready,
+	/** 결과를 이미 가져갔거나 ResultLifetimeFrames가 지나 버려졌거나 알 수 없는 핸들입니다. 다시 요청해야 합니다. */
+	Expired
+};
+
+struct FSMTraceResult
+{
+	FHitResult HitResult;
+
+	uint32 bHit = false;
+};
+
+DECLARE_DELEGATE_OneParam(FSMTraceDelegate, const FSMTraceResult& /*InResult*/);
+
+/** 게임 스레드의 트레이스 비용 통계입니다. SM.Trace.Report로 출력합니다. */
+struct FSMTraceStats
+{
+	uint32 NumFrames = 0;
+
+	uint64 NumSyncTraces = 0;
+
+	uint64 NumAsyncTraces = 0;
+
+	uint32 MaxAsyncTracesPerFrame = 0;
+
+	/** 동기 트레이스의 실행 시간입니다. */
+	double SyncTraceTimeMs = 0.0;
+
+	/** 비동기 트레이스의 요청과 결과 전달에 게임 스레드가 쓴 시간입니다. 트레이스 자체는 워커 스레드에서 실행됩니다. */
+	double AsyncRequestTimeMs = 0.0;
+
+	double AsyncDeliveryTimeMs = 0.0;
+};
+
+/**
+ * 게임플레이 트레이스를 모아 엔진의 비동기 트레이스로 실행하는 서브시스템입니다.
+ * 한 프레임 동안 요청된 트레이스는 월드 틱이 끝날 때 엔진이 묶어서 워커 스레드로 실행하고, 다음 프레임 시작 시 콜백으로 전달하거나
+ * PollResult로 가져갈 수 있게 보관합니다. 잡기 판정처럼 입력 프레임에 결과가 필요한 트레이스는 TraceSync를 사용합니다.
+ * 모든 트레이스는 오브젝트 타입 기준이며 모양이 선(FCollisionShape 기본값)이면 라인 트레이스, 아니면 스윕으로 실행합니다.
+ *
+ * SM.Trace.Async 0              비동기 요청을 요청 즉시 동기로 실행합니다. 결과는 비동기와 같은 시점에 전달됩니다.
+ * SM.Trace.Report [reset]       게임 스레드의 트레이스 비용을 출력합니다.
+ * SM.Bench.Trace [캐릭터 수] [프레임 수]  캐릭터마다 매 프레임 잡기 스윕과 바닥 트레이스를 동기, 비동기로 실행해 비교합니다.
+ */
+UCLASS()
+class STEREOMIXPROTOTYPE_API USMTraceSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+public:
+	/** 비동기 트레이스를 요청합니다. InDelegate가 바인딩되어 있으면 결과를 콜백으로 전달하고, 아니면 PollResult로 가져갈 때까지 보관합니다. */
+	FSMTraceHandle RequestTrace(const FVector& InStart, const FVector& InEnd, const FCollisionShape& InShape, const FCollisionObjectQueryParams& InObjectQueryParams, const FCollisionQueryParams& InQueryParams, FSMTraceDelegate InDelegate = FSMTraceDelegate());
+
+	/**
+	 * 결과가 도착했다면 가져가고 Ready를 반환합니다. 가져간 결과는 삭제되며, 가져가지 않은 결과는 ResultLifetimeFrames가 지나면 버려집니다.
+	 * 버려진 결과나 알 수 없는 핸들은 Expired이므로 호출하는 쪽은 핸들을 지우고 다시 요청해야 합니다.
+	 */
+	ESMTraceStatus PollResult(const FSMTraceHandle& InHandle, FSMTraceResult& OutResult);
+
+	/** 가져가지 않은 결과와 결과를 기다리는 요청을 보관하는 프레임 수입니다. */
+	static constexpr uint64 ResultLifetimeFrames = 2;
+
+	/** 결과가 바로 필요한 트레이스를 게임 스레드에서 실행합니다. */
+	bool TraceSync(FHitResult& OutHitResult, const FVector& InStart, const FVector& InEnd, const FCollisionShape& InShape, const FCollisionObjectQueryParams& InObjectQueryParams, const FCollisionQueryParams& InQueryParams);
+
+	const FSMTraceStats& GetStats() const { return Stats; }
+
+	void ResetStats() { Stats = FSMTraceStats(); }
+
+	void PrintReport() const;
+
+	/** 캐릭터마다 매 프레임 트레이스를 요청하는 벤치마크를 시작합니다. InNumFrames 동안 동기로, 이어서 같은 프레임 수 동안 비동기로 실행합니다. */
+	void StartBenchmark(const TArray<ASMPlayerCharacter*>& InCharacters, int32 InNumFrames);
+
+protected:
+	void HandleTraceDone(const FTraceHandle& InTraceHandle, FTraceDatum& InTraceDatum);
+
+	/** 콜백이 있으면 호출하고, 없으면 폴링을 위해 보관합니다. */
+	void DeliverResult(uint32 InId, const FSMTraceResult& InResult);
+
+	/** 가져가지 않은 결과와 동기로 대신 실행한 결과를 정리합니다. */
+	void FlushResults();
+
+	uint32 NextRequestId = 1;
+
+	/** 엔진 비동기 트레이스의 UserData에 요청 ID를 담아 모든 요청이 하나의 델리게이트를 공유합니다. */
+	FTraceDelegate TraceDelegate;
+
+	struct FPendingDelegate
+	{
+		FSMTraceDelegate Delegate;
+
+		uint64 FrameNumber = 0;
+	};
+
+	/** 콜백으로 결과를 기다리는 요청과 요청한 프레임입니다. 결과가 전달되지 않은 채 ResultLifetimeFrames가 지나면 버려집니다. */
+	TMap<uint32, FPendingDelegate> PendingDelegates;
+
+	/** 콜백 없이 요청해 결과를 기다리는 요청과 요청한 프레임입니다. 결과가 전달되지 않은 채 ResultLifetimeFrames가 지나면 버려집니다. */
+	TMap<uint32, uint64> PendingPollRequests;
+
+	struct FCompletedTrace
+	{
+		FSMTraceResult Result;
+
+		uint64 FrameNumber = 0;
+	};
+
+	TMap<uint32, FCompletedTrace> CompletedTraces;
+
+	/** SM.Trace.Async가 꺼져 있을 때 동기로 실행한 결과입니다. 비동기와 같이 다음 틱에 전달합니다. */
+	TArray<TPair<uint32, FSMTraceResult>> DeferredResults;
+
+	uint32 NumAsyncTracesThisFrame = 0;
+
+	FSMTraceStats Stats;
+
+	void TickBenchmark();
+
+	void FinishBenchmark();
+
+	void HandleBenchmarkResult(const FSMTraceResult& InResult);
+
+	struct FBenchmark
+	{
+		TArray<TWeakObjectPtr<ASMPlayerCharacter>> Characters;
+
+		int32 NumFrames = 0;
+
+		int32 Frame = 0;
+
+		/** 단계별(0: 동기, 1: 비동기) 게임 스레드 트레이스 시간과 프레임 시간, 적중 수입니다. */
+		double TraceTimeMs[2] = {};
+
+		double GameThreadTimeMs[2] = {};
+
+		uint32 NumHits[2] = {};
+
+		double DeliveryTimeMarkMs = 0.0;
+	};
+
+	TUniquePtr<FBenchmark> Benchmark;
+};
@@ -0,0 +1,204 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystem/SMTravelSubsystem.h"
+
+#include "Data/AssetPath.h"
+#include "Engine/World.h"
+#include "GameFramework/GameModeBase.h"
+#include "GameFramework/PlayerController.h"
+#include "Kismet/GameplayStatics.h"
+
+void USMTravelSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	bExitOnMatch = FParse::Param(FCommandLine::Get(), TEXT("SMTravelExitOnMatch"));
+	bPreloadEnabled = !FParse::Param(FCommandLine::Get(), TEXT("SMTravelNoPreload"));
+	FParse::Value(FCommandLine::Get(), TEXT("SMTravelTo="), PendingAutoTravel);
+
+	PreLoadMapHandle = FCoreUObjectDelegates::PreLoadMap.AddUObject(this, &USMTravelSubsystem::HandlePreLoadMap);
+	PostLoadMapHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(this, &USMTravelSubsystem::HandlePostLoadMapWithWorld);
+}
+
+void USMTravelSubsystem::Deinitialize()
+{
+	FCoreUObjectDelegates::PreLoadMap.Remove(PreLoadMapHandle);
+	FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapHandle);
+
+	ReleasePreloadedPackages();
+
+	Super::Deinitialize();
+}
+
+void USMTravelSubsystem::TravelToMatch(const FString& InAddress)
+{
+	UWorld* World = GetGameInstance()->GetWorld();
+	if (!World)
+	{
+		return;
+	}
+
+	TravelStartTime = FPlatformTime::Seconds();
+
+	if (InAddress.IsEmpty() || InAddress == TEXT("listen"))
+	{
+		UE_LOG(LogSMTravel, Log, TEXT("리슨 서버로 매치를 엽니다. (미리 로드 %s)"), PreloadedPackages.Num() > 0 ? TEXT("완료") : TEXT("미완료"));
+
+		// 메뉴 월드를 정리하는 동안 전환 맵(GameMapsSettings의 TransitionMap)에 머물도록 심리스 트래블로 이동합니다.
+		// 메뉴의 게임 모드는 블루프린트이므로 이동 직전에 심리스 트래블을 켭니다. PIE에서는 엔진이 일반 이동으로 대신합니다.
+		AGameModeBase* GameMode = World->GetAuthGameMode();
+		if (GameMode)
+		{
+			GameMode->bUseSeamlessTravel = true;
+			MapLoadStartTime = TravelStartTime;
+			bPendingListen = true;
+			World->ServerTravel(FString(MATCH_MAP_PATH) + TEXT("?listen"), true);
+			return;
+		}
+
+		UGameplayStatics::OpenLevel(World, MATCH_MAP_PATH, true, TEXT("listen"));
+		return;
+	}
+
+	APlayerController* PlayerController = GetGameInstance()->GetFirstLocalPlayerController(World);
+	if (PlayerController)
+	{
+		UE_LOG(LogSMTravel, Log, TEXT("%s 서버에 접속합니다. (미리 로드 %s)"), *InAddress, PreloadedPackages.Num() > 0 ? TEXT("완료") : TEXT("미완료"));
+		PlayerController->ClientTravel(InAddress, TRAVEL_Absolute);
+	}
+}
+
+void USMTravelSubsystem::ReportInMatch()
+{
+	if (TravelStartTime <= 0.0)
+	{
+		return;
+	}
+
+	const UWorld* World = GetGameInstance()->GetWorld();
+	const TCHAR* NetModeName = World && World->GetNetMode() == NM_ListenServer ? TEXT("listen") : TEXT("client");
+	const double TravelTime = (FPlatformTime::Seconds() - TravelStartTime) * 1000.0;
+	UE_LOG(LogSMTravel, Log, TEXT("[SM.Travel] mode=%s travelMs=%.1f mapLoadMs=%.1f"), NetModeName, TravelTime, MapLoadTime * 1000.0);
+
+	TravelStartTime = 0.0;
+
+	if (bExitOnMatch)
+	{
+		FPlatformMisc::RequestExit(false);
+	}
+}
+
+void USMTravelSubsystem::HandlePreLoadMap(const FString& InMapName)
+{
+	MapLoadStartTime = FPlatformTime::Seconds();
+}
+
+void USMTravelSubsystem::HandlePostLoadMapWithWorld(UWorld* InLoadedWorld)
+{
+	MapLoadTime = MapLoadStartTime > 0.0 ? FPlatformTime::Seconds() - MapLoadStartTime : 0.0;
+
+	const FString PackageName = InLoadedWorld ? InLoadedWorld->GetOutermost()->GetName() : FString();
+	if (PackageName == MATCH_MAP_PATH)
+	{
+		// 독립 실행 중인 메뉴에서 심리스 트래블로 넘어오면 넷 드라이버가 없으므로 리슨을 직접 시작합니다.
+		if (bPendingListen && InLoadedWorld->GetNetMode() == NM_Standalone)
+		{
+			FURL ListenURL = InLoadedWorld->URL;
+			if (!InLoadedWorld->Listen(ListenURL))
+			{
+				UE_LOG(LogSMTravel, Error, TEXT("매치 맵에서 리슨 서버를 시작하지 못했습니다."));
+			}
+		}
+
+		bPendingListen = false;
+		ReleasePreloadedPackages();
+		return;
+	}
+
+	if (PackageName != MAIN_MENU_MAP_PATH)
+	{
+		return;
+	}
+
+	PreloadMatchPackages();
+
+	if (!PendingAutoTravel.IsEmpty())
+	{
+		// 미리 로드가 끝난 뒤에 이동해야 메뉴가 표시되는 동안의 실제 흐름과 같은 조건으로 측정됩니다.
+		if (!bIsPreloading)
+		{
+			TravelToMatch(PendingAutoTravel);
+			PendingAutoTravel.Reset();
+		}
+	}
+}
+
+void USMTravelSubsystem::PreloadMatchPackages()
+{
+	if (!bPreloadEnabled || IsRunningDedicatedServer() || bIsPreloading || PreloadedPackages.Num() > 0)
+	{
+		return;
+	}
+
+	// 캐릭터 에셋 데이터는 USMAssetSubsystem이 게임 시작 시 로드해 유지하므로 여기서는 맵과 블루프린트만 로드합니다.
+	const TCHAR* PackagePaths[] = { MATCH_MAP_PATH, PLAYER_CHARACTER_BLUEPRINT_PATH };
+
+	bIsPreloading = true;
+	PreloadStartTime = FPlatformTime::Seconds();
+	NumPendingPreloads = UE_ARRAY_COUNT(PackagePaths);
+	for (const TCHAR* PackagePath : PackagePaths)
+	{
+		LoadPackageAsync(PackagePath, FLoadPackageAsyncDelegate::CreateUObject(this, &USMTravelSubsystem::HandlePackagePreloaded));
+	}
+}
+
+void USMTravelSubsystem::HandlePackagePreloaded(const FName& InPackageName, UPackage* InLoadedPackage, EAsyncLoadingResult::Type InResult)
+{
+	if (!bIsPreloading)
+	{
+		return;
+	}
+
+	if (InResult == EAsyncLoadingResult::Succeeded && InLoadedPackage)
+	{
+		PreloadedPackages.Add(InLoadedPackage);
+	}
+	else
+	{
+		UE_LOG(LogSMTravel, Warning, TEXT("%s 패키지를 미리 로드하지 못했습니다."), *InPackageName.ToString());
+	}
+
+	if (--NumPendingPreloads > 0)
+	{
+		return;
+	}
+
+	bIsPreloading = false;
+	UE_LOG(LogSMTravel, Log, TEXT("매치 패키지 %d개 미리 로드 완료: %.1fms"), PreloadedPackages.Num(), (FPlatformTime::Seconds() - PreloadStartTime) * 1000.0);
+
+	if (!PendingAutoTravel.IsEmpty())
+	{
+		TravelToMatch(PendingAutoTravel);
+		PendingAutoTravel.Reset();
+	}
+}
+
+void USMTravelSubsystem::ReleasePreloadedPackages()
+{
+	bIsPreloading = false;
+	NumPendingPreloads = 0;
+	PreloadedPackages.Reset();
+}
+
+static FAutoConsoleCommandWithWorldAndArgs SMTravelMatchCommand(
+	TEXT("SM.Travel.Match"),
+	TEXT("매치로 이동합니다. 인자가 없으면 리슨 서버로 매치를 열고, 주소를 주면 해당 서버에 접속합니다."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		USMTravelSubsystem* TravelSubsystem = World && World->GetGameInstance() ? World->GetGameInstance()->GetSubsystem<USMTravelSubsystem>() : nullptr;
+		if (TravelSubsystem)
+		{
+			TravelSubsystem->TravelToMatch(Args.Num() > 0 ? Args[0] : FString());
+		}
+	}));
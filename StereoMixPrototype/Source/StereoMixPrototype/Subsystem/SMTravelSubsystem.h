@@ -0,0 +1,79 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "SMTravelSubsystem.generated.h"
+
+DECLARE_LOG_CATEGORY_CLASS(LogSMTravel, Log, All);
+
+/**
+ * 메인 메뉴와 매치 사이의 이동을 담당합니다.
+ * 메인 메뉴가 표시되는 동안 매치 맵과 캐릭터 블루프린트 패키지를 비동기로 미리 로드해 이동 시 맵 로드가 디스크를 기다리지 않게 하고,
+ * 메뉴에서 매치에 들어가 캐릭터를 조종할 수 있게 되기까지의 시간을 기록합니다.
+ * 리슨 서버로 매치를 열 때는 전환 맵을 거치는 심리스 트래블(ServerTravel)을 사용합니다.
+ *
+ * -SMTravelTo=listen|주소  메인 메뉴가 로드되면 리슨 서버로 매치를 열거나 주소의 서버에 접속합니다.
+ * -SMTravelExitOnMatch     이동 시간을 기록한 뒤 종료합니다. Scripts/LoadTest/measure_travel.sh에서 사용합니다.
+ * -SMTravelNoPreload       미리 로드를 끕니다. 미리 로드의 효과를 비교할 때 사용합니다.
+ */
+UCLASS()
+class STEREOMIXPROTOTYPE_API USMTravelSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+public:
+	/** 매치로 이동합니다. 주소가 비어있으면 리슨 서버로 매치 맵을 엽니다. */
+	void TravelToMatch(const FString& InAddress);
+
+	/** 로컬 캐릭터를 조종할 수 있게 되면 호출됩니다. 진행 중인 이동이 있다면 걸린 시간을 기록합니다. */
+	void ReportInMatch();
+
+protected:
+	void HandlePreLoadMap(const FString& InMapName);
+
+	void HandlePostLoadMapWithWorld(UWorld* InLoadedWorld);
+
+	void PreloadMatchPackages();
+
+	void HandlePackagePreloaded(const FName& InPackageName, UPackage* InLoadedPackage, EAsyncLoadingResult::Type InResult);
+
+	/** 매치 맵이 로드된 뒤에는 월드가 패키지를 참조하므로 미리 로드한 참조를 해제합니다. 이전 월드가 GC되지 않는 것을 막기 위함입니다. */
+	void ReleasePreloadedPackages();
+
+	/** 미리 로드한 패키지입니다. 이동 전에 GC되지 않도록 참조를 유지합니다. */
+	UPROPERTY()
+	TArray<TObjectPtr<UPackage>> PreloadedPackages;
+
+	FDelegateHandle PreLoadMapHandle;
+
+	FDelegateHandle PostLoadMapHandle;
+
+	/** 커맨드라인으로 지정된 자동 이동 대상입니다. 한 번만 사용됩니다. */
+	FString PendingAutoTravel;
+
+	double PreloadStartTime = 0.0;
+
+	int32 NumPendingPreloads = 0;
+
+	/** 이동을 시작한 시점입니다. 0이면 측정 중인 이동이 없습니다. */
+	double TravelStartTime = 0.0;
+
+	double MapLoadStartTime = 0.0;
+
+	double MapLoadTime = 0.0;
+
+	uint32 bIsPreloading = false;
+
+	/** 심리스 트래블로 리슨 서버 매치를 여는 중입니다. 매치 맵이 로드되면 리슨을 시작합니다. */
+	uint32 bPendingListen = false;
+
+	uint32 bExitOnMatch = false;
+
+	uint32 bPreloadEnabled = true;
+};
@@ -0,0 +1,104 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "CoreMinimal.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Log/SMPerfMetric.h"
+#include "Misc/AutomationTest.h"
+#include "Tests/AutomationCommon.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+namespace SMBenchTest
+{
+	const TCHAR* MapName = TEXT("/Game/StereoMixPrototype/Level/L_Main");
+
+	/** 성능 게이트가 기준값과 비교하는 벤치마크 명령입니다. 이름, 명령 순서이며 Scripts/PerfGate/baselines.json의 항목을 모두 출력해야 합니다. */
+	const TCHAR* Commands[][2] =
+	{
+		{ TEXT("Catch"), TEXT("SM.Bench.Catch 100") },
+		{ TEXT("SpatialGrid"), TEXT("SM.Bench.SpatialGrid 100") },
+		{ TEXT("PullConvergence"), TEXT("SM.Bench.PullConvergence") },
+		{ TEXT("Pull"), TEXT("SM.Bench.Pull 500 60") },
+		{ TEXT("Respawn"), TEXT("SM.Bench.Respawn 32 5") },
+		{ TEXT("FloorHeight"), TEXT("SM.Bench.FloorHeight 10000") },
+	};
+
+	/** 명령을 실행하는 동안 LogSMPerf로 출력되는 [SM.Perf] 이름=값을 모읍니다. */
+	class FPerfMetricCapture : public FOutputDevice
+	{
+	public:
+		virtual void Serialize(const TCHAR* V, ELogVerbosity::Type Verbosity, const FName& Category) override
+		{
+			if (Category != LogSMPerf.GetCategoryName())
+			{
+				return;
+			}
+
+			FString Name;
+			FString Value;
+			if (FString(V).RightChop(FCString::Strlen(TEXT("[SM.Perf] "))).Split(TEXT("="), &Name, &Value))
+			{
+				Metrics.Add(Name, FCString::Atod(*Value));
+			}
+		}
+
+		TMap<FString, double> Metrics;
+	};
+}
+
+/** 게임 월드에서 벤치마크 명령을 실행하고 측정값이 출력되었는지 확인합니다. */
+DEFINE_LATENT_AUTOMATION_COMMAND_TWO_PARAMETER(FSMRunBenchCommand, FAutomationTestBase*, Test, FString, Command);
+
+bool FSMRunBenchCommand::Update()
+{
+	UWorld* World = AutomationCommon::GetAnyGameWorld();
+	if (!World)
+	{
+		Test->AddError(FString::Printf(TEXT("%s: 게임 월드가 없습니다."), *Command));
+		return true;
+	}
+
+	SMBenchTest::FPerfMetricCapture Capture;
+	GLog->AddOutputDevice(&Capture);
+	const bool bHandled = GEngine->Exec(World, *Command);
+	GLog->Flush();
+	GLog->RemoveOutputDevice(&Capture);
+
+	Test->TestTrue(FString::Printf(TEXT("%s 명령 실행"), *Command), bHandled);
+	Test->TestTrue(FString::Printf(TEXT("%s 측정값 출력"), *Command), Capture.Metrics.Num() > 0);
+	for (const TPair<FString, double>& Metric : Capture.Metrics)
+	{
+		Test->TestTrue(FString::Printf(TEXT("%s 측정값이 유한함"), *Metric.Key), FMath::IsFinite(Metric.Value) && Metric.Value >= 0.0);
+	}
+
+	return true;
+}
+
+/**
+ * SM.Bench.* 명령을 하나씩 실행하는 성능 테스트입니다. 기준값과의 비교는 Scripts/PerfGate/run_perf_gate.sh가 로그의 [SM.Perf] 값으로 합니다.
+ * 사용법: -ExecCmds="Automation RunTests StereoMix.Perf.Bench"
+ */
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FSMBenchTest, "StereoMix.Perf.Bench", EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter)
+
+void FSMBenchTest::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+	for (const auto& Command : SMBenchTest::Commands)
+	{
+		OutBeautifiedNames.Add(Command[0]);
+		OutTestCommands.Add(Command[1]);
+	}
+}
+
+bool FSMBenchTest::RunTest(const FString& Parameters)
+{
+	if (!AutomationOpenMap(SMBenchTest::MapName))
+	{
+		AddError(FString::Printf(TEXT("%s 맵을 열 수 없습니다."), SMBenchTest::MapName));
+		return false;
+	}
+
+	ADD_LATENT_AUTOMATION_COMMAND(FSMRunBenchCommand(this, Parameters));
+	return true;
+}
+#endif